@@ -0,0 +1,484 @@
+#include "Benchmark.h"
+#include "../AppProperties.h"
+#include "../GUI/SquidSalmple/CueSets/WaveformDisplay.h"
+#include "../SquidSalmple/ChannelRecord.h"
+#include "../SquidSalmple/SquidBankProperties.h"
+#include "../SquidSalmple/SquidChannelProperties.h"
+#include "../SquidSalmple/Audio/SquidVoice.h"
+#include "../SquidSalmple/Bank/BankManagerProperties.h"
+#include "../SquidSalmple/Bank/CardIndexer.h"
+#include "../SquidSalmple/EditManager/EditManager.h"
+#include "../SquidSalmple/Metadata/BusyChunkReader.h"
+#include "../SquidSalmple/Metadata/SquidMetaDataReader.h"
+#include "../SquidSalmple/Metadata/SquidSalmpleDefs.h"
+#include "../Utility/Crc.h"
+#include "../Utility/PersistentRootProperties.h"
+#include "../Utility/RootProperties.h"
+#include "../Utility/RuntimeRootProperties.h"
+
+juce::StringArray Benchmark::getBenchmarkNames ()
+{
+    return { "cardScan.singleThread", "cardScan.parallel", "bankList", "bankLoad", "waveformRender", "importConversion", "bankSave",
+             "voiceRender.oneShot", "voiceRender.allStages", "voiceRender.eightVoices", "crc16", "crc32", "channelTreeCreate", "bankTreeCreate",
+             "channelTreeCreate.uncached", "bankTreeCreate.uncached", "channelLoad.record", "channelLoad.copyFrom" };
+}
+
+juce::Result Benchmark::run (const Options& options, juce::var& results)
+{
+    jassert (juce::MessageManager::existsAndIsCurrentThread ());
+    jassert (options.iterations > 0);
+    benchmarkResults.clear ();
+    benchmarksToSkip = options.benchmarksToSkip;
+
+    const auto workFolder { juce::File::getSpecialLocation (juce::File::tempDirectory).getNonexistentChildFile ("SquidManagerBenchmark", {}, false) };
+    const auto cardFolder { workFolder.getChildFile ("Card") };
+    const auto importFolder { workFolder.getChildFile ("Import") };
+    const auto generateStartTime { juce::Time::getMillisecondCounterHiRes () };
+    SyntheticCardGenerator syntheticCardGenerator;
+    if (const auto result { syntheticCardGenerator.generate (cardFolder, importFolder, options.generatorOptions) }; result.failed ())
+    {
+        workFolder.deleteRecursively ();
+        return result;
+    }
+    const auto generateSeconds { (juce::Time::getMillisecondCounterHiRes () - generateStartTime) / 1000.0 };
+
+    // the card is modified by the save benchmark, so it runs last
+    benchmarkCardScan (cardFolder, options);
+    benchmarkBankList (cardFolder, options);
+    benchmarkImportConversion (importFolder, workFolder.getChildFile ("Converted"), options);
+    benchmarkVoiceRender (options);
+    benchmarkCrc (options);
+    benchmarkTreeCreation (options);
+    benchmarkChannelLoad (cardFolder, options);
+    benchmarkBanks (cardFolder, options);
+
+    results = makeResults (options, generateSeconds);
+    if (! options.keepFiles)
+        workFolder.deleteRecursively ();
+    return juce::Result::ok ();
+}
+
+Metrics::Histogram* Benchmark::startBenchmark (juce::String name, int64_t bytesPerOperation, double audioSecondsPerOperation, double cpuLoadBudgetPercent)
+{
+    jassert (getBenchmarkNames ().contains (name));
+    if (benchmarksToSkip.contains (name))
+        return nullptr;
+    benchmarkResults.push_back ({ name, "us", std::make_unique<Metrics::Histogram> ("us"), bytesPerOperation, audioSecondsPerOperation, cpuLoadBudgetPercent });
+    return benchmarkResults.back ().histogram.get ();
+}
+
+void Benchmark::benchmarkCardScan (juce::File cardFolder, const Options& options)
+{
+    auto timeScans = [this, cardFolder, &options] (juce::String name, int numThreads)
+    {
+        auto* histogram { startBenchmark (name) };
+        if (histogram == nullptr)
+            return;
+        for (auto iteration { 0 }; iteration < options.iterations; ++iteration)
+        {
+            CardIndexer cardIndexer;
+            Metrics::ScopedLatency scanLatency (*histogram);
+            cardIndexer.index (cardFolder, numThreads);
+        }
+    };
+    timeScans ("cardScan.singleThread", 1);
+    timeScans ("cardScan.parallel", options.numThreads);
+}
+
+// BankListComponent fills its list from the folders found by the directory scan, which is covered by cardScan, so this times what it
+// does with each of them, finding the bank folders and reading the bank names
+void Benchmark::benchmarkBankList (juce::File cardFolder, const Options& options)
+{
+    auto* histogram { startBenchmark ("bankList") };
+    if (histogram == nullptr)
+        return;
+    for (auto iteration { 0 }; iteration < options.iterations; ++iteration)
+    {
+        Metrics::ScopedLatency bankListLatency (*histogram);
+        juce::StringArray bankNames;
+        for (const auto& [bankNumber, bankDirectory] : CardIndexer::getBankDirectories (cardFolder))
+        {
+            auto bankName { juce::String () };
+            if (auto infoTxtFile { bankDirectory.getChildFile ("info.txt") }; infoTxtFile.exists ())
+                if (auto infoTxtInputStream { infoTxtFile.createInputStream () }; infoTxtInputStream != nullptr)
+                    bankName = infoTxtInputStream->readNextLine ().substring (0, 11);
+            bankNames.add (bankName);
+        }
+    }
+}
+
+void Benchmark::benchmarkBanks (juce::File cardFolder, const Options& options)
+{
+    auto* bankLoadHistogram { startBenchmark ("bankLoad") };
+    auto* waveformRenderHistogram { startBenchmark ("waveformRender") };
+    auto* bankSaveHistogram { startBenchmark ("bankSave") };
+    if (bankLoadHistogram == nullptr && waveformRenderHistogram == nullptr && bankSaveHistogram == nullptr)
+        return;
+
+    // the same property roots the app sets up, without the properties file
+    RootProperties rootProperties;
+    PersistentRootProperties persistentRootProperties (rootProperties.getValueTree (), PersistentRootProperties::WrapperType::owner, PersistentRootProperties::EnableCallbacks::no);
+    AppProperties appProperties;
+    appProperties.wrap (persistentRootProperties.getValueTree (), AppProperties::WrapperType::owner, AppProperties::EnableCallbacks::no);
+    RuntimeRootProperties runtimeRootProperties (rootProperties.getValueTree (), RuntimeRootProperties::WrapperType::owner, RuntimeRootProperties::EnableCallbacks::no);
+    SquidBankProperties squidBankProperties ({}, SquidBankProperties::WrapperType::owner, SquidBankProperties::EnableCallbacks::no);
+    BankManagerProperties bankManagerProperties (runtimeRootProperties.getValueTree (), BankManagerProperties::WrapperType::owner, BankManagerProperties::EnableCallbacks::no);
+    bankManagerProperties.addBank ("edit", squidBankProperties.getValueTree ());
+    bankManagerProperties.addBank ("unedited", squidBankProperties.getValueTree ().createCopy ());
+    runtimeRootProperties.getValueTree ().addChild (bankManagerProperties.getValueTree (), -1, nullptr);
+    EditManager editManager;
+    editManager.init (rootProperties.getValueTree ());
+    // the card is thrown away afterwards, so the replaced files are not put in the trash
+    editManager.setTrashReplacedFiles (false);
+
+    // about the size of the waveform in the channel editor
+    WaveformDisplay waveformDisplay;
+    waveformDisplay.setSize (1000, 120);
+    juce::Image waveformImage (juce::Image::ARGB, waveformDisplay.getWidth (), waveformDisplay.getHeight (), true);
+
+    const auto bankDirectories { CardIndexer::getBankDirectories (cardFolder) };
+    for (auto iteration { 0 }; iteration < options.iterations; ++iteration)
+    {
+        for (const auto& [bankNumber, bankDirectory] : bankDirectories)
+        {
+            {
+                std::optional<Metrics::ScopedLatency> bankLoadLatency;
+                if (bankLoadHistogram != nullptr)
+                    bankLoadLatency.emplace (*bankLoadHistogram);
+                editManager.loadBank (bankDirectory);
+            }
+            if (waveformRenderHistogram == nullptr)
+                continue;
+            for (auto channelIndex { 0 }; channelIndex < CardIndexer::kNumChannels; ++channelIndex)
+            {
+                SquidChannelProperties squidChannelProperties (editManager.getChannelPropertiesVT (channelIndex), SquidChannelProperties::WrapperType::client, SquidChannelProperties::EnableCallbacks::no);
+                auto audioBufferRefCounted { squidChannelProperties.getSampleDataAudioBuffer () };
+                if (audioBufferRefCounted == nullptr || audioBufferRefCounted->getAudioBuffer ()->getNumSamples () == 0)
+                    continue;
+                Metrics::ScopedLatency waveformRenderLatency (*waveformRenderHistogram);
+                waveformDisplay.setAudioBuffer (audioBufferRefCounted->getAudioBuffer ());
+                waveformDisplay.setCuePoints (SquidChannelProperties::byteOffsetToSampleOffset (squidChannelProperties.getStartCue ()),
+                                              SquidChannelProperties::byteOffsetToSampleOffset (squidChannelProperties.getLoopCue ()),
+                                              SquidChannelProperties::byteOffsetToSampleOffset (squidChannelProperties.getEndCue ()));
+                juce::Graphics g (waveformImage);
+                waveformDisplay.paintEntireComponent (g, false);
+            }
+            waveformDisplay.setAudioBuffer (nullptr);
+        }
+    }
+
+    // saving rewrites every sample with the current metadata version, so it is done after all of the loads
+    if (bankSaveHistogram == nullptr)
+        return;
+    for (auto iteration { 0 }; iteration < options.iterations; ++iteration)
+    {
+        for (const auto& [bankNumber, bankDirectory] : bankDirectories)
+        {
+            editManager.loadBank (bankDirectory);
+            Metrics::ScopedLatency bankSaveLatency (*bankSaveHistogram);
+            editManager.saveBank ();
+        }
+    }
+}
+
+void Benchmark::benchmarkImportConversion (juce::File importFolder, juce::File workFolder, const Options& options)
+{
+    auto* histogram { startBenchmark ("importConversion") };
+    if (histogram == nullptr || workFolder.createDirectory ().failed ())
+        return;
+
+    // copySampleToChannel does not need the EditManager to be initialised
+    EditManager editManager;
+    const auto importFiles { importFolder.findChildFiles (juce::File::findFiles, false, "*.wav") };
+    for (auto iteration { 0 }; iteration < options.iterations; ++iteration)
+    {
+        for (const auto& importFile : importFiles)
+        {
+            const auto convertedFile { workFolder.getChildFile (importFile.withFileExtension ("_wav").getFileName ()) };
+            {
+                Metrics::ScopedLatency importConversionLatency (*histogram);
+                editManager.copySampleToChannel (importFile, convertedFile);
+            }
+            convertedFile.deleteFile ();
+        }
+    }
+}
+
+// renders the voice in device sized blocks, as the audio callback does, into a buffer that is thrown away
+void Benchmark::benchmarkVoiceRender (const Options& options)
+{
+    constexpr auto kSourceSampleRate { 44100.0 };
+    constexpr auto kOutputSampleRate { 48000.0 };
+    constexpr auto kBlockSize { 512 };
+    constexpr auto kNumVoices { 8 };
+    constexpr auto kNumBlocks { (static_cast<int> (kOutputSampleRate) + kBlockSize - 1) / kBlockSize }; // a second of output
+    constexpr auto kAudioSeconds { kNumBlocks * kBlockSize / kOutputSampleRate };
+    const auto sourceNumSamples { static_cast<int> (kSourceSampleRate * 4) };
+    juce::AudioBuffer<float> sourceBuffer (1, sourceNumSamples);
+    auto* sourceData { sourceBuffer.getWritePointer (0) };
+    for (auto sampleIndex { 0 }; sampleIndex < sourceNumSamples; ++sampleIndex)
+        sourceData [sampleIndex] = 0.8f * static_cast<float> (std::sin (juce::MathConstants<double>::twoPi * 220.0 * sampleIndex / kSourceSampleRate));
+    std::array<float, kBlockSize> outputData;
+
+    auto timeVoice = [this, &options, &sourceBuffer, &outputData] (juce::String name, const SquidVoice::Parameters& parameters)
+    {
+        auto* histogram { startBenchmark (name, 0, kAudioSeconds) };
+        if (histogram == nullptr)
+            return;
+        SquidVoice squidVoice;
+        squidVoice.prepare (kOutputSampleRate, kBlockSize);
+        squidVoice.setParameters (parameters);
+        for (auto iteration { 0 }; iteration < options.iterations; ++iteration)
+        {
+            squidVoice.trigger (kSourceSampleRate);
+            Metrics::ScopedLatency voiceRenderLatency (*histogram);
+            for (auto blockIndex { 0 }; blockIndex < kNumBlocks; ++blockIndex)
+            {
+                outputData.fill (0.0f);
+                squidVoice.render (sourceBuffer.getReadPointer (0), sourceBuffer.getNumSamples (), outputData.data (), kBlockSize);
+            }
+        }
+    };
+
+    SquidVoice::Parameters oneShotParameters;
+    oneShotParameters.endCue = sourceNumSamples;
+    timeVoice ("voiceRender.oneShot", oneShotParameters);
+
+    auto allStagesParameters { oneShotParameters };
+    allStagesParameters.loopCue = sourceNumSamples / 2;
+    allStagesParameters.endCue = sourceNumSamples / 2 + static_cast<int> (kSourceSampleRate / 4);
+    allStagesParameters.loopMode = static_cast<int> (LoopType::zigZag);
+    allStagesParameters.bits = 8;
+    allStagesParameters.rate = 11025.0;
+    allStagesParameters.speed = 2.0;
+    allStagesParameters.pitchShift = 1.5f;
+    allStagesParameters.filterType = static_cast<int> (FilterType::lp);
+    allStagesParameters.filterFrequency = 2000.0f;
+    allStagesParameters.filterQ = 2.0f;
+    allStagesParameters.attackSeconds = 0.01f;
+    allStagesParameters.decaySeconds = 2.0f;
+    timeVoice ("voiceRender.allStages", allStagesParameters);
+
+    // the worst case for the bank preview, every channel playing with all of the stages in use, mixed to the stereo output as AudioPlayer::renderBank does
+    if (auto* histogram { startBenchmark ("voiceRender.eightVoices", 0, kAudioSeconds, kVoiceCpuLoadBudgetPercent) }; histogram != nullptr)
+    {
+        std::array<SquidVoice, kNumVoices> squidVoices;
+        for (auto& squidVoice : squidVoices)
+        {
+            squidVoice.prepare (kOutputSampleRate, kBlockSize);
+            squidVoice.setParameters (allStagesParameters);
+        }
+        std::array<float, kBlockSize> leftData;
+        std::array<float, kBlockSize> rightData;
+        for (auto iteration { 0 }; iteration < options.iterations; ++iteration)
+        {
+            for (auto& squidVoice : squidVoices)
+                squidVoice.trigger (kSourceSampleRate);
+            Metrics::ScopedLatency voiceRenderLatency (*histogram);
+            for (auto blockIndex { 0 }; blockIndex < kNumBlocks; ++blockIndex)
+            {
+                leftData.fill (0.0f);
+                rightData.fill (0.0f);
+                for (auto voiceIndex { 0 }; voiceIndex < kNumVoices; ++voiceIndex)
+                {
+                    outputData.fill (0.0f);
+                    squidVoices [voiceIndex].render (sourceBuffer.getReadPointer (0), sourceBuffer.getNumSamples (), outputData.data (), kBlockSize);
+                    const auto panAngle { (voiceIndex / 2 + 0.5f) / (kNumVoices / 2) * juce::MathConstants<float>::halfPi };
+                    juce::FloatVectorOperations::addWithMultiply (leftData.data (), outputData.data (), std::cos (panAngle), kBlockSize);
+                    juce::FloatVectorOperations::addWithMultiply (rightData.data (), outputData.data (), std::sin (panAngle), kBlockSize);
+                }
+            }
+        }
+    }
+}
+
+void Benchmark::benchmarkCrc (const Options& options)
+{
+    constexpr auto kBufferSize { 64 * 1024 * 1024 };
+    auto* crc16Histogram { startBenchmark ("crc16", kBufferSize) };
+    auto* crc32Histogram { startBenchmark ("crc32", kBufferSize) };
+    if (crc16Histogram == nullptr && crc32Histogram == nullptr)
+        return;
+
+    juce::MemoryBlock data (kBufferSize);
+    juce::Random (options.generatorOptions.seed).fillBitsRandomly (data.getData (), data.getSize ());
+    const auto* bytes { static_cast<const uint8_t*> (data.getData ()) };
+    // each crc is written to a volatile, so the compiler can't drop the work
+    volatile uint32_t lastCrc { 0 };
+    auto timeCrc = [&options, &lastCrc, bytes] (auto crc, Metrics::Histogram* histogram)
+    {
+        if (histogram == nullptr)
+            return;
+        for (auto iteration { 0 }; iteration < options.iterations; ++iteration)
+        {
+            crc.reset ();
+            Metrics::ScopedLatency crcLatency (*histogram);
+            lastCrc = crc.updateBuffer (bytes, kBufferSize);
+        }
+    };
+    timeCrc (Crc16 {}, crc16Histogram);
+    timeCrc (Crc32 {}, crc32Histogram);
+}
+
+juce::var Benchmark::makeResults (const Options& options, double generateSeconds)
+{
+    const auto& generatorOptions { options.generatorOptions };
+    auto* cardObject { new juce::DynamicObject };
+    cardObject->setProperty ("banks", generatorOptions.numBanks);
+    cardObject->setProperty ("emptyChannelPercent", generatorOptions.emptyChannelPercent);
+    cardObject->setProperty ("minSampleSeconds", generatorOptions.minSampleSeconds);
+    cardObject->setProperty ("maxSampleSeconds", generatorOptions.maxSampleSeconds);
+    cardObject->setProperty ("firstVersion", generatorOptions.firstVersion);
+    cardObject->setProperty ("lastVersion", generatorOptions.lastVersion);
+    cardObject->setProperty ("junkFilesPerBank", generatorOptions.junkFilesPerBank);
+    cardObject->setProperty ("importSamples", generatorOptions.numImportSamples);
+    cardObject->setProperty ("importSampleRate", generatorOptions.importSampleRate);
+    cardObject->setProperty ("importBitsPerSample", generatorOptions.importBitsPerSample);
+    cardObject->setProperty ("importChannels", generatorOptions.importNumChannels);
+    cardObject->setProperty ("seed", generatorOptions.seed);
+    cardObject->setProperty ("generateSeconds", generateSeconds);
+
+    auto* systemObject { new juce::DynamicObject };
+    systemObject->setProperty ("os", juce::SystemStats::getOperatingSystemName ());
+    systemObject->setProperty ("cpu", juce::SystemStats::getCpuModel ());
+    systemObject->setProperty ("cpus", juce::SystemStats::getNumCpus ());
+    systemObject->setProperty ("memoryMb", juce::SystemStats::getMemorySizeInMegabytes ());
+
+    auto* benchmarksObject { new juce::DynamicObject };
+    for (const auto& benchmarkResult : benchmarkResults)
+    {
+        const auto snapshot { benchmarkResult.histogram->getSnapshot () };
+        auto* benchmarkObject { new juce::DynamicObject };
+        benchmarkObject->setProperty ("unit", benchmarkResult.unit);
+        benchmarkObject->setProperty ("count", static_cast<juce::int64> (snapshot.count));
+        benchmarkObject->setProperty ("total", static_cast<juce::int64> (snapshot.sum));
+        benchmarkObject->setProperty ("mean", snapshot.getMean ());
+        benchmarkObject->setProperty ("p50", static_cast<juce::int64> (snapshot.getPercentile (50.0)));
+        benchmarkObject->setProperty ("p90", static_cast<juce::int64> (snapshot.getPercentile (90.0)));
+        benchmarkObject->setProperty ("p99", static_cast<juce::int64> (snapshot.getPercentile (99.0)));
+        benchmarkObject->setProperty ("max", static_cast<juce::int64> (snapshot.max));
+        if (benchmarkResult.bytesPerOperation > 0 && snapshot.getMean () > 0.0)
+            benchmarkObject->setProperty ("gbPerSecond", static_cast<double> (benchmarkResult.bytesPerOperation) / (snapshot.getMean () * 1000.0));
+        if (benchmarkResult.audioSecondsPerOperation > 0.0)
+        {
+            // the share of one core spent rendering, over 100% the audio can't keep up
+            const auto cpuLoadPercent { snapshot.getMean () / (benchmarkResult.audioSecondsPerOperation * 1000000.0) * 100.0 };
+            benchmarkObject->setProperty ("cpuLoadPercent", cpuLoadPercent);
+            if (benchmarkResult.cpuLoadBudgetPercent > 0.0)
+            {
+                benchmarkObject->setProperty ("cpuLoadBudgetPercent", benchmarkResult.cpuLoadBudgetPercent);
+                benchmarkObject->setProperty ("withinBudget", cpuLoadPercent <= benchmarkResult.cpuLoadBudgetPercent);
+            }
+        }
+        benchmarksObject->setProperty (benchmarkResult.name, benchmarkObject);
+    }
+
+    auto* resultsObject { new juce::DynamicObject };
+    resultsObject->setProperty ("version", ProjectInfo::versionString);
+    resultsObject->setProperty ("time", juce::Time::getCurrentTime ().toISO8601 (true));
+    resultsObject->setProperty ("iterations", options.iterations);
+    resultsObject->setProperty ("threads", options.numThreads);
+    resultsObject->setProperty ("system", systemObject);
+    resultsObject->setProperty ("card", cardObject);
+    resultsObject->setProperty ("benchmarks", benchmarksObject);
+    return resultsObject;
+}
+
+// the trees created when a bank is loaded or a channel is cleared, copied from the prebuilt default channel tree. it is built on first use, so that
+// happens before the timing starts. the uncached entries build the same trees one property and child at a time, as every new tree used to be
+void Benchmark::benchmarkTreeCreation (const Options& options)
+{
+    constexpr auto kTreesPerIteration { 100 };
+    SquidChannelProperties::create (0);
+    auto buildChannelTree = [] (uint8_t channelIndex)
+    {
+        SquidChannelProperties channelProperties (juce::ValueTree (SquidChannelProperties::SquidChannelTypeId), SquidChannelProperties::WrapperType::owner,
+                                                  SquidChannelProperties::EnableCallbacks::no);
+        channelProperties.buildDefaultValueTree ();
+        channelProperties.setChannelIndex (channelIndex, false);
+        return channelProperties.getValueTree ();
+    };
+
+    if (auto* histogram { startBenchmark ("channelTreeCreate") }; histogram != nullptr)
+    {
+        for (auto iteration { 0 }; iteration < options.iterations * kTreesPerIteration; ++iteration)
+        {
+            Metrics::ScopedLatency channelTreeCreateLatency (*histogram);
+            SquidChannelProperties::create (static_cast<uint8_t> (iteration % 8));
+        }
+    }
+
+    if (auto* histogram { startBenchmark ("bankTreeCreate") }; histogram != nullptr)
+    {
+        for (auto iteration { 0 }; iteration < options.iterations * kTreesPerIteration; ++iteration)
+        {
+            Metrics::ScopedLatency bankTreeCreateLatency (*histogram);
+            SquidBankProperties bankProperties;
+        }
+    }
+
+    if (auto* histogram { startBenchmark ("channelTreeCreate.uncached") }; histogram != nullptr)
+    {
+        for (auto iteration { 0 }; iteration < options.iterations * kTreesPerIteration; ++iteration)
+        {
+            Metrics::ScopedLatency channelTreeCreateLatency (*histogram);
+            buildChannelTree (static_cast<uint8_t> (iteration % 8));
+        }
+    }
+
+    // what SquidBankProperties::initValueTree does, with the channel trees built instead of copied
+    if (auto* histogram { startBenchmark ("bankTreeCreate.uncached") }; histogram != nullptr)
+    {
+        for (auto iteration { 0 }; iteration < options.iterations * kTreesPerIteration; ++iteration)
+        {
+            Metrics::ScopedLatency bankTreeCreateLatency (*histogram);
+            SquidBankProperties bankProperties (juce::ValueTree (SquidBankProperties::SquidBankTypeId), SquidBankProperties::WrapperType::owner, SquidBankProperties::EnableCallbacks::no);
+            bankProperties.setName ("", false);
+            for (uint8_t channelIndex { 0 }; channelIndex < 8; ++channelIndex)
+                bankProperties.getValueTree ().addChild (buildChannelTree (channelIndex), -1, nullptr);
+        }
+    }
+}
+
+// the step of a channel load that writes the decoded settings to the bank's channel tree. the record path is what EditManager::loadChannel does,
+// applying the record to the channel tree. the copyFrom path is what it used to do, setting each field on a temporary tree and copying that into
+// the channel tree. the busy chunks are read and decoded up front, since both paths share that
+void Benchmark::benchmarkChannelLoad (juce::File cardFolder, const Options& options)
+{
+    auto* recordHistogram { startBenchmark ("channelLoad.record") };
+    auto* copyFromHistogram { startBenchmark ("channelLoad.copyFrom") };
+    if (recordHistogram == nullptr && copyFromHistogram == nullptr)
+        return;
+
+    std::vector<ChannelRecord> channelRecords;
+    for (const auto& sampleFile : cardFolder.findChildFiles (juce::File::findFiles, true, "*.wav"))
+    {
+        juce::MemoryBlock busyChunkData;
+        BusyChunkReader busyChunkReader;
+        if (! busyChunkReader.readMetaData (sampleFile, busyChunkData))
+            continue;
+        ChannelRecord channelRecord;
+        if (SquidMetaDataReader::decodeMetaData (busyChunkData, channelRecord))
+            channelRecords.push_back (channelRecord);
+    }
+
+    SquidChannelProperties channelProperties ({}, SquidChannelProperties::WrapperType::owner, SquidChannelProperties::EnableCallbacks::no);
+    for (auto iteration { 0 }; iteration < options.iterations; ++iteration)
+    {
+        for (const auto& channelRecord : channelRecords)
+        {
+            if (recordHistogram != nullptr)
+            {
+                Metrics::ScopedLatency channelLoadLatency (*recordHistogram);
+                channelProperties.applyChannelRecord (channelRecord);
+            }
+            if (copyFromHistogram != nullptr)
+            {
+                Metrics::ScopedLatency channelLoadLatency (*copyFromHistogram);
+                SquidChannelProperties newChannelProperties ({}, SquidChannelProperties::WrapperType::owner, SquidChannelProperties::EnableCallbacks::no);
+                newChannelProperties.applyChannelRecord (channelRecord);
+                channelProperties.copyFrom (newChannelProperties.getValueTree (), SquidChannelProperties::CopyType::all, SquidChannelProperties::CheckIndex::no);
+            }
+        }
+    }
+}
@@ -0,0 +1,71 @@
+#pragma once
+
+#include <JuceHeader.h>
+#include "SyntheticCardGenerator.h"
+#include "../Utility/Metrics.h"
+
+// Benchmark - times the card operations the app spends its time in, on a freshly generated synthetic card, and returns the results as json. each
+// operation is timed on its own, and repeated for every iteration, so the percentiles show the spread, not just the average
+//
+//  cardScan.singleThread    CardIndexer::index, on one thread
+//  cardScan.parallel        CardIndexer::index, on the requested number of threads
+//  bankList                 reading the bank folders and names, as the bank list does
+//  bankLoad                 EditManager::loadBank, per bank
+//  waveformRender           painting the WaveformDisplay of each loaded channel
+//  importConversion         EditManager::copySampleToChannel, per import sample
+//  bankSave                 EditManager::saveBank, per bank (the replaced files are deleted, where the app moves them to the trash)
+//  voiceRender.oneShot      SquidVoice::render, a second of a sample played straight through, at a 48k device rate
+//  voiceRender.allStages    the same, looping, with rate and bit reduction, pitch shift, the filter and the envelope all in use
+//  voiceRender.eightVoices  eight allStages voices mixed per block, as a whole bank plays, checked against a budget of 5% of one core
+//  crc16, crc32             Crc16/Crc32::updateBuffer, over 64MB, also reported as GB/s
+//  channelTreeCreate        SquidChannelProperties::create, 100 per iteration
+//  bankTreeCreate           constructing a SquidBankProperties, with its 8 channel trees, 100 per iteration
+//  *TreeCreate.uncached     the same trees built one property and child at a time, without the prebuilt default channel tree
+//  channelLoad.record       applying a decoded ChannelRecord to a channel tree, per sample on the card, as EditManager::loadChannel does
+//  channelLoad.copyFrom     the same settings set on a temporary channel tree, which is then copied into the channel tree, as loads used to be done
+//
+// the voiceRender entries also report cpuLoadPercent, the render time as a percentage of the audio time
+class Benchmark
+{
+public:
+    struct Options
+    {
+        SyntheticCardGenerator::Options generatorOptions;
+        int iterations { 5 };
+        int numThreads { 1 };
+        juce::StringArray benchmarksToSkip;
+        bool keepFiles { false };
+    };
+
+    // must be called on the message thread, the waveform is rendered with the ui component
+    juce::Result run (const Options& options, juce::var& results);
+
+    static juce::StringArray getBenchmarkNames ();
+
+private:
+    struct BenchmarkResult
+    {
+        juce::String name;
+        juce::String unit;
+        std::unique_ptr<Metrics::Histogram> histogram;
+        int64_t bytesPerOperation { 0 }; // for the throughput benchmarks, 0 for the others
+        double audioSecondsPerOperation { 0.0 }; // for the audio rendering benchmarks, 0 for the others
+        double cpuLoadBudgetPercent { 0.0 }; // 0 if there is no budget
+    };
+    static constexpr double kVoiceCpuLoadBudgetPercent { 5.0 }; // for all eight voices of a bank
+    std::vector<BenchmarkResult> benchmarkResults;
+    juce::StringArray benchmarksToSkip;
+
+    // returns the histogram to record the operation times in, or nullptr if the benchmark is skipped
+    Metrics::Histogram* startBenchmark (juce::String name, int64_t bytesPerOperation = 0, double audioSecondsPerOperation = 0.0, double cpuLoadBudgetPercent = 0.0);
+
+    void benchmarkCardScan (juce::File cardFolder, const Options& options);
+    void benchmarkBankList (juce::File cardFolder, const Options& options);
+    void benchmarkBanks (juce::File cardFolder, const Options& options);
+    void benchmarkImportConversion (juce::File importFolder, juce::File workFolder, const Options& options);
+    void benchmarkVoiceRender (const Options& options);
+    void benchmarkCrc (const Options& options);
+    void benchmarkTreeCreation (const Options& options);
+    void benchmarkChannelLoad (juce::File cardFolder, const Options& options);
+    juce::var makeResults (const Options& options, double generateSeconds);
+};
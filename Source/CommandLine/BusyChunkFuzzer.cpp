@@ -0,0 +1,167 @@
+#include "BusyChunkFuzzer.h"
+#include "SyntheticCardGenerator.h"
+#include "../SquidSalmple/ChannelRecord.h"
+#include "../SquidSalmple/Metadata/BusyChunkLayout.h"
+#include "../SquidSalmple/Metadata/BusyChunkReader.h"
+#include "../SquidSalmple/Metadata/SquidMetaDataReader.h"
+
+juce::Result BusyChunkFuzzer::run (const Options& options, juce::var& results)
+{
+    jassert (options.iterations > 0);
+    random.setSeed (options.seed);
+    if (const auto result { loadSeeds (options) }; result.failed ())
+        return result;
+
+    auto sampleFilesRead { 0 };
+    auto busyChunksDecoded { 0 };
+    auto busyChunksRejected { 0 };
+    juce::int64 bytesParsed { 0 };
+    const auto fuzzStartTime { juce::Time::getMillisecondCounterHiRes () };
+    for (auto iteration { 0 }; iteration < options.iterations; ++iteration)
+    {
+        const auto& seed { seeds [static_cast<size_t> (random.nextInt (static_cast<int> (seeds.size ())))] };
+        juce::MemoryBlock busyChunkData;
+        // every other iteration mutates the whole file, and the rest mutate just the chunk, so the decoder sees damaged chunks as often as the reader sees damaged files
+        if (iteration % 2 == 0)
+        {
+            auto sampleFileData { seed.sampleFileData };
+            mutate (sampleFileData);
+            bytesParsed += static_cast<juce::int64> (sampleFileData.getSize ());
+            BusyChunkReader busyChunkReader;
+            juce::MemoryInputStream markerListStream (sampleFileData, false);
+            busyChunkReader.getMarkerList (markerListStream);
+            juce::MemoryInputStream busyChunkStream (sampleFileData, false);
+            if (! busyChunkReader.readMetaData (busyChunkStream, busyChunkData))
+                continue;
+            ++sampleFilesRead;
+        }
+        else
+        {
+            busyChunkData = seed.busyChunkData;
+            mutate (busyChunkData);
+            bytesParsed += static_cast<juce::int64> (busyChunkData.getSize ());
+        }
+        ChannelRecord channelRecord;
+        if (SquidMetaDataReader::decodeMetaData (busyChunkData, channelRecord))
+            ++busyChunksDecoded;
+        else
+            ++busyChunksRejected;
+    }
+    const auto fuzzSeconds { (juce::Time::getMillisecondCounterHiRes () - fuzzStartTime) / 1000.0 };
+
+    auto* resultsObject { new juce::DynamicObject };
+    resultsObject->setProperty ("iterations", options.iterations);
+    resultsObject->setProperty ("seed", options.seed);
+    resultsObject->setProperty ("seeds", static_cast<int> (seeds.size ()));
+    resultsObject->setProperty ("sampleFilesRead", sampleFilesRead);
+    resultsObject->setProperty ("busyChunksDecoded", busyChunksDecoded);
+    resultsObject->setProperty ("busyChunksRejected", busyChunksRejected);
+    resultsObject->setProperty ("seconds", fuzzSeconds);
+    resultsObject->setProperty ("iterationsPerSecond", fuzzSeconds > 0.0 ? options.iterations / fuzzSeconds : 0.0);
+    resultsObject->setProperty ("megabytesPerSecond", fuzzSeconds > 0.0 ? static_cast<double> (bytesParsed) / (1024.0 * 1024.0) / fuzzSeconds : 0.0);
+    results = resultsObject;
+    return juce::Result::ok ();
+}
+
+juce::Result BusyChunkFuzzer::loadSeeds (const Options& options)
+{
+    seeds.clear ();
+
+    // one bank of short samples, alternating between the 1.86 and 1.90 layouts
+    SyntheticCardGenerator::Options generatorOptions;
+    generatorOptions.numBanks = 1;
+    generatorOptions.emptyChannelPercent = 0;
+    generatorOptions.minSampleSeconds = 0.01;
+    generatorOptions.maxSampleSeconds = 0.05;
+    generatorOptions.firstVersion = BusyChunkLayout::kPitchShiftVersion - 1;
+    generatorOptions.lastVersion = BusyChunkLayout::kPitchShiftVersion;
+    generatorOptions.junkFilesPerBank = 0;
+    generatorOptions.numImportSamples = 0;
+    generatorOptions.seed = options.seed;
+    const auto cardFolder { juce::File::getSpecialLocation (juce::File::tempDirectory).getNonexistentChildFile ("SquidManagerFuzz", {}, false) };
+    SyntheticCardGenerator syntheticCardGenerator;
+    if (const auto result { syntheticCardGenerator.generate (cardFolder, {}, generatorOptions) }; result.failed ())
+    {
+        cardFolder.deleteRecursively ();
+        return result;
+    }
+    for (const auto& sampleFile : cardFolder.findChildFiles (juce::File::findFiles, true, "*.wav"))
+        addSeed (sampleFile);
+    cardFolder.deleteRecursively ();
+
+    if (options.corpusFolder != juce::File ())
+    {
+        if (! options.corpusFolder.isDirectory ())
+            return juce::Result::fail ("'" + options.corpusFolder.getFullPathName () + "' is not a folder");
+        for (const auto& sampleFile : options.corpusFolder.findChildFiles (juce::File::findFiles, true, "*.wav"))
+            addSeed (sampleFile);
+    }
+
+    if (seeds.empty ())
+        return juce::Result::fail ("there are no sample files with a 'busy' chunk to use as seeds");
+    return juce::Result::ok ();
+}
+
+// only files the reader accepts are used, so every seed starts out valid
+void BusyChunkFuzzer::addSeed (juce::File sampleFile)
+{
+    Seed seed;
+    if (! sampleFile.loadFileAsData (seed.sampleFileData))
+        return;
+    BusyChunkReader busyChunkReader;
+    juce::MemoryInputStream sampleFileStream (seed.sampleFileData, false);
+    if (! busyChunkReader.readMetaData (sampleFileStream, seed.busyChunkData))
+        return;
+    ChannelRecord channelRecord;
+    if (! SquidMetaDataReader::decodeMetaData (seed.busyChunkData, channelRecord))
+        return;
+    seeds.push_back (std::move (seed));
+}
+
+// a few random edits, favouring the values that break size and offset checks
+void BusyChunkFuzzer::mutate (juce::MemoryBlock& data)
+{
+    static constexpr uint8_t kInterestingBytes [] { 0x00, 0x01, 0x7F, 0x80, 0xFF };
+    const auto numMutations { 1 + random.nextInt (8) };
+    for (auto mutationIndex { 0 }; mutationIndex < numMutations && data.getSize () > 0; ++mutationIndex)
+    {
+        const auto size { static_cast<int> (data.getSize ()) };
+        auto* bytes { static_cast<uint8_t*> (data.getData ()) };
+        const auto offset { random.nextInt (size) };
+        switch (random.nextInt (5))
+        {
+            case 0:
+            {
+                bytes [offset] ^= static_cast<uint8_t> (1 << random.nextInt (8));
+            }
+            break;
+            case 1:
+            {
+                bytes [offset] = kInterestingBytes [random.nextInt (static_cast<int> (std::size (kInterestingBytes)))];
+            }
+            break;
+            case 2:
+            {
+                // chunk lengths, cue offsets and counts are 32 bit little endian values
+                const uint32_t kInterestingValues [] { 0, 1, 0x7FFFFFFF, 0x80000000, 0xFFFFFFFF, static_cast<uint32_t> (size), static_cast<uint32_t> (size - offset) };
+                const auto value { kInterestingValues [random.nextInt (static_cast<int> (std::size (kInterestingValues)))] };
+                for (auto byteIndex { 0 }; byteIndex < 4 && offset + byteIndex < size; ++byteIndex)
+                    bytes [offset + byteIndex] = static_cast<uint8_t> (value >> (byteIndex * 8));
+            }
+            break;
+            case 3:
+            {
+                data.setSize (static_cast<size_t> (offset));
+            }
+            break;
+            case 4:
+            {
+                // repeat a section of the data, which moves everything after it
+                const auto length { 1 + random.nextInt (std::min (size - offset, 64)) };
+                const juce::MemoryBlock section (bytes + offset, static_cast<size_t> (length));
+                data.insert (section.getData (), section.getSize (), static_cast<size_t> (random.nextInt (size + 1)));
+            }
+            break;
+        }
+    }
+}
@@ -0,0 +1,33 @@
+#pragma once
+
+#include <JuceHeader.h>
+
+// BusyChunkFuzzer - feeds mutated sample files, and mutated 'busy' chunks, through BusyChunkReader and SquidMetaDataReader::decodeMetaData, the
+// code that parses whatever is found on a card. a crash, hang or sanitizer report is a failure, any input either decodes or is rejected. the seed
+// corpus is a synthetic bank with valid firmware 1.86 (version 118) and 1.90 (version 119) chunks, plus the sample files of an optional corpus folder
+// (samples from real cards, for instance). everything is derived from the seed, so a run can be repeated
+class BusyChunkFuzzer
+{
+public:
+    struct Options
+    {
+        int iterations { 100000 };
+        int seed { 1 };
+        juce::File corpusFolder;
+    };
+
+    juce::Result run (const Options& options, juce::var& results);
+
+private:
+    struct Seed
+    {
+        juce::MemoryBlock sampleFileData;
+        juce::MemoryBlock busyChunkData;
+    };
+    std::vector<Seed> seeds;
+    juce::Random random;
+
+    juce::Result loadSeeds (const Options& options);
+    void addSeed (juce::File sampleFile);
+    void mutate (juce::MemoryBlock& data);
+};
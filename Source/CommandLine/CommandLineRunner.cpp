@@ -0,0 +1,566 @@
+#include "CommandLineRunner.h"
+#include "Benchmark.h"
+#include "BusyChunkFuzzer.h"
+#include "../SquidSalmple/SquidBankProperties.h"
+#include "../SquidSalmple/EditManager/EditManager.h"
+#include "../SquidSalmple/Metadata/BusyChunkLayout.h"
+#include "../SquidSalmple/Metadata/BusyChunkReader.h"
+#include "../SquidSalmple/Metadata/SquidMetaDataWriter.h"
+#include "../SquidSalmple/Metadata/SquidSalmpleDefs.h"
+#include <iostream>
+#include <set>
+
+CommandLineRunner::CommandLineRunner ()
+{
+    consoleApplication.addHelpCommand ("--help|-h", "SquidManager - batch Squid Salmple card operations", false);
+    consoleApplication.addCommand ({ "--scan", "--scan <card folder> [--threads=<count>]", "Lists the banks, and the samples in each channel, of a card", "",
+                                     [this] (const juce::ArgumentList& args) { scanCard (args); } });
+    consoleApplication.addCommand ({ "--dump", "--dump <card folder> [--output=<json file>] [--threads=<count>]", "Writes the metadata of every channel of every bank as JSON", "",
+                                     [this] (const juce::ArgumentList& args) { dumpCard (args); } });
+    consoleApplication.addCommand ({ "--validate", "--validate <card folder> [--threads=<count>]", "Checks the sample format and 'busy' metadata chunk of every channel", "",
+                                     [this] (const juce::ArgumentList& args) { validateCard (args); } });
+    consoleApplication.addCommand ({ "--import", "--import <samples folder> <card folder> [--bank=<first bank number>] [--threads=<count>]",
+                                     "Converts folders of samples into banks",
+                                     "Each sub folder of the samples folder (or the samples folder itself, if it has none) becomes a bank, named after the folder, "
+                                     "with its first 8 audio files, in name order, as the channels. The banks are added to the first free bank numbers, starting at --bank",
+                                     [this] (const juce::ArgumentList& args) { importSamples (args); } });
+    consoleApplication.addCommand ({ "--generate", "--generate <output folder> [card options]",
+                                     "Writes a synthetic card, and samples to import, into the Card and Import folders of the output folder",
+                                     "The card options are --banks=<count> --seconds=<min>-<max> --versions=<first>-<last> --empty=<percent of channels> --junk=<files per bank> "
+                                     "--imports=<count> --importFormat=<rate>/<bits>/<channels> --seed=<number>. The same options always generate the same card",
+                                     [this] (const juce::ArgumentList& args) { generateCard (args); } });
+    consoleApplication.addCommand ({ "--benchmark", "--benchmark [--output=<json file>] [--iterations=<count>] [--skip=<name,...>] [--keep] [card options]",
+                                     "Times scanning, loading, saving, importing, waveform and voice rendering on a synthetic card, crc throughput, and channel tree creation and loading, and writes the results as JSON",
+                                     "The card is generated in a temporary folder, which is deleted afterwards unless --keep is given. The benchmarks are "
+                                     + Benchmark::getBenchmarkNames ().joinIntoString (", ") + ". bankSave deletes the replaced files, where the app moves them to the trash",
+                                     [this] (const juce::ArgumentList& args) { runBenchmark (args); } });
+    consoleApplication.addCommand ({ "--fuzz-busy-chunk", "--fuzz-busy-chunk [--iterations=<count>] [--seed=<number>] [--corpus=<folder>]",
+                                     "Feeds mutated sample files and 'busy' chunks through the metadata reader, and writes the throughput as JSON",
+                                     "The seeds are a synthetic bank of 1.86 and 1.90 samples, plus the samples in the corpus folder. Any input should be read or "
+                                     "rejected, a crash or assert is a bug. The same seed always makes the same inputs",
+                                     [this] (const juce::ArgumentList& args) { fuzzBusyChunk (args); } });
+}
+
+bool CommandLineRunner::isCommandLineRequest (const juce::String& commandLine)
+{
+    const juce::ArgumentList args (ProjectInfo::projectName, commandLine);
+    for (const auto& command : consoleApplication.getCommands ())
+        if (args.containsOption (command.commandOption))
+            return true;
+    return false;
+}
+
+int CommandLineRunner::run (const juce::String& commandLine)
+{
+    return consoleApplication.findAndRunCommand (juce::ArgumentList (ProjectInfo::projectName, commandLine), false);
+}
+
+void CommandLineRunner::scanCard (const juce::ArgumentList& args)
+{
+    const auto cardFolder { getFolderArgument (args, 0, "card folder") };
+    const auto scanStartTime { juce::Time::getMillisecondCounterHiRes () };
+    CardIndexer cardIndexer;
+    const auto cardIndex { cardIndexer.index (cardFolder, getNumThreads (args)) };
+    const auto scanTime { juce::Time::getMillisecondCounterHiRes () - scanStartTime };
+
+    auto numSamples { 0 };
+    auto numWithoutMetaData { 0 };
+    for (const auto& bankEntry : cardIndex)
+    {
+        writeOutput ("Bank " + juce::String (bankEntry.bankNumber) + " '" + bankEntry.bankName + "'");
+        for (auto channelIndex { 0 }; channelIndex < CardIndexer::kNumChannels; ++channelIndex)
+        {
+            const auto& channelEntry { bankEntry.channels [static_cast<size_t> (channelIndex)] };
+            auto channelText { "  " + juce::String (channelIndex + 1) + ": " };
+            if (channelEntry.sampleFile == juce::File ())
+            {
+                channelText += "-";
+            }
+            else
+            {
+                ++numSamples;
+                channelText += channelEntry.sampleFile.getFileName ();
+                if (channelEntry.hasMetaData)
+                    channelText += " (metadata version " + juce::String (channelEntry.channelRecord.loadedVersion) + ")";
+                else
+                    ++numWithoutMetaData;
+            }
+            writeOutput (channelText);
+        }
+    }
+    writeOutput (juce::String (cardIndex.size ()) + " banks, " + juce::String (numSamples) + " samples, " + juce::String (numWithoutMetaData) +
+                 " without metadata. scanned in " + juce::String (scanTime, 1) + " ms");
+}
+
+void CommandLineRunner::dumpCard (const juce::ArgumentList& args)
+{
+    const auto cardFolder { getFolderArgument (args, 0, "card folder") };
+    CardIndexer cardIndexer;
+    const auto cardIndex { cardIndexer.index (cardFolder, getNumThreads (args)) };
+
+    juce::Array<juce::var> bankList;
+    for (const auto& bankEntry : cardIndex)
+    {
+        juce::Array<juce::var> channelList;
+        for (auto channelIndex { 0 }; channelIndex < CardIndexer::kNumChannels; ++channelIndex)
+        {
+            const auto& channelEntry { bankEntry.channels [static_cast<size_t> (channelIndex)] };
+            auto* channelObject { new juce::DynamicObject };
+            channelObject->setProperty ("channel", channelIndex + 1);
+            channelObject->setProperty ("sampleFile", channelEntry.sampleFile == juce::File () ? juce::var () : juce::var (channelEntry.sampleFile.getFullPathName ()));
+            channelObject->setProperty ("hasMetaData", channelEntry.hasMetaData);
+            if (channelEntry.hasMetaData)
+                channelObject->setProperty ("metaData", channelRecordToVar (channelEntry.channelRecord));
+            channelList.add (channelObject);
+        }
+        auto* bankObject { new juce::DynamicObject };
+        bankObject->setProperty ("bank", bankEntry.bankNumber);
+        bankObject->setProperty ("name", bankEntry.bankName);
+        bankObject->setProperty ("channels", channelList);
+        bankList.add (bankObject);
+    }
+
+    auto* cardObject { new juce::DynamicObject };
+    cardObject->setProperty ("card", cardFolder.getFullPathName ());
+    cardObject->setProperty ("banks", bankList);
+    const auto cardJson { juce::JSON::toString (juce::var (cardObject)) };
+    if (args.containsOption ("--output"))
+    {
+        const auto outputFile { args.getFileForOption ("--output") };
+        if (! outputFile.replaceWithText (cardJson))
+            juce::ConsoleApplication::fail ("unable to write '" + outputFile.getFullPathName () + "'");
+        return;
+    }
+    writeOutput (cardJson);
+}
+
+void CommandLineRunner::validateCard (const juce::ArgumentList& args)
+{
+    const auto cardFolder { getFolderArgument (args, 0, "card folder") };
+    const auto numThreads { getNumThreads (args) };
+    CardIndexer cardIndexer;
+    const auto cardIndex { cardIndexer.index (cardFolder, numThreads) };
+
+    // the sample file headers are read for the checks, so the banks are checked in parallel too
+    std::vector<std::array<juce::StringArray, CardIndexer::kNumChannels>> bankProblems (cardIndex.size ());
+    forEachBankInParallel (static_cast<int> (cardIndex.size ()), numThreads, [&cardIndex, &bankProblems] (int bankIndex)
+    {
+        for (auto channelIndex { 0 }; channelIndex < CardIndexer::kNumChannels; ++channelIndex)
+            bankProblems [static_cast<size_t> (bankIndex)] [static_cast<size_t> (channelIndex)] = validateChannel (cardIndex [static_cast<size_t> (bankIndex)].channels [static_cast<size_t> (channelIndex)]);
+    });
+
+    auto numProblems { 0 };
+    for (auto bankIndex { 0u }; bankIndex < cardIndex.size (); ++bankIndex)
+    {
+        for (auto channelIndex { 0 }; channelIndex < CardIndexer::kNumChannels; ++channelIndex)
+        {
+            for (const auto& problem : bankProblems [bankIndex] [static_cast<size_t> (channelIndex)])
+            {
+                writeOutput ("Bank " + juce::String (cardIndex [bankIndex].bankNumber) + ", channel " + juce::String (channelIndex + 1) + ": " + problem);
+                ++numProblems;
+            }
+        }
+    }
+    writeOutput (juce::String (cardIndex.size ()) + " banks checked, " + juce::String (numProblems) + " problems found");
+    if (numProblems > 0)
+        juce::ConsoleApplication::fail ({}, 2);
+}
+
+void CommandLineRunner::importSamples (const juce::ArgumentList& args)
+{
+    const auto samplesFolder { getFolderArgument (args, 0, "samples folder") };
+    const auto cardFolder { getFolderArgument (args, 1, "card folder") };
+
+    auto bankSourceFolders { samplesFolder.findChildFiles (juce::File::findDirectories, false) };
+    if (bankSourceFolders.isEmpty ())
+        bankSourceFolders.add (samplesFolder);
+    std::sort (bankSourceFolders.begin (), bankSourceFolders.end (), [] (const juce::File& folderOne, const juce::File& folderTwo)
+    {
+        return folderOne.getFileName ().compareNatural (folderTwo.getFileName ()) < 0;
+    });
+
+    // existing banks are never overwritten, each new bank goes in the next free bank number
+    std::set<int> usedBankNumbers;
+    for (const auto& bankDirectoryEntry : CardIndexer::getBankDirectories (cardFolder))
+        usedBankNumbers.insert (bankDirectoryEntry.first);
+    auto nextBankNumber { args.containsOption ("--bank") ? args.getValueForOption ("--bank").getIntValue () : 1 };
+    if (nextBankNumber < 1 || nextBankNumber > CardIndexer::kMaxBanks)
+        juce::ConsoleApplication::fail ("--bank must be from 1 to " + juce::String (CardIndexer::kMaxBanks));
+    std::vector<juce::File> bankDirectories;
+    for (auto bankSourceIndex { 0 }; bankSourceIndex < bankSourceFolders.size (); ++bankSourceIndex)
+    {
+        while (usedBankNumbers.count (nextBankNumber) != 0)
+            ++nextBankNumber;
+        if (nextBankNumber > CardIndexer::kMaxBanks)
+            juce::ConsoleApplication::fail ("there are not enough free banks for " + juce::String (bankSourceFolders.size ()) + " folders");
+        bankDirectories.push_back (cardFolder.getChildFile ("Bank " + juce::String (nextBankNumber)));
+        usedBankNumbers.insert (nextBankNumber);
+    }
+
+    std::vector<juce::String> importProblems (bankDirectories.size ());
+    forEachBankInParallel (static_cast<int> (bankDirectories.size ()), getNumThreads (args), [&bankSourceFolders, &bankDirectories, &importProblems] (int bankIndex)
+    {
+        importProblems [static_cast<size_t> (bankIndex)] = importBank (bankSourceFolders [bankIndex], bankDirectories [static_cast<size_t> (bankIndex)]);
+    });
+
+    auto numFailed { 0 };
+    for (auto bankIndex { 0u }; bankIndex < bankDirectories.size (); ++bankIndex)
+    {
+        const auto& problems { importProblems [bankIndex] };
+        writeOutput (bankSourceFolders [static_cast<int> (bankIndex)].getFileName () + " -> " + bankDirectories [bankIndex].getFileName () + (problems.isEmpty () ? "" : ": " + problems));
+        if (problems.isNotEmpty ())
+            ++numFailed;
+    }
+    if (numFailed > 0)
+        juce::ConsoleApplication::fail (juce::String (numFailed) + " banks had problems", 2);
+}
+
+void CommandLineRunner::generateCard (const juce::ArgumentList& args)
+{
+    const auto outputFolder { getFolderArgument (args, 0, "output folder") };
+    const auto generateStartTime { juce::Time::getMillisecondCounterHiRes () };
+    SyntheticCardGenerator syntheticCardGenerator;
+    if (const auto result { syntheticCardGenerator.generate (outputFolder.getChildFile ("Card"), outputFolder.getChildFile ("Import"), getGeneratorOptions (args)) }; result.failed ())
+        juce::ConsoleApplication::fail (result.getErrorMessage ());
+    writeOutput ("generated in " + juce::String (juce::Time::getMillisecondCounterHiRes () - generateStartTime, 1) + " ms");
+}
+
+void CommandLineRunner::fuzzBusyChunk (const juce::ArgumentList& args)
+{
+    BusyChunkFuzzer::Options options;
+    if (args.containsOption ("--iterations"))
+        options.iterations = juce::jmax (1, args.getValueForOption ("--iterations").getIntValue ());
+    if (args.containsOption ("--seed"))
+        options.seed = args.getValueForOption ("--seed").getIntValue ();
+    if (args.containsOption ("--corpus"))
+        options.corpusFolder = args.getFileForOption ("--corpus");
+
+    BusyChunkFuzzer busyChunkFuzzer;
+    juce::var results;
+    if (const auto result { busyChunkFuzzer.run (options, results) }; result.failed ())
+        juce::ConsoleApplication::fail (result.getErrorMessage ());
+    writeOutput (juce::JSON::toString (results));
+}
+
+void CommandLineRunner::runBenchmark (const juce::ArgumentList& args)
+{
+    Benchmark::Options options;
+    options.generatorOptions = getGeneratorOptions (args);
+    options.numThreads = getNumThreads (args);
+    options.keepFiles = args.containsOption ("--keep");
+    if (args.containsOption ("--iterations"))
+        options.iterations = juce::jlimit (1, 10000, args.getValueForOption ("--iterations").getIntValue ());
+    if (args.containsOption ("--skip"))
+    {
+        options.benchmarksToSkip.addTokens (args.getValueForOption ("--skip"), ",", {});
+        options.benchmarksToSkip.trim ();
+        for (const auto& benchmarkName : options.benchmarksToSkip)
+            if (! Benchmark::getBenchmarkNames ().contains (benchmarkName))
+                juce::ConsoleApplication::fail ("unknown benchmark '" + benchmarkName + "', the benchmarks are " + Benchmark::getBenchmarkNames ().joinIntoString (", "));
+    }
+
+    Benchmark benchmark;
+    juce::var results;
+    if (const auto result { benchmark.run (options, results) }; result.failed ())
+        juce::ConsoleApplication::fail (result.getErrorMessage ());
+
+    const auto resultsJson { juce::JSON::toString (results) };
+    if (args.containsOption ("--output"))
+    {
+        const auto outputFile { args.getFileForOption ("--output") };
+        if (! outputFile.replaceWithText (resultsJson))
+            juce::ConsoleApplication::fail ("unable to write '" + outputFile.getFullPathName () + "'");
+        // a readable summary, when the json goes to a file
+        for (const auto& benchmarkName : Benchmark::getBenchmarkNames ())
+        {
+            const auto benchmarkResult { results ["benchmarks"] [juce::Identifier (benchmarkName)] };
+            if (benchmarkResult.isVoid ())
+                continue;
+            auto summary { benchmarkName.paddedRight (' ', 28) + "mean " + juce::String (static_cast<double> (benchmarkResult ["mean"]), 1).paddedLeft (' ', 12) +
+                           " us   p90 " + benchmarkResult ["p90"].toString ().paddedLeft (' ', 10) + " us   max " + benchmarkResult ["max"].toString ().paddedLeft (' ', 10) + " us" };
+            if (benchmarkResult.hasProperty ("gbPerSecond"))
+                summary += "   " + juce::String (static_cast<double> (benchmarkResult ["gbPerSecond"]), 2) + " GB/s";
+            if (benchmarkResult.hasProperty ("cpuLoadPercent"))
+                summary += "   " + juce::String (static_cast<double> (benchmarkResult ["cpuLoadPercent"]), 2) + "% cpu";
+            if (benchmarkResult.hasProperty ("cpuLoadBudgetPercent"))
+                summary += " (budget " + benchmarkResult ["cpuLoadBudgetPercent"].toString () + "%" + (static_cast<bool> (benchmarkResult ["withinBudget"]) ? ")" : ", OVER BUDGET)");
+            writeOutput (summary);
+        }
+        return;
+    }
+    writeOutput (resultsJson);
+}
+
+// a range option is given as <first>-<last>
+static std::pair<juce::String, juce::String> getRangeOption (const juce::ArgumentList& args, juce::StringRef option, juce::String defaultFirst, juce::String defaultLast)
+{
+    if (! args.containsOption (option))
+        return { defaultFirst, defaultLast };
+    const auto value { args.getValueForOption (option) };
+    if (! value.containsChar ('-'))
+        return { value, value };
+    return { value.upToFirstOccurrenceOf ("-", false, false), value.fromFirstOccurrenceOf ("-", false, false) };
+}
+
+SyntheticCardGenerator::Options CommandLineRunner::getGeneratorOptions (const juce::ArgumentList& args)
+{
+    SyntheticCardGenerator::Options options;
+    auto getIntOption = [&args] (juce::StringRef option, int defaultValue, int minValue, int maxValue)
+    {
+        if (! args.containsOption (option))
+            return defaultValue;
+        const auto value { args.getValueForOption (option).getIntValue () };
+        if (value < minValue || value > maxValue)
+            juce::ConsoleApplication::fail (juce::String (option) + " must be from " + juce::String (minValue) + " to " + juce::String (maxValue));
+        return value;
+    };
+    options.numBanks = getIntOption ("--banks", options.numBanks, 1, CardIndexer::kMaxBanks);
+    options.emptyChannelPercent = getIntOption ("--empty", options.emptyChannelPercent, 0, 100);
+    options.junkFilesPerBank = getIntOption ("--junk", options.junkFilesPerBank, 0, 1000);
+    options.numImportSamples = getIntOption ("--imports", options.numImportSamples, 0, 1000);
+    options.seed = getIntOption ("--seed", options.seed, 0, std::numeric_limits<int>::max ());
+
+    const auto [minSeconds, maxSeconds] { getRangeOption (args, "--seconds", juce::String (options.minSampleSeconds), juce::String (options.maxSampleSeconds)) };
+    options.minSampleSeconds = minSeconds.getDoubleValue ();
+    options.maxSampleSeconds = maxSeconds.getDoubleValue ();
+    // the longest sample the module plays is 524287 samples, a little under 12 seconds, longer samples are cut short when they are loaded
+    if (options.minSampleSeconds <= 0.0 || options.minSampleSeconds > options.maxSampleSeconds || options.maxSampleSeconds > 11.5)
+        juce::ConsoleApplication::fail ("--seconds must be <min>-<max>, with 0 < min <= max <= 11.5");
+
+    const auto [firstVersion, lastVersion] { getRangeOption (args, "--versions", juce::String (options.firstVersion), juce::String (options.lastVersion)) };
+    options.firstVersion = firstVersion.getIntValue ();
+    options.lastVersion = lastVersion.getIntValue ();
+    if (options.firstVersion < BusyChunkLayout::kFirstSupportedVersion || options.firstVersion > options.lastVersion || options.lastVersion > BusyChunkLayout::kCurrentVersion)
+        juce::ConsoleApplication::fail ("--versions must be <first>-<last>, within " + juce::String (BusyChunkLayout::kFirstSupportedVersion) + "-" + juce::String (BusyChunkLayout::kCurrentVersion));
+
+    if (args.containsOption ("--importFormat"))
+    {
+        const auto formatParts { juce::StringArray::fromTokens (args.getValueForOption ("--importFormat"), "/", {}) };
+        options.importSampleRate = formatParts [0].getDoubleValue ();
+        options.importBitsPerSample = formatParts.size () > 1 ? formatParts [1].getIntValue () : options.importBitsPerSample;
+        options.importNumChannels = formatParts.size () > 2 ? formatParts [2].getIntValue () : options.importNumChannels;
+        if (options.importSampleRate < 8000.0 || options.importSampleRate > 192000.0 || (options.importBitsPerSample != 16 && options.importBitsPerSample != 24) ||
+            options.importNumChannels < 1 || options.importNumChannels > 2)
+            juce::ConsoleApplication::fail ("--importFormat must be <rate>/<bits>/<channels>, with a rate from 8000 to 192000, 16 or 24 bits, and 1 or 2 channels");
+    }
+    return options;
+}
+
+juce::File CommandLineRunner::getFolderArgument (const juce::ArgumentList& args, int positionalIndex, juce::String description)
+{
+    auto curPositionalIndex { 0 };
+    for (const auto& argument : args.arguments)
+    {
+        if (argument.isOption ())
+            continue;
+        if (curPositionalIndex++ != positionalIndex)
+            continue;
+        const auto folder { argument.resolveAsFile () };
+        if (! folder.isDirectory ())
+            juce::ConsoleApplication::fail ("'" + argument.text + "' is not a folder");
+        return folder;
+    }
+    juce::ConsoleApplication::fail ("missing the " + description);
+    return {};
+}
+
+int CommandLineRunner::getNumThreads (const juce::ArgumentList& args)
+{
+    if (! args.containsOption ("--threads"))
+        return juce::SystemStats::getNumCpus ();
+    return juce::jlimit (1, 256, args.getValueForOption ("--threads").getIntValue ());
+}
+
+// same approach as CardIndexer::index, each bank is a separate job, and the jobs don't share anything
+void CommandLineRunner::forEachBankInParallel (int numBanks, int numThreads, std::function<void (int bankIndex)> bankJob)
+{
+    if (numBanks == 0)
+        return;
+    std::atomic<int> banksRemaining { numBanks };
+    juce::WaitableEvent jobsComplete;
+    juce::ThreadPool threadPool (juce::jlimit (1, numBanks, numThreads));
+    for (auto bankIndex { 0 }; bankIndex < numBanks; ++bankIndex)
+    {
+        threadPool.addJob ([bankIndex, &bankJob, &banksRemaining, &jobsComplete] ()
+        {
+            bankJob (bankIndex);
+            if (--banksRemaining == 0)
+                jobsComplete.signal ();
+        });
+    }
+    jobsComplete.wait ();
+}
+
+// the values as they are stored in the 'busy' chunk
+juce::var CommandLineRunner::channelRecordToVar (const ChannelRecord& channelRecord)
+{
+    auto* recordObject { new juce::DynamicObject };
+    recordObject->setProperty ("version", static_cast<int> (channelRecord.loadedVersion));
+    recordObject->setProperty ("channelSource", static_cast<int> (channelRecord.channelSource));
+    recordObject->setProperty ("choke", static_cast<int> (channelRecord.choke));
+    recordObject->setProperty ("recDest", static_cast<int> (channelRecord.recDest));
+    recordObject->setProperty ("bits", static_cast<int> (channelRecord.bits));
+    recordObject->setProperty ("rate", static_cast<int> (channelRecord.rate));
+    recordObject->setProperty ("loopMode", static_cast<int> (channelRecord.loopMode));
+    recordObject->setProperty ("reverse", static_cast<int> (channelRecord.reverse));
+    recordObject->setProperty ("xfade", static_cast<int> (channelRecord.xfade));
+    recordObject->setProperty ("eTrig", static_cast<int> (channelRecord.eTrig));
+    recordObject->setProperty ("quant", static_cast<int> (channelRecord.quant));
+    recordObject->setProperty ("steps", static_cast<int> (channelRecord.steps));
+    recordObject->setProperty ("filterType", static_cast<int> (channelRecord.filterType));
+    recordObject->setProperty ("attack", static_cast<int> (channelRecord.attack));
+    recordObject->setProperty ("decay", static_cast<int> (channelRecord.decay));
+    recordObject->setProperty ("level", static_cast<int> (channelRecord.level));
+    recordObject->setProperty ("speed", static_cast<int> (channelRecord.speed));
+    recordObject->setProperty ("filterFrequency", static_cast<int> (channelRecord.filterFrequency));
+    recordObject->setProperty ("filterResonance", static_cast<int> (channelRecord.filterResonance));
+    recordObject->setProperty ("pitchShift", static_cast<int> (channelRecord.pitchShift));
+    recordObject->setProperty ("channelFlags", static_cast<int> (channelRecord.channelFlags));
+    recordObject->setProperty ("startCue", static_cast<juce::int64> (channelRecord.startCue));
+    recordObject->setProperty ("loopCue", static_cast<juce::int64> (channelRecord.loopCue));
+    recordObject->setProperty ("endCue", static_cast<juce::int64> (channelRecord.endCue));
+    recordObject->setProperty ("endOfData", static_cast<juce::int64> (channelRecord.endOfData));
+    recordObject->setProperty ("curCueSet", channelRecord.curCueSet);
+
+    juce::Array<juce::var> cueSetList;
+    for (auto cueSetIndex { 0 }; cueSetIndex < channelRecord.numCueSets; ++cueSetIndex)
+    {
+        const auto& cueSet { channelRecord.cueSets [static_cast<size_t> (cueSetIndex)] };
+        cueSetList.add (juce::Array<juce::var> { static_cast<juce::int64> (cueSet.start), static_cast<juce::int64> (cueSet.loop), static_cast<juce::int64> (cueSet.end) });
+    }
+    recordObject->setProperty ("cueSets", cueSetList);
+
+    // only the enabled assignments
+    juce::Array<juce::var> cvAssignList;
+    for (auto cvInputIndex { 0 }; cvInputIndex < ChannelRecord::kNumCvInputs; ++cvInputIndex)
+    {
+        for (auto parameterIndex { 0 }; parameterIndex < ChannelRecord::kNumCvParameters; ++parameterIndex)
+        {
+            const auto& cvAssign { channelRecord.cvAssigns [static_cast<size_t> (cvInputIndex)] [static_cast<size_t> (parameterIndex)] };
+            if (! cvAssign.enabled)
+                continue;
+            auto* cvAssignObject { new juce::DynamicObject };
+            cvAssignObject->setProperty ("cvInput", cvInputIndex + 1);
+            cvAssignObject->setProperty ("parameter", parameterIndex);
+            cvAssignObject->setProperty ("offset", static_cast<int> (cvAssign.offset));
+            cvAssignObject->setProperty ("attenuation", static_cast<int> (cvAssign.attenuation));
+            cvAssignList.add (cvAssignObject);
+        }
+    }
+    recordObject->setProperty ("cvAssigns", cvAssignList);
+    return recordObject;
+}
+
+juce::StringArray CommandLineRunner::validateChannel (const CardIndexer::ChannelEntry& channelEntry)
+{
+    juce::StringArray problems;
+    const auto& sampleFile { channelEntry.sampleFile };
+    if (sampleFile == juce::File ())
+        return problems;
+
+    juce::WavAudioFormat wavAudioFormat;
+    std::unique_ptr<juce::AudioFormatReader> reader { wavAudioFormat.createReaderFor (sampleFile.createInputStream ().release (), true) };
+    if (reader == nullptr)
+    {
+        problems.add (sampleFile.getFileName () + " is not a readable wav file");
+        return problems;
+    }
+    if (reader->sampleRate != 44100.0)
+        problems.add ("the sample rate is " + juce::String (reader->sampleRate) + ", not 44100");
+    if (reader->numChannels != 1)
+        problems.add ("the sample has " + juce::String (reader->numChannels) + " channels, not 1");
+
+    if (! channelEntry.hasMetaData)
+    {
+        // tell a missing chunk apart from one that could not be used
+        BusyChunkReader busyChunkReader;
+        juce::MemoryBlock busyChunkData;
+        if (busyChunkReader.readMetaData (sampleFile, busyChunkData))
+            problems.add ("the 'busy' chunk has the wrong signature, an unsupported version, or is too small");
+        else
+            problems.add ("there is no 'busy' chunk");
+        return problems;
+    }
+
+    const auto& channelRecord { channelEntry.channelRecord };
+    const auto sampleDataSize { static_cast<juce::int64> (SquidChannelProperties::sampleOffsetToByteOffset (1)) * reader->lengthInSamples };
+    if (channelRecord.endOfData > sampleDataSize)
+        problems.add ("the end of data (" + juce::String (channelRecord.endOfData) + ") is past the end of the sample (" + juce::String (sampleDataSize) + ")");
+    auto checkCues = [&problems, endOfData = channelRecord.endOfData] (juce::String cueName, uint32_t startCue, uint32_t loopCue, uint32_t endCue)
+    {
+        // an empty channel has all of its cues at 0
+        if (startCue == 0 && loopCue == 0 && endCue == 0)
+            return;
+        if (! (startCue <= loopCue && loopCue < endCue))
+            problems.add (cueName + " cues are out of order (start " + juce::String (startCue) + ", loop " + juce::String (loopCue) + ", end " + juce::String (endCue) + ")");
+        if (endCue > endOfData)
+            problems.add (cueName + " end cue (" + juce::String (endCue) + ") is past the end of data (" + juce::String (endOfData) + ")");
+    };
+    checkCues ("the current", channelRecord.startCue, channelRecord.loopCue, channelRecord.endCue);
+    if (channelRecord.numCueSets < 1 || channelRecord.numCueSets > kCueNumSets)
+    {
+        problems.add ("the number of cue sets (" + juce::String (channelRecord.numCueSets) + ") is out of range");
+    }
+    else
+    {
+        for (auto cueSetIndex { 0 }; cueSetIndex < channelRecord.numCueSets; ++cueSetIndex)
+        {
+            const auto& cueSet { channelRecord.cueSets [static_cast<size_t> (cueSetIndex)] };
+            checkCues ("cue set " + juce::String (cueSetIndex + 1), cueSet.start, cueSet.loop, cueSet.end);
+        }
+        if (channelRecord.curCueSet >= channelRecord.numCueSets)
+            problems.add ("the current cue set (" + juce::String (channelRecord.curCueSet + 1) + ") is past the last cue set");
+    }
+    if ((channelRecord.channelFlags & ChannelFlags::kCueRandom) && (channelRecord.channelFlags & ChannelFlags::kCueStepped))
+        problems.add ("both cue random and cue step are on");
+    return problems;
+}
+
+// returns a description of what went wrong, or an empty string
+juce::String CommandLineRunner::importBank (juce::File samplesFolder, juce::File bankDirectory)
+{
+    // only the sample conversion and loading of the EditManager is used, which does not need it to be initialised (ie. attached to the app's edit bank)
+    EditManager editManager;
+    juce::Array<juce::File> sampleFiles;
+    for (const auto& entry : juce::RangedDirectoryIterator (samplesFolder, false, "*", juce::File::findFiles))
+        if (editManager.isSquidManagerSupportedAudioFile (entry.getFile ()))
+            sampleFiles.add (entry.getFile ());
+    if (sampleFiles.isEmpty ())
+        return "there are no audio files";
+    std::sort (sampleFiles.begin (), sampleFiles.end (), [] (const juce::File& fileOne, const juce::File& fileTwo)
+    {
+        return fileOne.getFileName ().compareNatural (fileTwo.getFileName ()) < 0;
+    });
+    if (const auto result { bankDirectory.createDirectory () }; result.failed ())
+        return result.getErrorMessage ();
+
+    juce::StringArray problems;
+    SquidBankProperties squidBankProperties ({}, SquidBankProperties::WrapperType::owner, SquidBankProperties::EnableCallbacks::no);
+    for (auto channelIndex { 0 }; channelIndex < std::min (sampleFiles.size (), CardIndexer::kNumChannels); ++channelIndex)
+    {
+        // the same steps as assigning a sample to a channel in the editor, and then saving the bank
+        const auto& srcFile { sampleFiles [channelIndex] };
+        const auto channelDirectory { bankDirectory.getChildFile (juce::String (channelIndex + 1)) };
+        const auto convertedFile { channelDirectory.getChildFile (srcFile.withFileExtension ("_wav").getFileName ()) };
+        if (channelDirectory.createDirectory ().failed () || ! editManager.copySampleToChannel (srcFile, convertedFile))
+        {
+            problems.add ("channel " + juce::String (channelIndex + 1) + ", unable to convert " + srcFile.getFileName ());
+            continue;
+        }
+        auto channelPropertiesVT { squidBankProperties.getChannelVT (channelIndex) };
+        editManager.loadChannel (channelPropertiesVT, static_cast<uint8_t> (channelIndex), convertedFile);
+        SquidMetaDataWriter squidMetaDataWriter;
+        if (! squidMetaDataWriter.write (channelPropertiesVT, convertedFile, convertedFile.withFileExtension ("wav")))
+            problems.add ("channel " + juce::String (channelIndex + 1) + ", unable to write " + convertedFile.withFileExtension ("wav").getFileName ());
+        convertedFile.deleteFile ();
+    }
+    if (sampleFiles.size () > CardIndexer::kNumChannels)
+        problems.add (juce::String (sampleFiles.size () - CardIndexer::kNumChannels) + " audio files were left out, a bank has " + juce::String (CardIndexer::kNumChannels) + " channels");
+    bankDirectory.getChildFile ("info.txt").replaceWithText (samplesFolder.getFileName ().substring (0, 11));
+    return problems.joinIntoString ("; ");
+}
+
+void CommandLineRunner::writeOutput (const juce::String& text)
+{
+    std::cout << text << std::endl;
+}
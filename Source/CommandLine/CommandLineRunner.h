@@ -0,0 +1,50 @@
+#pragma once
+
+#include <JuceHeader.h>
+#include "SyntheticCardGenerator.h"
+#include "../SquidSalmple/Bank/CardIndexer.h"
+
+// CommandLineRunner - batch card operations, run from the command line without starting the ui or the audio device
+//
+//  SquidManager --scan <card folder>
+//  SquidManager --dump <card folder> [--output=<json file>]
+//  SquidManager --validate <card folder>
+//  SquidManager --import <samples folder> <card folder> [--bank=<first bank number>]
+//  SquidManager --generate <output folder> [card options]
+//  SquidManager --benchmark [--output=<json file>] [--iterations=<count>] [--skip=<name,...>] [--keep] [card options]
+//  SquidManager --fuzz-busy-chunk [--iterations=<count>] [--seed=<number>] [--corpus=<folder>]
+//
+// all commands take --threads=<count> (the default is the number of cpus), the banks are processed in parallel
+//
+// card options, for the synthetic card: --banks=<count> --seconds=<min>-<max> --versions=<first>-<last> --empty=<percent of channels>
+//                                       --junk=<files per bank> --imports=<count> --importFormat=<rate>/<bits>/<channels> --seed=<number>
+class CommandLineRunner
+{
+public:
+    CommandLineRunner ();
+
+    // true if the command line holds one of the commands, otherwise the app starts normally
+    bool isCommandLineRequest (const juce::String& commandLine);
+    // returns the exit code for the app
+    int run (const juce::String& commandLine);
+
+private:
+    juce::ConsoleApplication consoleApplication;
+
+    void scanCard (const juce::ArgumentList& args);
+    void dumpCard (const juce::ArgumentList& args);
+    void validateCard (const juce::ArgumentList& args);
+    void importSamples (const juce::ArgumentList& args);
+    void generateCard (const juce::ArgumentList& args);
+    void runBenchmark (const juce::ArgumentList& args);
+    void fuzzBusyChunk (const juce::ArgumentList& args);
+
+    static juce::File getFolderArgument (const juce::ArgumentList& args, int positionalIndex, juce::String description);
+    static int getNumThreads (const juce::ArgumentList& args);
+    static SyntheticCardGenerator::Options getGeneratorOptions (const juce::ArgumentList& args);
+    static void forEachBankInParallel (int numBanks, int numThreads, std::function<void (int bankIndex)> bankJob);
+    static juce::var channelRecordToVar (const ChannelRecord& channelRecord);
+    static juce::StringArray validateChannel (const CardIndexer::ChannelEntry& channelEntry);
+    static juce::String importBank (juce::File samplesFolder, juce::File bankDirectory);
+    static void writeOutput (const juce::String& text);
+};
@@ -0,0 +1,192 @@
+#include "SyntheticCardGenerator.h"
+#include "../SquidSalmple/SquidChannelProperties.h"
+#include "../SquidSalmple/Bank/CardIndexer.h"
+#include "../SquidSalmple/Metadata/BusyChunkCodec.h"
+#include "../SquidSalmple/Metadata/BusyChunkWriter.h"
+#include "../SquidSalmple/Metadata/SquidSalmpleDefs.h"
+
+// encodes with the layout of LayoutVersion, which covers every version up to it, and stamps the chunk with the requested version
+template <uint8_t LayoutVersion>
+static juce::MemoryBlock encodeBusyChunk (uint8_t version, const ChannelRecord& channelRecord)
+{
+    juce::MemoryBlock busyChunkData (BusyChunkLayout::kLayout<LayoutVersion>.size, true);
+    auto* data { static_cast<uint8_t*> (busyChunkData.getData ()) };
+    BusyChunkCodec::writeValue<k32BitSize> (data + BusyChunkLayout::kLayout<LayoutVersion> [BusyChunkLayout::FieldId::signatureAndVersion].offset,
+                                            (kSignatureAndVersionCurrent & 0xFFFFFF00) | version);
+    BusyChunkCodec::encode<LayoutVersion> (data, channelRecord);
+    return busyChunkData;
+}
+
+juce::MemoryBlock SyntheticCardGenerator::makeBusyChunk (uint8_t version, const ChannelRecord& channelRecord)
+{
+    jassert (version >= BusyChunkLayout::kFirstSupportedVersion && version <= BusyChunkLayout::kCurrentVersion);
+    if (version <= BusyChunkLayout::kLayoutVersions [0])
+        return encodeBusyChunk<BusyChunkLayout::kLayoutVersions [0]> (version, channelRecord);
+    return encodeBusyChunk<BusyChunkLayout::kLayoutVersions [1]> (version, channelRecord);
+}
+
+juce::Result SyntheticCardGenerator::generate (juce::File cardFolder, juce::File importFolder, const Options& options)
+{
+    jassert (options.numBanks >= 0 && options.numBanks <= CardIndexer::kMaxBanks);
+    jassert (options.firstVersion >= BusyChunkLayout::kFirstSupportedVersion && options.firstVersion <= options.lastVersion && options.lastVersion <= BusyChunkLayout::kCurrentVersion);
+    jassert (options.minSampleSeconds > 0.0 && options.minSampleSeconds <= options.maxSampleSeconds);
+
+    if (cardFolder.exists () && (! cardFolder.isDirectory () || cardFolder.getNumberOfChildFiles (juce::File::findFilesAndDirectories | juce::File::ignoreHiddenFiles) > 0))
+        return juce::Result::fail ("'" + cardFolder.getFullPathName () + "' is not an empty folder");
+    if (const auto result { cardFolder.createDirectory () }; result.failed ())
+        return result;
+
+    random.setSeed (options.seed);
+    for (auto bankNumber { 1 }; bankNumber <= options.numBanks; ++bankNumber)
+        if (const auto result { writeBank (cardFolder.getChildFile ("Bank " + juce::String (bankNumber)), bankNumber, options) }; result.failed ())
+            return result;
+
+    // things found on real cards, that the scanners have to step over
+    if (options.junkFilesPerBank > 0)
+    {
+        for (const auto& folderName : { "Bank 0", "Bank 120", "Recordings", "System Volume Information" })
+            if (const auto result { cardFolder.getChildFile (folderName).createDirectory () }; result.failed ())
+                return result;
+        if (const auto result { writeJunkFile (cardFolder.getChildFile ("Recordings").getChildFile ("rec001.raw"), 64 * 1024) }; result.failed ())
+            return result;
+        if (! cardFolder.getChildFile ("README.txt").replaceWithText ("synthetic card, seed " + juce::String (options.seed)))
+            return juce::Result::fail ("unable to write README.txt");
+    }
+
+    if (options.numImportSamples > 0)
+        return writeImportSamples (importFolder, options);
+    return juce::Result::ok ();
+}
+
+juce::Result SyntheticCardGenerator::writeBank (juce::File bankDirectory, int bankNumber, const Options& options)
+{
+    if (const auto result { bankDirectory.createDirectory () }; result.failed ())
+        return result;
+    if (! bankDirectory.getChildFile ("info.txt").replaceWithText (("Synth " + juce::String (bankNumber)).substring (0, 11)))
+        return juce::Result::fail ("unable to write info.txt in '" + bankDirectory.getFullPathName () + "'");
+
+    const auto numVersions { options.lastVersion - options.firstVersion + 1 };
+    for (auto channelIndex { 0 }; channelIndex < CardIndexer::kNumChannels; ++channelIndex)
+    {
+        const auto channelDirectory { bankDirectory.getChildFile (juce::String (channelIndex + 1)) };
+        if (const auto result { channelDirectory.createDirectory () }; result.failed ())
+            return result;
+        if (random.nextInt (100) < options.emptyChannelPercent)
+            continue;
+
+        auto sampleData { makeSampleData (44100.0, 1, options.minSampleSeconds, options.maxSampleSeconds) };
+        const auto channelRecord { makeChannelRecord (channelIndex, sampleData.getNumSamples ()) };
+        // every version is used the same number of times across the card
+        const auto version { static_cast<uint8_t> (options.firstVersion + ((bankNumber - 1) * CardIndexer::kNumChannels + channelIndex) % numVersions) };
+        auto busyChunkData { makeBusyChunk (version, channelRecord) };
+        const auto sampleFile { channelDirectory.getChildFile ("b" + juce::String (bankNumber).paddedLeft ('0', 2) + "c" + juce::String (channelIndex + 1) + " synth.wav") };
+        BusyChunkWriter busyChunkWriter;
+        if (! busyChunkWriter.write (sampleData, sampleFile, busyChunkData))
+            return juce::Result::fail ("unable to write '" + sampleFile.getFullPathName () + "'");
+    }
+
+    const std::array<juce::File, 4> junkFiles { bankDirectory.getChildFile (".DS_Store"), bankDirectory.getChildFile ("notes.txt"),
+                                                bankDirectory.getChildFile ("1").getChildFile ("synth.asd"), bankDirectory.getChildFile ("Thumbs.db") };
+    for (auto junkFileIndex { 0 }; junkFileIndex < options.junkFilesPerBank; ++junkFileIndex)
+    {
+        // past the list of names, the files are numbered
+        auto junkFile { junkFiles [static_cast<size_t> (junkFileIndex % static_cast<int> (junkFiles.size ()))] };
+        if (junkFileIndex >= static_cast<int> (junkFiles.size ()))
+            junkFile = junkFile.getSiblingFile (junkFile.getFileNameWithoutExtension () + juce::String (junkFileIndex / static_cast<int> (junkFiles.size ())) + junkFile.getFileExtension ());
+        if (const auto result { writeJunkFile (junkFile, 512 + random.nextInt (8 * 1024)) }; result.failed ())
+            return result;
+    }
+    return juce::Result::ok ();
+}
+
+juce::Result SyntheticCardGenerator::writeImportSamples (juce::File importFolder, const Options& options)
+{
+    if (const auto result { importFolder.createDirectory () }; result.failed ())
+        return result;
+
+    for (auto importSampleIndex { 0 }; importSampleIndex < options.numImportSamples; ++importSampleIndex)
+    {
+        const auto sampleData { makeSampleData (options.importSampleRate, options.importNumChannels, options.minSampleSeconds, options.maxSampleSeconds) };
+        const auto sampleFile { importFolder.getChildFile ("import " + juce::String (importSampleIndex + 1).paddedLeft ('0', 3) + ".wav") };
+        sampleFile.deleteFile ();
+        auto outputStream { std::make_unique<juce::FileOutputStream> (sampleFile) };
+        if (! outputStream->openedOk ())
+            return juce::Result::fail ("unable to write '" + sampleFile.getFullPathName () + "'");
+        juce::WavAudioFormat wavAudioFormat;
+        std::unique_ptr<juce::AudioFormatWriter> writer { wavAudioFormat.createWriterFor (outputStream.get (), options.importSampleRate, static_cast<unsigned int> (options.importNumChannels),
+                                                                                           options.importBitsPerSample, {}, 0) };
+        if (writer == nullptr)
+            return juce::Result::fail ("unable to write a " + juce::String (options.importSampleRate) + "/" + juce::String (options.importBitsPerSample) + " wav file");
+        // the writer now owns the stream
+        outputStream.release ();
+        if (! writer->writeFromAudioSampleBuffer (sampleData, 0, sampleData.getNumSamples ()))
+            return juce::Result::fail ("unable to write '" + sampleFile.getFullPathName () + "'");
+    }
+    return juce::Result::ok ();
+}
+
+// a decaying tone with a little noise, so the waveform and the conversion have real data to work on
+juce::AudioBuffer<float> SyntheticCardGenerator::makeSampleData (double sampleRate, int numChannels, double minSeconds, double maxSeconds)
+{
+    const auto seconds { minSeconds + (maxSeconds - minSeconds) * random.nextDouble () };
+    const auto numSamples { std::max (1, static_cast<int> (seconds * sampleRate)) };
+    const auto frequency { 55.0 * std::pow (2.0, random.nextDouble () * 4.0) };
+    const auto decayPerSample { std::pow (0.001, 1.0 / numSamples) };
+
+    juce::AudioBuffer<float> sampleData (numChannels, numSamples);
+    for (auto channel { 0 }; channel < numChannels; ++channel)
+    {
+        auto* samples { sampleData.getWritePointer (channel) };
+        auto envelope { 0.8 };
+        const auto phaseOffset { channel * 0.25 };
+        for (auto sampleIndex { 0 }; sampleIndex < numSamples; ++sampleIndex)
+        {
+            const auto tone { std::sin (juce::MathConstants<double>::twoPi * (frequency * sampleIndex / sampleRate + phaseOffset)) };
+            samples [sampleIndex] = static_cast<float> (envelope * tone + 0.02 * (random.nextDouble () * 2.0 - 1.0));
+            envelope *= decayPerSample;
+        }
+    }
+    return sampleData;
+}
+
+ChannelRecord SyntheticCardGenerator::makeChannelRecord (int channelIndex, int numSamples)
+{
+    ChannelRecord channelRecord;
+    channelRecord.channelIndex = static_cast<uint8_t> (channelIndex);
+    channelRecord.loopMode = static_cast<uint8_t> (random.nextInt (5));
+    channelRecord.filterType = static_cast<uint8_t> (random.nextInt (5));
+    channelRecord.filterFrequency = static_cast<uint16_t> (55 + random.nextInt (99) * 40); // the steps of the ui value
+    channelRecord.level = static_cast<uint16_t> (random.nextInt (65536));
+    channelRecord.endOfData = SquidChannelProperties::sampleOffsetToByteOffset (static_cast<uint32_t> (numSamples));
+
+    // contiguous cue sets, each looping from its middle
+    const auto numCueSets { 1 + random.nextInt (4) };
+    for (auto cueSetIndex { 0 }; cueSetIndex < numCueSets; ++cueSetIndex)
+    {
+        const auto startSample { static_cast<uint32_t> (static_cast<juce::int64> (numSamples) * cueSetIndex / numCueSets) };
+        const auto endSample { static_cast<uint32_t> (static_cast<juce::int64> (numSamples) * (cueSetIndex + 1) / numCueSets) };
+        channelRecord.setCueSetPoints (cueSetIndex, SquidChannelProperties::sampleOffsetToByteOffset (startSample),
+                                       SquidChannelProperties::sampleOffsetToByteOffset (startSample + (endSample - startSample) / 2),
+                                       SquidChannelProperties::sampleOffsetToByteOffset (endSample));
+    }
+    channelRecord.setCurCueSet (random.nextInt (numCueSets));
+
+    for (auto& cvInputAssigns : channelRecord.cvAssigns)
+    {
+        for (auto& cvAssign : cvInputAssigns)
+        {
+            cvAssign.enabled = random.nextInt (8) == 0;
+            cvAssign.attenuation = static_cast<int16_t> (random.nextInt (199) - 99);
+        }
+    }
+    return channelRecord;
+}
+
+juce::Result SyntheticCardGenerator::writeJunkFile (juce::File junkFile, int numBytes)
+{
+    juce::MemoryBlock junkData (static_cast<size_t> (numBytes));
+    random.fillBitsRandomly (junkData.getData (), junkData.getSize ());
+    if (! junkFile.replaceWithData (junkData.getData (), junkData.getSize ()))
+        return juce::Result::fail ("unable to write '" + junkFile.getFullPathName () + "'");
+    return juce::Result::ok ();
+}
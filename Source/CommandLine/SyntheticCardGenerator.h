@@ -0,0 +1,43 @@
+#pragma once
+
+#include <JuceHeader.h>
+#include "../SquidSalmple/ChannelRecord.h"
+
+// SyntheticCardGenerator - writes a card folder of generated banks, for benchmarking and for trying out the card tools without real samples.
+// everything is derived from the seed, so the same options always produce the same card. the samples are written in the format the module
+// uses (44.1k, 16 bit, mono) with a 'busy' chunk, cycling through the metadata versions, and the import samples are written in the format
+// given, so importing them goes through the conversion path
+class SyntheticCardGenerator
+{
+public:
+    struct Options
+    {
+        int numBanks { 16 };
+        int emptyChannelPercent { 10 };
+        double minSampleSeconds { 0.5 };
+        double maxSampleSeconds { 4.0 };
+        int firstVersion { 115 };
+        int lastVersion { 119 };
+        int junkFilesPerBank { 3 };
+        int numImportSamples { 8 };
+        double importSampleRate { 48000.0 };
+        int importBitsPerSample { 24 };
+        int importNumChannels { 2 };
+        int seed { 1 };
+    };
+
+    // the card folder must not exist, or be empty
+    juce::Result generate (juce::File cardFolder, juce::File importFolder, const Options& options);
+
+    // a 'busy' chunk in the layout of the given metadata version
+    static juce::MemoryBlock makeBusyChunk (uint8_t version, const ChannelRecord& channelRecord);
+
+private:
+    juce::Random random;
+
+    juce::AudioBuffer<float> makeSampleData (double sampleRate, int numChannels, double minSeconds, double maxSeconds);
+    ChannelRecord makeChannelRecord (int channelIndex, int numSamples);
+    juce::Result writeBank (juce::File bankDirectory, int bankNumber, const Options& options);
+    juce::Result writeImportSamples (juce::File importFolder, const Options& options);
+    juce::Result writeJunkFile (juce::File junkFile, int numBytes);
+};
@@ -1,6 +1,11 @@
 #include "BottomStatusWindow.h"
+#include "../Utility/Metrics.h"
 #include "../Utility/RuntimeRootProperties.h"
 
+const auto kStatusLineHeight { 30 };
+const auto kMetricsPanelHeight { 220 };
+const auto kMetricsUpdateInterval { 1000 };
+
 BottomStatusWindow::BottomStatusWindow ()
 {
     setOpaque (true);
@@ -13,6 +18,112 @@ BottomStatusWindow::BottomStatusWindow ()
         audioPlayerProperties.showConfigDialog (false);
     };
     addAndMakeVisible (settingsButton);
+
+    metricsButton.setButtonText ("METRICS");
+    metricsButton.setTooltip ("Show the performance counters. Scan, bank load and save times, cache hit rates, and the audio callback load and dropouts");
+    metricsButton.setClickingTogglesState (true);
+    metricsButton.onClick = [this] ()
+    {
+        setMetricsExpanded (metricsButton.getToggleState ());
+    };
+    addAndMakeVisible (metricsButton);
+
+    exportMetricsButton.setButtonText ("EXPORT");
+    exportMetricsButton.setTooltip ("Save the performance counters to a JSON file");
+    exportMetricsButton.onClick = [this] ()
+    {
+        fileChooser.reset (new juce::FileChooser ("Save the performance counters...",
+                                                  juce::File::getSpecialLocation (juce::File::userDesktopDirectory).getChildFile ("SquidManagerMetrics.json"), "*.json"));
+        fileChooser->launchAsync (juce::FileBrowserComponent::saveMode | juce::FileBrowserComponent::warnAboutOverwriting, [] (const juce::FileChooser& fc)
+        {
+            if (fc.getResults ().size () != 1)
+                return;
+            if (const auto result { Metrics::writeJson (fc.getResult ()) }; result.failed ())
+                juce::AlertWindow::showMessageBoxAsync (juce::AlertWindow::WarningIcon, "Export Failed", result.getErrorMessage (), {}, nullptr, nullptr);
+        }, nullptr);
+    };
+    addChildComponent (exportMetricsButton);
+
+    metricsTextEditor.setMultiLine (true, false);
+    metricsTextEditor.setReadOnly (true);
+    metricsTextEditor.setScrollbarsShown (true);
+    metricsTextEditor.setCaretVisible (false);
+    metricsTextEditor.setFont (juce::Font (juce::Font::getDefaultMonospacedFontName (), 12.0f, juce::Font::plain));
+    metricsTextEditor.setColour (juce::TextEditor::ColourIds::backgroundColourId, juce::Colours::black);
+    addChildComponent (metricsTextEditor);
+}
+
+int BottomStatusWindow::getPreferredHeight ()
+{
+    return kStatusLineHeight + (metricsTextEditor.isVisible () ? kMetricsPanelHeight : 0);
+}
+
+void BottomStatusWindow::setMetricsExpanded (bool expanded)
+{
+    metricsTextEditor.setVisible (expanded);
+    exportMetricsButton.setVisible (expanded);
+    // the metrics are only formatted while they are being looked at
+    if (expanded)
+    {
+        updateMetrics ();
+        startTimer (kMetricsUpdateInterval);
+    }
+    else
+    {
+        stopTimer ();
+    }
+    if (onExpandedChanged != nullptr)
+        onExpandedChanged ();
+}
+
+void BottomStatusWindow::updateMetrics ()
+{
+    const auto currentTime { juce::Time::currentTimeMillis () };
+    const auto secondsSinceLastUpdate { previousMetricsUpdateTime == 0 ? 0.0 : (currentTime - previousMetricsUpdateTime) / 1000.0 };
+    previousMetricsUpdateTime = currentTime;
+
+    const auto nl { juce::String ("\n") };
+    auto column = [] (juce::String text, int width) { return text.paddedLeft (' ', width); };
+    auto metricsText { juce::String ("counter").paddedRight (' ', 28) + column ("total", 14) + column ("per second", 14) + nl };
+    std::map<juce::String, uint64_t> counterValues;
+    Metrics::forEachCounter ([&] (const juce::String& name, const Metrics::Counter& counter)
+    {
+        const auto value { counter.get () };
+        counterValues [name] = value;
+        const auto previousValue { previousCounterValues.find (name) };
+        const auto perSecond { secondsSinceLastUpdate > 0.0 && previousValue != previousCounterValues.end ()
+                                   ? juce::String (static_cast<double> (value - previousValue->second) / secondsSinceLastUpdate, 1) : juce::String ("-") };
+        metricsText += name.paddedRight (' ', 28) + column (juce::String (static_cast<juce::int64> (value)), 14) + column (perSecond, 14) + nl;
+    });
+    // a pair of xxx.cacheHits and xxx.cacheMisses counters is also shown as a hit rate
+    for (const auto& [name, hits] : counterValues)
+    {
+        if (! name.endsWith (".cacheHits"))
+            continue;
+        const auto misses { counterValues.find (name.upToLastOccurrenceOf (".", true, false) + "cacheMisses") };
+        if (misses == counterValues.end () || hits + misses->second == 0)
+            continue;
+        const auto hitRate { 100.0 * static_cast<double> (hits) / static_cast<double> (hits + misses->second) };
+        metricsText += (name.upToLastOccurrenceOf (".", true, false) + "cacheHitRate").paddedRight (' ', 28) + column (juce::String (hitRate, 1) + "%", 14) + nl;
+    }
+    previousCounterValues = std::move (counterValues);
+
+    metricsText += nl + juce::String ("histogram").paddedRight (' ', 28) + column ("count", 10) + column ("mean", 10) + column ("p50", 10) +
+                   column ("p90", 10) + column ("p99", 10) + column ("max", 10) + nl;
+    Metrics::forEachHistogram ([&] (const juce::String& name, const Metrics::Histogram& histogram)
+    {
+        const auto snapshot { histogram.getSnapshot () };
+        auto valueColumn = [&column, unit = histogram.getUnit ()] (uint64_t value) { return column (juce::String (static_cast<juce::int64> (value)) + unit, 10); };
+        metricsText += name.paddedRight (' ', 28) + column (juce::String (static_cast<juce::int64> (snapshot.count)), 10) +
+                       column (juce::String (snapshot.getMean (), 1) + histogram.getUnit (), 10) + valueColumn (snapshot.getPercentile (50.0)) +
+                       valueColumn (snapshot.getPercentile (90.0)) + valueColumn (snapshot.getPercentile (99.0)) + valueColumn (snapshot.max) + nl;
+    });
+    metricsTextEditor.setText (metricsText, false);
+}
+
+void BottomStatusWindow::timerCallback ()
+{
+    updateMetrics ();
 }
 
 void BottomStatusWindow::init (juce::ValueTree rootPropertiesVT)
@@ -39,8 +150,14 @@ void BottomStatusWindow::paint (juce::Graphics& g)
 void BottomStatusWindow::resized ()
 {
     auto localBounds { getLocalBounds () };
-    localBounds.reduce (5, 3);
-    statusLabel.setBounds (localBounds);
+    auto statusLineBounds { localBounds.removeFromBottom (kStatusLineHeight) };
+    statusLineBounds.reduce (5, 3);
+    statusLabel.setBounds (statusLineBounds);
     const auto buttonWidth { 70 };
-    settingsButton.setBounds (getWidth () - 5 - buttonWidth, getHeight () / 2 - 10, buttonWidth, 20);
+    const auto buttonY { statusLineBounds.getCentreY () - 10 };
+    settingsButton.setBounds (getWidth () - 5 - buttonWidth, buttonY, buttonWidth, 20);
+    metricsButton.setBounds (settingsButton.getX () - 5 - buttonWidth, buttonY, buttonWidth, 20);
+    exportMetricsButton.setBounds (metricsButton.getX () - 5 - buttonWidth, buttonY, buttonWidth, 20);
+    localBounds.reduce (3, 3);
+    metricsTextEditor.setBounds (localBounds);
 }
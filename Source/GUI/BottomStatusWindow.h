@@ -5,11 +5,15 @@
 #include "SquidSalmple/BankList/BankListProperties.h"
 #include "../SquidSalmple/Audio/AudioPlayerProperties.h"
 
-class BottomStatusWindow : public juce::Component
+class BottomStatusWindow : public juce::Component,
+                           private juce::Timer
 {
 public:
     BottomStatusWindow ();
     void init (juce::ValueTree rootPropertiesVT);
+    int getPreferredHeight ();
+
+    std::function<void ()> onExpandedChanged;
 
 private:
     AudioPlayerProperties audioPlayerProperties;
@@ -19,6 +23,18 @@ private:
     juce::TextButton settingsButton;
     std::unique_ptr<juce::AlertWindow> settingsAlertWindow;
 
+    // metrics panel, shown above the status line when expanded
+    juce::TextButton metricsButton;
+    juce::TextButton exportMetricsButton;
+    juce::TextEditor metricsTextEditor;
+    std::unique_ptr<juce::FileChooser> fileChooser;
+    std::map<juce::String, uint64_t> previousCounterValues;
+    juce::int64 previousMetricsUpdateTime { 0 };
+
+    void setMetricsExpanded (bool expanded);
+    void updateMetrics ();
+
+    void timerCallback () override;
     void paint (juce::Graphics& g) override;
     void resized () override;
 };
@@ -2,8 +2,6 @@
 #include "../Utility/PersistentRootProperties.h"
 #include "../Utility/RuntimeRootProperties.h"
 
-const auto toolWindowHeight { 30 };
-
 MainComponent::MainComponent (juce::ValueTree rootPropertiesVT)
 {
     setSize (1117, 609);
@@ -19,6 +17,7 @@ MainComponent::MainComponent (juce::ValueTree rootPropertiesVT)
     // NOTE: bottomStatusWindow uses the BankListProperties, so it has to be initialised after BankListComponent.
     //       I dislike these kinds of requirements, so maybe figure out a different way at some point
     bottomStatusWindow.init (rootPropertiesVT);
+    bottomStatusWindow.onExpandedChanged = [this] () { resized (); };
     currentFolderComponent.init (rootPropertiesVT);
 
     fileViewComponent.overwriteBankOrCancel = [this] (std::function<void ()> overwriteFunction, std::function<void ()> cancelFunction)
@@ -71,7 +70,7 @@ void MainComponent::resized ()
 {
     auto localBounds { getLocalBounds () };
     currentFolderComponent.setBounds (localBounds.removeFromTop (30));
-    bottomStatusWindow.setBounds (localBounds.removeFromBottom (toolWindowHeight));
+    bottomStatusWindow.setBounds (localBounds.removeFromBottom (bottomStatusWindow.getPreferredHeight ()));
     localBounds.reduce (3, 3);
     folderBrowserEditorSplitter.setBounds (localBounds);
 }
@@ -4,7 +4,7 @@
 #include "../../../Utility/DebugLog.h"
 #include "../../../Utility/PersistentRootProperties.h"
 #include "../../../Utility/RuntimeRootProperties.h"
-#include "../../../Utility/WatchDogTimer.h"
+#include "../../../Utility/Trace.h"
 
 #define LOG_BANK_LIST 0
 #if LOG_BANK_LIST
@@ -29,6 +29,11 @@ BankListComponent::BankListComponent ()
         checkBanks ();
         return false;
     };
+    scanContentThread.onThreadLoop = [this] ()
+    {
+        findDuplicateSamples ();
+        return false;
+    };
 }
 
 void BankListComponent::init (juce::ValueTree rootPropertiesVT)
@@ -48,8 +53,10 @@ void BankListComponent::init (juce::ValueTree rootPropertiesVT)
     {
         LogBankList ("init - directoryDataProperties.onRootScanComplete");
         // clear list
-        juce::MessageManager::callAsync ([this] ()
+        juce::MessageManager::callAsync ([this, safeThis = juce::Component::SafePointer<BankListComponent> (this)] ()
         {
+            if (safeThis == nullptr)
+                return;
             if (! checkBanksThread.isThreadRunning ())
             {
                 checkForFolderChange ();
@@ -121,9 +128,8 @@ void BankListComponent::forEachBankDirectory (std::function<bool (juce::File ban
 
 void BankListComponent::checkBanks ()
 {
+    TRACE_SPAN ("BankListComponent::checkBanks");
     LogBankList ("BankListComponent::checkBanks - start");
-    WatchdogTimer timer;
-    timer.start (100000);
 
     FolderProperties rootFolder (directoryDataProperties.getRootFolderVT (), FolderProperties::WrapperType::client, FolderProperties::EnableCallbacks::no);
     currentFolder = juce::File (rootFolder.getName ());
@@ -148,7 +154,7 @@ void BankListComponent::checkBanks ()
             const auto bankId { folderName.substring (5).getIntValue () };
             if (folderName.substring (0, 5) == "Bank " && bankId > 0 && bankId < 100)
             {
-                bankListProperties.setStatus ("Scanning Bank Folder: " + folderName, false);
+                setStatus ("Scanning Bank Folder: " + folderName);
                 inBankList = true;
                 const auto fileToCheck { juce::File (folderProperties.getName ()) };
 
@@ -178,12 +184,14 @@ void BankListComponent::checkBanks ()
         }
         return true; // keep looking
     });
-    bankListProperties.setStatus ("", false);
+    setStatus ("");
 
     const auto isNewFolder { currentFolder != previousFolder };
     LogBankList (isNewFolder ? "new folder " + currentFolder.getFileName () : "no folder change");
-    juce::MessageManager::callAsync ([this, isNewFolder] ()
+    juce::MessageManager::callAsync ([this, safeThis = juce::Component::SafePointer<BankListComponent> (this), isNewFolder] ()
     {
+        if (safeThis == nullptr)
+            return;
         bankListBox.updateContent ();
         if (isNewFolder)
         {
@@ -191,10 +199,75 @@ void BankListComponent::checkBanks ()
             loadFirstBank ();
         }
         bankListBox.repaint ();
+        // look for duplicates after every bank scan, unchanged samples are not hashed again
+        scanContentThread.stop ();
+        contentScanFolder = currentFolder;
+        scanContentThread.start ();
     });
     previousFolder = currentFolder;
+}
+
+void BankListComponent::findDuplicateSamples ()
+{
+    TRACE_SPAN ("BankListComponent::findDuplicateSamples");
+    LogBankList ("findDuplicateSamples - start");
+    setStatus ("Looking for duplicate samples");
+    const auto scanCompleted { sampleContentIndex.scan (contentScanFolder, [this] () { return ! scanContentThread.shouldExit (); }) };
+    setStatus ("");
+    if (! scanCompleted)
+        return;
+
+    LogBankList ("findDuplicateSamples - " + juce::String (sampleContentIndex.getNumFilesHashedByLastScan ()) + " files hashed");
+    juce::MessageManager::callAsync ([safeThis = juce::Component::SafePointer<BankListComponent> (this)] ()
+    {
+        if (safeThis != nullptr)
+            safeThis->updateDuplicatesList ();
+    });
+}
 
-    LogBankList ("BankListComponent::checkBanks - elapsed time: " + juce::String (timer.getElapsedTime ()));
+// the status is set from the bank check and content scan threads, but the properties tree, and the ui listening to it, belong to the message thread
+void BankListComponent::setStatus (juce::String status)
+{
+    juce::MessageManager::callAsync ([safeThis = juce::Component::SafePointer<BankListComponent> (this), status] ()
+    {
+        if (safeThis != nullptr)
+            safeThis->bankListProperties.setStatus (status, false);
+    });
+}
+
+void BankListComponent::updateDuplicatesList ()
+{
+    for (auto& bankDuplicates : bankDuplicatesList)
+        bankDuplicates.clear ();
+
+    for (const auto& duplicateGroup : sampleContentIndex.getDuplicateGroups ())
+    {
+        for (const auto& location : duplicateGroup.locations)
+        {
+            juce::StringArray otherLocations;
+            for (const auto& otherLocation : duplicateGroup.locations)
+                if (&otherLocation != &location)
+                    otherLocations.add ("Bank " + juce::String (otherLocation.bankNumber) + " Channel " + juce::String (otherLocation.channelIndex + 1));
+            bankDuplicatesList [location.bankNumber - 1].add ("Channel " + juce::String (location.channelIndex + 1) + " is also in " + otherLocations.joinIntoString (", "));
+        }
+    }
+    bankListBox.repaint ();
+}
+
+void BankListComponent::showDuplicateSamples ()
+{
+    juce::StringArray duplicateGroupDescriptions;
+    for (const auto& duplicateGroup : sampleContentIndex.getDuplicateGroups ())
+    {
+        juce::StringArray locationDescriptions;
+        for (const auto& location : duplicateGroup.locations)
+            locationDescriptions.add (juce::String (location.bankNumber) + "-" + juce::String (location.channelIndex + 1));
+        duplicateGroupDescriptions.add (duplicateGroup.locations.front ().sampleFile.getFileName () + ": " + locationDescriptions.joinIntoString (", "));
+    }
+    if (duplicateGroupDescriptions.isEmpty ())
+        duplicateGroupDescriptions.add ("No duplicate samples found");
+
+    juce::AlertWindow::showMessageBoxAsync (juce::AlertWindow::InfoIcon, "DUPLICATE SAMPLES (Bank-Channel)", duplicateGroupDescriptions.joinIntoString ("\n"), "OK");
 }
 
 void BankListComponent::loadFirstBank ()
@@ -287,6 +360,11 @@ void BankListComponent::paintListBoxItem (int row, juce::Graphics& g, int width,
         }
         g.setColour (textColor);
         g.drawText ("  " + juce::String (bankNumber) + "-" + bankName, juce::Rectangle<float>{ 0.0f, 0.0f, (float) width, (float) height }, juce::Justification::centredLeft, true);
+        if (thisBankExists && ! bankDuplicatesList [bankNumber - 1].isEmpty ())
+        {
+            g.setColour (juce::Colours::orange.withAlpha (textColor.getFloatAlpha ()));
+            g.drawText ("DUP  ", juce::Rectangle<float>{ 0.0f, 0.0f, (float) width, (float) height }, juce::Justification::centredRight, true);
+        }
     }
 }
 
@@ -306,6 +384,8 @@ void BankListComponent::timerCallback ()
 juce::String BankListComponent::getTooltipForRow (int row)
 {
     auto [bankNumber, thisBankExists, bankName] { bankInfoList [row] };
+    if (const auto& bankDuplicates { bankDuplicatesList [bankNumber - 1] }; ! bankDuplicates.isEmpty ())
+        return "Bank " + juce::String (bankNumber) + "\n" + bankDuplicates.joinIntoString ("\n");
     return "Bank " + juce::String (bankNumber);
 }
 
@@ -382,7 +462,7 @@ void BankListComponent::deleteBank (int bankNumber)
             {
                 // clear editor
                 editManager->setBankDefaults ();
-                uneditedSquidBankProperties.copyFrom (squidBankProperties.getValueTree ());
+                editManager->updateUneditedBank ();
             }
         }));
 }
@@ -414,6 +494,8 @@ void BankListComponent::listBoxItemClicked (int row, [[maybe_unused]] const juce
         pm.addItem ("Copy", thisBankExists, false, [this, bankNumber = bankNumber] () { copyBank (bankNumber); });
         pm.addItem ("Paste", copyDirectory != juce::File (), false, [this, bankNumber = bankNumber] () { pasteBank (bankNumber); });
         pm.addItem ("Delete", thisBankExists, false, [this, bankNumber = bankNumber] () { deleteBank (bankNumber); });
+        pm.addSeparator ();
+        pm.addItem ("Show Duplicate Samples", ! scanContentThread.isThreadRunning (), false, [this] () { showDuplicateSamples (); });
         pm.showMenuAsync ({}, [this, popupMenuLnF] (int) { delete popupMenuLnF; });
     }
     else
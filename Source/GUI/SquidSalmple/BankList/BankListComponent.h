@@ -3,6 +3,7 @@
 #include <JuceHeader.h>
 #include "BankListProperties.h"
 #include "../../../AppProperties.h"
+#include "../../../SquidSalmple/Bank/SampleContentIndex.h"
 #include "../../../SquidSalmple/EditManager/EditManager.h"
 #include "../../../Utility/DirectoryDataProperties.h"
 #include "../../../Utility/LambdaThread.h"
@@ -36,17 +37,25 @@ private:
     juce::File previousFolder;
     int lastSelectedBankIndex { -1 };
     LambdaThread checkBanksThread { "CheckBanksThread", 100 };
+    SampleContentIndex sampleContentIndex;
+    juce::File contentScanFolder;
+    std::array<juce::StringArray, kMaxBanks> bankDuplicatesList; // indexed by bank number - 1, one line per channel with a duplicate elsewhere on the card
+    LambdaThread scanContentThread { "ScanContentThread", 1000 };
 
     void copyBank (int bankNumber);
     void checkBanks ();
     void checkForFolderChange ();
     void deleteBank (int bankNumber);
+    void findDuplicateSamples ();
     juce::File getBankDirectory (int bankNumber);
     void forEachBankDirectory (std::function<bool (juce::File bankDirectory, int index)> bankDirectoryCallback);
     void loadDefault (int row);
     void loadFirstBank ();
     void loadBank (juce::File bankDirectory);
     void pasteBank (int bankNumber);
+    void setStatus (juce::String status);
+    void showDuplicateSamples ();
+    void updateDuplicatesList ();
 
     void resized () override;
     void paint (juce::Graphics& g) override;
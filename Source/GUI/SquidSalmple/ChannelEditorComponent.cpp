@@ -1321,6 +1321,8 @@ void ChannelEditorComponent::setupComponents ()
             }
             else
             {
+                // stop first, so a play request always retriggers, even if something else is already playing
+                audioPlayerProperties.setPlayState (AudioPlayerProperties::PlayState::stop, false);
                 audioPlayerProperties.setSampleSource (squidChannelProperties.getChannelIndex (), false);
                 audioPlayerProperties.setPlayMode (playMode, false);
                 audioPlayerProperties.setPlayState (AudioPlayerProperties::PlayState::play, false);
@@ -1333,9 +1335,9 @@ void ChannelEditorComponent::setupComponents ()
         };
         addAndMakeVisible (playButton);
     };
-    loopPlayButton.setTooltip ("Continuous looping playback back the sample, using the loop and end cue points. No DSP is applied.");
+    loopPlayButton.setTooltip ("Continuous looping playback back the sample, using the loop and end cue points. The channel settings are applied, as the module would play them.");
     setupPlayButton (loopPlayButton, "LOOP", false, "ONCE", AudioPlayerProperties::PlayMode::loop);
-    oneShotPlayButton.setTooltip ("Play back the sample once, using the start and end cue points. No DSP is applied.");
+    oneShotPlayButton.setTooltip ("Play back the sample as the module would when triggered, using the cue points, loop mode and channel settings.");
     setupPlayButton (oneShotPlayButton, "ONCE", false, "LOOP", AudioPlayerProperties::PlayMode::once);
 
     // CUE SET ADD/DELETE BUTTONS
@@ -1528,6 +1530,15 @@ void ChannelEditorComponent::init (juce::ValueTree squidChannelPropertiesVT, juc
                     loopPlayButton.setButtonText ("LOOP");
                 });
             }
+            else if (audioPlayerProperties.getPlayMode () == AudioPlayerProperties::PlayMode::bank ||
+                     audioPlayerProperties.getPlayMode () == AudioPlayerProperties::PlayMode::file)
+            {
+                juce::MessageManager::callAsync ([this] ()
+                {
+                    oneShotPlayButton.setButtonText ("ONCE");
+                    loopPlayButton.setButtonText ("LOOP");
+                });
+            }
             else
             {
                 juce::MessageManager::callAsync ([this] ()
@@ -1569,6 +1580,29 @@ void ChannelEditorComponent::init (juce::ValueTree squidChannelPropertiesVT, juc
     setCurCue (squidChannelProperties.getCurCueSet ());
 
     // put initial data into the UI
+    updateControlsFromData ();
+
+    initializeCallbacks ();
+
+    const auto channelIndex { squidChannelProperties.getChannelIndex () };
+    if (channelIndex > 4)
+    {
+        speedLabel.setVisible (false);
+        speedTextEditor.setVisible (false);
+        pitchShiftLabel.setVisible (false);
+        pitchShiftTextEditor.setVisible (false);
+    }
+    else
+    {
+        quantLabel.setVisible (false);
+        quantComboBox.setVisible (false);
+    }
+    setFilterEnableState ();
+    setCueEditButtonsEnableState ();
+}
+
+void ChannelEditorComponent::updateControlsFromData ()
+{
     attackDataChanged (squidChannelProperties.getAttack ());
     channelSourceDataChanged (squidChannelProperties.getChannelSource ());
     channelFlagsDataChanged (squidChannelProperties.getChannelFlags ());
@@ -1592,24 +1626,6 @@ void ChannelEditorComponent::init (juce::ValueTree squidChannelPropertiesVT, juc
     startCueDataChanged (squidChannelProperties.getStartCue ());
     stepsDataChanged (squidChannelProperties.getSteps ());
     xfadeDataChanged (squidChannelProperties.getXfade ());
-
-    initializeCallbacks ();
-
-    const auto channelIndex { squidChannelProperties.getChannelIndex () };
-    if (channelIndex > 4)
-    {
-        speedLabel.setVisible (false);
-        speedTextEditor.setVisible (false);
-        pitchShiftLabel.setVisible (false);
-        pitchShiftTextEditor.setVisible (false);
-    }
-    else
-    {
-        quantLabel.setVisible (false);
-        quantComboBox.setVisible (false);
-    }
-    setFilterEnableState ();
-    setCueEditButtonsEnableState ();
 }
 
 void ChannelEditorComponent::initializeCallbacks ()
@@ -1669,23 +1685,9 @@ void ChannelEditorComponent::initializeCallbacks ()
     squidChannelProperties.onStepsChange = [this] (int steps) { stepsDataChanged (steps); };
     squidChannelProperties.onXfadeChange = [this] (int xfade) { xfadeDataChanged (xfade); };
 
-    squidChannelProperties.onSampleDataAudioBufferChange = [this] (AudioBufferRefCounted::RefCountedPtr audioBufferPtr)
-    {
-        updateLoopPointsView ();
-        if (squidChannelProperties.getSampleDataAudioBuffer () != nullptr)
-        {
-            waveformDisplay.setAudioBuffer (squidChannelProperties.getSampleDataAudioBuffer ()->getAudioBuffer ());
-            sampleLengthLabel.setText ("(" + juce::String (squidChannelProperties.getSampleDataNumSamples () / squidChannelProperties.getSampleDataSampleRate (), 2) + " seconds/" +
-                                       juce::String (squidChannelProperties.getSampleDataNumSamples ()) + " samples)", juce::NotificationType::dontSendNotification);
-        }
-        else
-        {
-            waveformDisplay.setAudioBuffer (nullptr);
-            sampleLengthLabel.setText ("", juce::NotificationType::dontSendNotification);
-        }
-        oneShotPlayButton.setEnabled (squidChannelProperties.getSampleDataAudioBuffer () != nullptr);
-        loopPlayButton.setEnabled (squidChannelProperties.getSampleDataAudioBuffer () != nullptr);
-    };
+    squidChannelProperties.onSampleDataAudioBufferChange = [this] (AudioBufferRefCounted::RefCountedPtr) { sampleDataAudioBufferDataChanged (); };
+    // bulk changes, like copying or loading a channel, arrive as one change set, so the editor is refreshed once instead of once per property
+    squidChannelProperties.onTransactionCommit = [this] (const SquidChannelProperties::ChangeSet& changeSet) { transactionCommitted (changeSet); };
 }
 
 void ChannelEditorComponent::updateLoopPointsView ()
@@ -1817,6 +1819,24 @@ void ChannelEditorComponent::eTrigDataChanged (int eTrig)
     eTrigComboBox.setSelectedItemIndex (eTrig, juce::NotificationType::dontSendNotification);
 }
 
+void ChannelEditorComponent::sampleDataAudioBufferDataChanged ()
+{
+    updateLoopPointsView ();
+    if (squidChannelProperties.getSampleDataAudioBuffer () != nullptr)
+    {
+        waveformDisplay.setAudioBuffer (squidChannelProperties.getSampleDataAudioBuffer ()->getAudioBuffer ());
+        sampleLengthLabel.setText ("(" + juce::String (squidChannelProperties.getSampleDataNumSamples () / squidChannelProperties.getSampleDataSampleRate (), 2) + " seconds/" +
+                                   juce::String (squidChannelProperties.getSampleDataNumSamples ()) + " samples)", juce::NotificationType::dontSendNotification);
+    }
+    else
+    {
+        waveformDisplay.setAudioBuffer (nullptr);
+        sampleLengthLabel.setText ("", juce::NotificationType::dontSendNotification);
+    }
+    oneShotPlayButton.setEnabled (squidChannelProperties.getSampleDataAudioBuffer () != nullptr);
+    loopPlayButton.setEnabled (squidChannelProperties.getSampleDataAudioBuffer () != nullptr);
+}
+
 void ChannelEditorComponent::sampleFileNameDataChanged (juce::String sampleFileName)
 {
     const auto justTheFileName { juce::File (sampleFileName).getFileNameWithoutExtension () };
@@ -1900,6 +1920,30 @@ void ChannelEditorComponent::xfadeDataChanged (int xfade)
     xfadeTextEditor.setText (juce::String (xfade), juce::NotificationType::dontSendNotification);
 }
 
+void ChannelEditorComponent::transactionCommitted (const SquidChannelProperties::ChangeSet& changeSet)
+{
+    auto hasChanged = [this, &changeSet] (const juce::Identifier& property)
+    {
+        return std::any_of (changeSet.begin (), changeSet.end (), [this, &property] (const auto& change) { return change.first == squidChannelProperties.getValueTree () && change.second == property; });
+    };
+
+    if (hasChanged (SquidChannelProperties::SampleDataAudioBufferPropertyId))
+        sampleDataAudioBufferDataChanged ();
+    if (hasChanged (SquidChannelProperties::NumCueSetsPropertyId))
+    {
+        initCueSetTabs ();
+        setCueEditButtonsEnableState ();
+    }
+    // setCurCue writes the cue set's points to the current cues, so it is only called when the cue sets changed, otherwise just the display is updated
+    if (hasChanged (SquidChannelProperties::NumCueSetsPropertyId) || hasChanged (SquidChannelProperties::CurCueSetPropertyId))
+        setCurCue (squidChannelProperties.getCurCueSet ());
+    else
+        waveformDisplay.setCuePoints (SquidChannelProperties::byteOffsetToSampleOffset (squidChannelProperties.getStartCueSet (curCueSetIndex)),
+                                      SquidChannelProperties::byteOffsetToSampleOffset (squidChannelProperties.getLoopCueSet (curCueSetIndex)),
+                                      SquidChannelProperties::byteOffsetToSampleOffset (squidChannelProperties.getEndCueSet (curCueSetIndex)));
+    updateControlsFromData ();
+}
+
 // UI Changed functions
 void ChannelEditorComponent::attackUiChanged (int attack)
 {
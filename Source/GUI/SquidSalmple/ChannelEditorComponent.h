@@ -160,6 +160,7 @@ private:
     void setCurCue (int cueSetIndex);
     void setFilterEnableState ();
     void setupComponents ();
+    void updateControlsFromData ();
     void updateLoopPointsView ();
 
     void attackDataChanged (int attack);
@@ -180,11 +181,13 @@ private:
     void pitchShiftDataChanged (int pitch);
     void rateDataChanged (int rate);
     void reverseDataChanged (int reverse);
+    void sampleDataAudioBufferDataChanged ();
     void sampleFileNameDataChanged (juce::String sampleFileName);
     void speedDataChanged (int speed);
     void startCueDataChanged (juce::int32 startCue);
     void stepsDataChanged (int steps);
     void xfadeDataChanged (int xfade);
+    void transactionCommitted (const SquidChannelProperties::ChangeSet& changeSet);
 
     void attackUiChanged (int attack);
     void bitsUiChanged (int bits);
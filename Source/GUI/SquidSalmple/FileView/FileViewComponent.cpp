@@ -2,7 +2,7 @@
 #include "../../../SystemServices.h"
 #include "../../../Utility/PersistentRootProperties.h"
 #include "../../../Utility/RuntimeRootProperties.h"
-#include "../../../Utility/WatchDogTimer.h"
+#include "../../../Utility/Trace.h"
 
 #define LOG_FILE_VIEW 0
 #if LOG_FILE_VIEW
@@ -46,6 +46,7 @@ void FileViewComponent::init (juce::ValueTree rootPropertiesVT)
     appProperties.wrap (persistentRootProperties.getValueTree (), AppProperties::WrapperType::client, AppProperties::EnableCallbacks::yes);
 
     RuntimeRootProperties runtimeRootProperties (rootPropertiesVT, RuntimeRootProperties::WrapperType::client, RuntimeRootProperties::EnableCallbacks::no);
+    audioPlayerProperties.wrap (runtimeRootProperties.getValueTree (), AudioPlayerProperties::WrapperType::client, AudioPlayerProperties::EnableCallbacks::no);
     SystemServices systemServices (runtimeRootProperties.getValueTree (), SystemServices::WrapperType::client, SystemServices::EnableCallbacks::no);
     editManager = systemServices.getEditManager ();
 
@@ -87,16 +88,14 @@ void FileViewComponent::init (juce::ValueTree rootPropertiesVT)
 
 void FileViewComponent::updateFromNewData ()
 {
+    TRACE_SPAN ("FileViewComponent::updateFromNewData");
     LogFileView ("FileViewComponent::updateFromNewData ()");
-    WatchdogTimer timer;
-    timer.start (10000);
     buildQuickLookupList ();
     juce::MessageManager::callAsync ([this] ()
     {
         directoryContentsListBox.updateContent ();
         directoryContentsListBox.repaint ();
     });
-    //juce::Logger::outputDebugString ("FileViewComponent::updateFromNewData () - elapsed time: " + juce::String (timer.getElapsedTime ()));
 }
 
 void FileViewComponent::buildQuickLookupList ()
@@ -256,7 +255,22 @@ void FileViewComponent::listBoxItemClicked (int row, [[maybe_unused]] const juce
     if (! isRootFolder && row != 0)
     {
         const auto directoryEntryVT { getDirectoryEntryVT (row) };
-        if (static_cast<int> (directoryEntryVT.getProperty ("type")) != DirectoryDataProperties::TypeIndex::folder)
+        const auto typeIndex { static_cast<int> (directoryEntryVT.getProperty ("type")) };
+        if (typeIndex == DirectoryDataProperties::TypeIndex::audioFile && me.mods.isPopupMenu ())
+        {
+            // audition the file straight from disk, without importing it
+            auto audioFile { juce::File (directoryEntryVT.getProperty ("name").toString ()) };
+            juce::PopupMenu pm;
+            pm.addSectionHeader (audioFile.getFileName ());
+            pm.addSeparator ();
+            if (isPreviewingFile (audioFile))
+                pm.addItem ("Stop", true, false, [this] () { stopPreview (); });
+            else
+                pm.addItem ("Play", true, false, [this, audioFile] () { previewFile (audioFile); });
+            pm.showMenuAsync ({}, [] (int) {});
+            return;
+        }
+        if (typeIndex != DirectoryDataProperties::TypeIndex::folder)
             return;
     }
 
@@ -359,6 +373,26 @@ void FileViewComponent::listBoxItemDoubleClicked (int row, [[maybe_unused]] cons
     }
 }
 
+bool FileViewComponent::isPreviewingFile (juce::File audioFile)
+{
+    return audioPlayerProperties.getPlayMode () == AudioPlayerProperties::PlayMode::file &&
+           audioPlayerProperties.getPlayState () == AudioPlayerProperties::PlayState::play &&
+           audioPlayerProperties.getFileSource () == audioFile.getFullPathName ();
+}
+
+void FileViewComponent::previewFile (juce::File audioFile)
+{
+    audioPlayerProperties.setPlayState (AudioPlayerProperties::PlayState::stop, false);
+    audioPlayerProperties.setFileSource (audioFile.getFullPathName (), false);
+    audioPlayerProperties.setPlayMode (AudioPlayerProperties::PlayMode::file, false);
+    audioPlayerProperties.setPlayState (AudioPlayerProperties::PlayState::play, false);
+}
+
+void FileViewComponent::stopPreview ()
+{
+    audioPlayerProperties.setPlayState (AudioPlayerProperties::PlayState::stop, false);
+}
+
 void FileViewComponent::resized ()
 {
     auto localBounds { getLocalBounds () };
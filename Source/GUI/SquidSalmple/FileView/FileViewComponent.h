@@ -2,6 +2,7 @@
 
 #include <JuceHeader.h>
 #include "../../../AppProperties.h"
+#include "../../../SquidSalmple/Audio/AudioPlayerProperties.h"
 #include "../../../SquidSalmple/EditManager/EditManager.h"
 #include "../../../Utility/DirectoryDataProperties.h"
 #include "../../../Utility/LambdaThread.h"
@@ -20,6 +21,7 @@ public:
 
 private:
     AppProperties appProperties;
+    AudioPlayerProperties audioPlayerProperties;
     DirectoryDataProperties directoryDataProperties;
     EditManager* editManager { nullptr };
 
@@ -44,8 +46,11 @@ private:
 
     void buildQuickLookupList ();
     juce::ValueTree getDirectoryEntryVT (int row);
+    bool isPreviewingFile (juce::File audioFile);
     void newFolder ();
     void openFolder ();
+    void previewFile (juce::File audioFile);
+    void stopPreview ();
     void updateFromNewData ();
 
     void resized () override;
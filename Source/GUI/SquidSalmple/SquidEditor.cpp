@@ -1,9 +1,9 @@
 #include "SquidEditor.h"
-#include "../../SquidSalmple/Bank/BankHelpers.h"
 #include "../../SquidSalmple/Bank/BankManagerProperties.h"
 #include "../../SquidSalmple/Metadata/SquidSalmpleDefs.h"
 #include "../../SystemServices.h"
 #include "../../Utility/PersistentRootProperties.h"
+#include "../../Utility/Trace.h"
 
 const auto kParameterLineHeight { 20 };
 const auto kInterControlYOffset { 2 };
@@ -97,6 +97,14 @@ SquidEditorComponent::SquidEditorComponent ()
 
         //pm.addItem ("Import", false, false, [this] () { /*importBank ();*/ });
         //pm.addItem ("Export", false, false, [this] () { /*exportBank ();*/ });
+        pm.addItem ("Undo", editManager->canUndo (), false, [this] ()
+        {
+            editManager->undo ();
+        });
+        pm.addItem ("Redo", editManager->canRedo (), false, [this] ()
+        {
+            editManager->redo ();
+        });
         pm.addItem ("Default", true, false, [this] ()
         {
             editManager->setBankDefaults ();
@@ -105,11 +113,50 @@ SquidEditorComponent::SquidEditorComponent ()
         {
             editManager->setBankUnedited ();
         });
+#if ENABLE_TRACING
+        pm.addSectionHeader ("Trace");
+        pm.addSeparator ();
+        pm.addItem ("Save Trace...", true, false, [this] ()
+        {
+            // the trace is a chrome://tracing (or ui.perfetto.dev) JSON file of the most recent spans
+            fileChooser.reset (new juce::FileChooser ("Save the trace file...",
+                                                      juce::File::getSpecialLocation (juce::File::userDesktopDirectory).getChildFile ("SquidManagerTrace.json"), "*.json"));
+            fileChooser->launchAsync (juce::FileBrowserComponent::saveMode | juce::FileBrowserComponent::warnAboutOverwriting, [] (const juce::FileChooser& fc)
+            {
+                if (fc.getResults ().size () != 1)
+                    return;
+                if (const auto result { Trace::writeChromeTrace (fc.getResult ()) }; result.failed ())
+                    juce::AlertWindow::showMessageBoxAsync (juce::AlertWindow::WarningIcon, "Save Trace Failed", result.getErrorMessage (), {}, nullptr, nullptr);
+            }, nullptr);
+        });
+        pm.addItem ("Clear Trace", true, false, [] ()
+        {
+            Trace::clear ();
+        });
+#endif
 
         pm.showMenuAsync ({}, [this, popupMenuLnF] (int) { delete popupMenuLnF; });
     };
     addAndMakeVisible (toolsButton);
 
+    // PLAY BANK BUTTON
+    playBankButton.setButtonText ("PLAY BANK");
+    playBankButton.setTooltip ("Play Bank. Previews all 8 channels mixed together, triggered from a simple step pattern. Mute, Solo, Choke and Neighbour Output are applied.");
+    playBankButton.onClick = [this] ()
+    {
+        if (playBankButton.getButtonText () == "STOP")
+        {
+            audioPlayerProperties.setPlayState (AudioPlayerProperties::PlayState::stop, false);
+        }
+        else
+        {
+            audioPlayerProperties.setPlayState (AudioPlayerProperties::PlayState::stop, false);
+            audioPlayerProperties.setPlayMode (AudioPlayerProperties::PlayMode::bank, false);
+            audioPlayerProperties.setPlayState (AudioPlayerProperties::PlayState::play, false);
+        }
+    };
+    addAndMakeVisible (playBankButton);
+
     // CHANNEL TABS
     channelTabs.isSupportedFile = [this] (juce::String fileName) { return editManager->isSquidManagerSupportedAudioFile (fileName); };
     channelTabs.loadFile = [this] (juce::String fileName, int channelIndex)
@@ -124,7 +171,10 @@ SquidEditorComponent::SquidEditorComponent ()
     addAndMakeVisible (channelTabs);
     channelTabs.onSelectedTabChanged = [this] (int)
     {
-        audioPlayerProperties.setPlayState (AudioPlayerProperties::PlayState::stop, false);
+        // the bank and file previews are not tied to a channel, so they keep playing
+        if (audioPlayerProperties.getPlayMode () != AudioPlayerProperties::PlayMode::bank &&
+            audioPlayerProperties.getPlayMode () != AudioPlayerProperties::PlayMode::file)
+            audioPlayerProperties.setPlayState (AudioPlayerProperties::PlayState::stop, false);
     };
 
     // the Channel tabs are overlaying the Tools button, move the load button to front
@@ -156,9 +206,16 @@ void SquidEditorComponent::init (juce::ValueTree rootPropertiesVT)
     editManager = systemServices.getEditManager ();
 
     audioPlayerProperties.wrap (runtimeRootProperties.getValueTree (), AudioPlayerProperties::WrapperType::client, AudioPlayerProperties::EnableCallbacks::yes);
+    audioPlayerProperties.onPlayStateChange = [this] (AudioPlayerProperties::PlayState playState)
+    {
+        const auto bankIsPlaying { playState == AudioPlayerProperties::PlayState::play && audioPlayerProperties.getPlayMode () == AudioPlayerProperties::PlayMode::bank };
+        juce::MessageManager::callAsync ([this, bankIsPlaying] ()
+        {
+            playBankButton.setButtonText (bankIsPlaying ? "STOP" : "PLAY BANK");
+        });
+    };
 
     BankManagerProperties bankManagerProperties (runtimeRootProperties.getValueTree (), BankManagerProperties::WrapperType::owner, BankManagerProperties::EnableCallbacks::no);
-    unEditedSquidBankProperties.wrap (bankManagerProperties.getBank ("unedited"), SquidBankProperties::WrapperType::client, SquidBankProperties::EnableCallbacks::yes);
     squidBankProperties.wrap (bankManagerProperties.getBank ("edit"), SquidBankProperties::WrapperType::client, SquidBankProperties::EnableCallbacks::yes);
     squidBankProperties.forEachChannel ([this, &rootPropertiesVT] (juce::ValueTree channelPropertiesVT, int channelIndex)
     {
@@ -186,7 +243,9 @@ void SquidEditorComponent::nameDataChanged (juce::String name)
 void SquidEditorComponent::timerCallback ()
 {
     // check if data has changed
-    saveButton.setEnabled (! BankHelpers::areEntireBanksEqual (unEditedSquidBankProperties.getValueTree (), squidBankProperties.getValueTree ()));
+    if (editManager == nullptr)
+        return;
+    saveButton.setEnabled (editManager->isBankEdited ());
 }
 
 void SquidEditorComponent::bankLoseEditWarning (juce::String title, std::function<void ()> overwriteFunction, std::function<void ()> cancelFunction)
@@ -194,7 +253,7 @@ void SquidEditorComponent::bankLoseEditWarning (juce::String title, std::functio
     jassert (overwriteFunction != nullptr);
     jassert (cancelFunction != nullptr);
 
-    if (BankHelpers::areEntireBanksEqual (unEditedSquidBankProperties.getValueTree (), squidBankProperties.getValueTree ()))
+    if (! editManager->isBankEdited ())
     {
         overwriteFunction ();
     }
@@ -215,6 +274,26 @@ void SquidEditorComponent::bankLoseEditWarning (juce::String title, std::functio
     }
 }
 
+bool SquidEditorComponent::keyPressed (const juce::KeyPress& key)
+{
+    if (editManager == nullptr)
+        return false;
+
+    // key presses the focused component does not use (ie. the bank name editor handles its own undo) end up here
+    if (key == juce::KeyPress ('z', juce::ModifierKeys::commandModifier, 0))
+    {
+        editManager->undo ();
+        return true;
+    }
+    if (key == juce::KeyPress ('z', juce::ModifierKeys::commandModifier | juce::ModifierKeys::shiftModifier, 0) ||
+        key == juce::KeyPress ('y', juce::ModifierKeys::commandModifier, 0))
+    {
+        editManager->redo ();
+        return true;
+    }
+    return false;
+}
+
 void SquidEditorComponent::resized ()
 {
     auto localBounds { getLocalBounds () };
@@ -228,6 +307,8 @@ void SquidEditorComponent::resized ()
     bankNameEditor.setBounds (topRowBounds.removeFromLeft (80));
     topRowBounds.removeFromRight (5);
     saveButton.setBounds (topRowBounds.removeFromRight (80));
+    topRowBounds.removeFromRight (5);
+    playBankButton.setBounds (topRowBounds.removeFromRight (80));
     toolsButton.setBounds (saveButton.getBounds ().withY (saveButton.getBottom () + 3));
 
     const auto channelSectionY { saveButton.getBottom () + 3 };
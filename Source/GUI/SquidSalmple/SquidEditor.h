@@ -22,7 +22,6 @@ private:
     AppProperties appProperties;
     AudioPlayerProperties audioPlayerProperties;
     SquidBankProperties squidBankProperties;
-    SquidBankProperties unEditedSquidBankProperties;
     EditManager* editManager { nullptr };
 
     class TabbedComponentWithChangeCallback : public juce::TabbedComponent
@@ -114,6 +113,7 @@ private:
     juce::TextEditor bankNameEditor;
     juce::TextButton saveButton;
     juce::TextButton toolsButton;
+    juce::TextButton playBankButton;
     TabbedComponentWithDropTabs channelTabs { juce::TabbedButtonBar::Orientation::TabsAtTop };
     std::unique_ptr<juce::FileChooser> fileChooser;
 
@@ -122,6 +122,7 @@ private:
     void nameUiChanged (juce::String name);
     void nameDataChanged (juce::String name);
 
+    bool keyPressed (const juce::KeyPress& key) override;
     void timerCallback () override;
     void resized () override;
     void paint (juce::Graphics& g) override;
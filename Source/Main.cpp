@@ -1,5 +1,6 @@
 #include <JuceHeader.h>
 #include "AppProperties.h"
+#include "CommandLine/CommandLineRunner.h"
 #include "SystemServices.h"
 #include "GUI/GuiProperties.h"
 #include "GUI/MainComponent.h"
@@ -37,11 +38,21 @@ public:
     const juce::String getApplicationVersion () override { return ProjectInfo::versionString; }
     bool moreThanOneInstanceAllowed () override { return true; }
 
-    void initialise ([[maybe_unused]] const juce::String& commandLine) override
+    void initialise (const juce::String& commandLine) override
     {
         initAppDirectory ();
         initLogger ();
         initCrashHandler ();
+
+        // batch commands run to completion here, without the ui, the audio device, or loading the app properties
+        if (CommandLineRunner commandLineRunner; commandLineRunner.isCommandLineRequest (commandLine))
+        {
+            isCommandLineMode = true;
+            setApplicationReturnValue (commandLineRunner.run (commandLine));
+            quit ();
+            return;
+        }
+
         initPropertyRoots ();
         initSquidSalmple ();
         initAudio ();
@@ -57,7 +68,8 @@ public:
 
     void shutdown () override
     {
-        persitentPropertiesFile.save ();
+        if (! isCommandLineMode)
+            persitentPropertiesFile.save ();
         mainWindow = nullptr; // (deletes our window)
         juce::Logger::setCurrentLogger (nullptr);
     }
@@ -305,6 +317,7 @@ private:
     std::atomic<RuntimeRootProperties::QuitState> localQuitState { RuntimeRootProperties::QuitState::idle };
     std::unique_ptr<MainWindow> mainWindow;
     AudioPlayer audioPlayer;
+    bool isCommandLineMode { false };
 
     // System Services
     EditManager editManager;
@@ -1,8 +1,11 @@
 #include "AudioPlayer.h"
+#include "../Metadata/SquidSalmpleDefs.h"
 #include "../Bank/BankManagerProperties.h"
 #include "../../Utility/DebugLog.h"
+#include "../../Utility/Metrics.h"
 #include "../../Utility/PersistentRootProperties.h"
 #include "../../Utility/RuntimeRootProperties.h"
+#include "../../Utility/Trace.h"
 
 #define LOG_AUDIO_PLAYER 0
 #if LOG_AUDIO_PLAYER
@@ -11,6 +14,11 @@
 #define LogAudioPlayer(text) ;
 #endif
 
+static auto& audioCallbackCount { Metrics::getCounter ("audio.callbacks") };
+static auto& audioCallbackTime { Metrics::getHistogram ("audio.callbackTime", "us") };
+static auto& audioCallbackLoad { Metrics::getHistogram ("audio.load", "%") };
+static auto& audioOverruns { Metrics::getCounter ("audio.overruns") };
+
 void AudioPlayer::init (juce::ValueTree rootPropertiesVT)
 {
     PersistentRootProperties persistentRootProperties (rootPropertiesVT, PersistentRootProperties::WrapperType::client, PersistentRootProperties::EnableCallbacks::no);
@@ -46,6 +54,19 @@ void AudioPlayer::init (juce::ValueTree rootPropertiesVT)
         LogAudioPlayer ("init: audioPlayerProperties.onSampleSourceChanged");
         initFromChannel (channelIndex);
     };
+    audioPlayerProperties.onFileSourceChange = [this] (juce::String fileName)
+    {
+        LogAudioPlayer ("init: audioPlayerProperties.onFileSourceChange");
+        initFromFile (fileName);
+    };
+    audioPlayerProperties.onBankTempoChange = [this] (int) { updateBankParameters (); };
+    audioPlayerProperties.onBankPatternChange = [this] (juce::String) { updateBankParameters (); };
+    initBankPreview ();
+
+    audioFormatManager.registerBasicFormats ();
+    readAheadThread.addTimeSliceClient (this);
+    readAheadThread.startThread ();
+
     audioDeviceManager.addChangeListener (this);
     configureAudioDevice (audioSettingsProperties.getConfig ());
 }
@@ -59,110 +80,190 @@ void AudioPlayer::initFromChannel (int channelIndex)
     channelProperties.onSampleDataAudioBufferChange = [this] (AudioBufferRefCounted::RefCountedPtr)
     {
         LogAudioPlayer ("channelProperties.onSampleDataAudioBufferChange");
-        initSamplePoints ();
         prepareSampleForPlayback ();
+        updateVoiceParameters ();
     };
-    // TODO - can I refactor these callback?
-    channelProperties.onStartCueChange = [this] (uint32_t newSampleStart)
-    {
-        LogAudioPlayer ("channelProperties.onStartCueChange ");
-        jassert (sampleRateRatio > 0.0);
-        const auto actualSampleStart { newSampleStart / 2 };
-        juce::ScopedLock sl (dataCS);
-        if (playMode == AudioPlayerProperties::PlayMode::once)
-        {
-            sampleStart = static_cast<int> (actualSampleStart * sampleRateRatio);
-            sampleLength = static_cast<int> (((channelProperties.getEndCue () / 2) - actualSampleStart) * sampleRateRatio);
-            if (curSampleOffset < sampleStart || curSampleOffset >= sampleStart + sampleLength)
-                curSampleOffset = sampleStart;
-            LogAudioPlayer ("channelProperties.onStartCueChange - sampleStart: " + juce::String (sampleStart) + ", sampleLength: " + juce::String (sampleLength) + ", curSampleOffset: " + juce::String (curSampleOffset));
-        }
-    };
-    channelProperties.onEndCueChange = [this] (uint32_t newSampleEnd)
-    {
-        LogAudioPlayer ("channelProperties.onEndCueChange ");
-        jassert (sampleRateRatio > 0.0);
-        const auto actualSampleEnd { newSampleEnd / 2 };
-        juce::ScopedLock sl (dataCS);
-        if (playMode == AudioPlayerProperties::PlayMode::once)
-            sampleLength = static_cast<int> ((actualSampleEnd - (channelProperties.getStartCue () / 2)) * sampleRateRatio);
-        else
-            sampleLength = static_cast<int> ((actualSampleEnd - (channelProperties.getLoopCue () / 2)) * sampleRateRatio);
-        if (curSampleOffset >= sampleStart + sampleLength)
-            curSampleOffset = sampleStart;
-        LogAudioPlayer ("channelProperties.onEndCueChange - sampleStart: " + juce::String (sampleStart) + ", sampleLength: " + juce::String (sampleLength) + ", curSampleOffset: " + juce::String (curSampleOffset));
-    };
-    channelProperties.onLoopCueChange = [this] (uint32_t newLoopStart)
-    {
-        LogAudioPlayer ("channelProperties.onLoopCueChange ");
-        jassert (sampleRateRatio > 0.0);
-        const auto actualLoopEnd { newLoopStart / 2 };
-        juce::ScopedLock sl (dataCS);
-        if (playMode == AudioPlayerProperties::PlayMode::loop)
-        {
-            sampleStart = static_cast<int> (actualLoopEnd * sampleRateRatio);
-            sampleLength = static_cast<int> (((channelProperties.getEndCue () / 2) - actualLoopEnd) * sampleRateRatio);
-            if (curSampleOffset < sampleStart || curSampleOffset >= sampleStart + sampleLength)
-                curSampleOffset = sampleStart;
-            LogAudioPlayer ("channelProperties.onLoopCueChange  - sampleStart: " + juce::String (sampleStart) + ", sampleLength: " + juce::String (sampleLength) + ", curSampleOffset: " + juce::String (curSampleOffset));
-        }
-    };
+    watchVoiceParameters (channelProperties, [this] () { updateVoiceParameters (); });
 
-    // create local copy of audio data, with resampling if needed
+    // reference the audio data, resampling is done during playback
     prepareSampleForPlayback ();
 
-    // setup local sample start and sample length based on samplePointsSource
-    initSamplePoints ();
+    // setup the voice from the channel settings
+    updateVoiceParameters ();
 }
 
-void AudioPlayer::initSamplePoints ()
+void AudioPlayer::initFromFile (juce::String fileName)
 {
-    LogAudioPlayer ("initSamplePoints");
-    jassert (sampleRateRatio > 0.0);
-    juce::ScopedLock sl (dataCS);
-    if (playMode == AudioPlayerProperties::PlayMode::once)
+    LogAudioPlayer ("initFromFile: " + fileName);
+    const juce::ScopedLock sl (fileStreamLock);
+    // detach the current reader from the transport before releasing it
+    fileTransportSource.stop ();
+    fileTransportSource.setSource (nullptr);
+    fileReaderSource.reset ();
+    ++fileStreamGeneration;
+
+    if (fileName.isEmpty ())
+        return;
+    auto* reader { audioFormatManager.createReaderFor (juce::File (fileName)) };
+    if (reader == nullptr)
     {
-        sampleStart = static_cast<int> ((channelProperties.getStartCue () / 2) * sampleRateRatio);
-        sampleLength = static_cast<int> (((channelProperties.getEndCue () / 2) - (channelProperties.getStartCue () / 2)) * sampleRateRatio);
+        LogAudioPlayer ("initFromFile: unable to create reader");
+        return;
     }
-    else
+    const auto fileSampleRate { reader->sampleRate };
+    fileReaderSource = std::make_unique<juce::AudioFormatReaderSource> (reader, true);
+    // fileFifo is the read ahead buffer, the transport is only read from readAheadThread
+    fileTransportSource.setSource (fileReaderSource.get (), 0, nullptr, fileSampleRate, kNumFileChannels);
+}
+
+void AudioPlayer::initBankPreview ()
+{
+    bankProperties.forEachChannel ([this] (juce::ValueTree channelPropertiesVT, int channelIndex)
+    {
+        auto& curChannelProperties { bankChannelProperties [channelIndex] };
+        curChannelProperties.wrap (channelPropertiesVT, SquidChannelProperties::WrapperType::client, SquidChannelProperties::EnableCallbacks::yes);
+        curChannelProperties.onSampleDataAudioBufferChange = [this, channelIndex] (AudioBufferRefCounted::RefCountedPtr audioBuffer)
+        {
+            setSampleBuffer (channelIndex, audioBuffer);
+            updateBankParameters ();
+        };
+        watchVoiceParameters (curChannelProperties, [this] () { updateBankParameters (); });
+        curChannelProperties.onChannelFlagsChange = [this] (uint16_t) { updateBankParameters (); };
+        curChannelProperties.onChokeChange = [this] (int) { updateBankParameters (); };
+        setSampleBuffer (channelIndex, curChannelProperties.getSampleDataAudioBuffer ());
+        return true;
+    });
+    updateBankParameters ();
+}
+
+// any change to a parameter the voice uses is passed on to the audio thread, so edits are heard while auditioning
+void AudioPlayer::watchVoiceParameters (SquidChannelProperties& properties, std::function<void ()> onChange)
+{
+    properties.onAttackChange = [onChange] (int) { onChange (); };
+    properties.onBitsChange = [onChange] (int) { onChange (); };
+    properties.onDecayChange = [onChange] (int) { onChange (); };
+    properties.onEndCueChange = [onChange] (uint32_t) { onChange (); };
+    properties.onFilterFrequencyChange = [onChange] (int) { onChange (); };
+    properties.onFilterResonanceChange = [onChange] (int) { onChange (); };
+    properties.onFilterTypeChange = [onChange] (int) { onChange (); };
+    properties.onLevelChange = [onChange] (int) { onChange (); };
+    properties.onLoopCueChange = [onChange] (uint32_t) { onChange (); };
+    properties.onLoopModeChange = [onChange] (int) { onChange (); };
+    properties.onPitchShiftChange = [onChange] (int) { onChange (); };
+    properties.onRateChange = [onChange] (int) { onChange (); };
+    properties.onReverseChange = [onChange] (int) { onChange (); };
+    properties.onSpeedChange = [onChange] (int) { onChange (); };
+    properties.onStartCueChange = [onChange] (uint32_t) { onChange (); };
+}
+
+void AudioPlayer::updateVoiceParameters ()
+{
+    LogAudioPlayer ("updateVoiceParameters");
+    auto& voiceParameters { playbackParameters.voiceParameters };
+    voiceParameters = SquidVoice::getParameters (channelProperties);
+    if (playbackParameters.playMode == AudioPlayerProperties::PlayMode::loop)
+    {
+        // loop play skips the start section and always loops, honoring a zigZag setting
+        voiceParameters.startCue = voiceParameters.loopCue;
+        if (static_cast<LoopType> (voiceParameters.loopMode) == LoopType::none)
+            voiceParameters.loopMode = static_cast<int> (LoopType::normal);
+    }
+    LogAudioPlayer ("AudioPlayer::updateVoiceParameters - startCue: " + juce::String (voiceParameters.startCue) + ", loopCue: " + juce::String (voiceParameters.loopCue) +
+                    ", endCue: " + juce::String (voiceParameters.endCue));
+    publishPlaybackParameters ();
+}
+
+void AudioPlayer::updateBankParameters ()
+{
+    LogAudioPlayer ("updateBankParameters");
+    auto anySoloed { false };
+    for (auto& curChannelProperties : bankChannelProperties)
+        anySoloed = anySoloed || (curChannelProperties.getChannelFlags () & ChannelFlags::kSolo) != 0;
+
+    for (auto channelIndex { 0 }; channelIndex < kNumChannels; ++channelIndex)
     {
-        sampleStart = static_cast<int> ((channelProperties.getLoopCue () / 2) * sampleRateRatio);
-        sampleLength = static_cast<int> (((channelProperties.getEndCue () / 2) - (channelProperties.getLoopCue () / 2)) * sampleRateRatio);
+        auto& curChannelProperties { bankChannelProperties [channelIndex] };
+        auto& channelParameters { bankParameters.channelParameters [channelIndex] };
+        const auto channelFlags { curChannelProperties.getChannelFlags () };
+        channelParameters.voiceParameters = SquidVoice::getParameters (curChannelProperties);
+        if (curChannelProperties.getSampleDataSampleRate () > 0.0)
+            channelParameters.sourceSampleRate = curChannelProperties.getSampleDataSampleRate ();
+        // the choke list uses the channel's own index for off
+        const auto chokeChannel { curChannelProperties.getChoke () };
+        channelParameters.chokeChannel = (chokeChannel >= 0 && chokeChannel < kNumChannels && chokeChannel != channelIndex) ? chokeChannel : -1;
+        // the neighbor output flag swaps 1+2 with 3+4, and 5+6 with 7+8
+        channelParameters.outputIndex = (channelIndex / 2) ^ ((channelFlags & ChannelFlags::kNeighborOutput) != 0 ? 1 : 0);
+        channelParameters.isAudible = (channelFlags & ChannelFlags::kMute) == 0 && (! anySoloed || (channelFlags & ChannelFlags::kSolo) != 0);
     }
 
-    if (curSampleOffset < sampleStart || curSampleOffset >= sampleStart + sampleLength)
-        curSampleOffset = sampleStart;
-    LogAudioPlayer ("AudioPlayer::initSamplePoints - sampleStart: " + juce::String (sampleStart) + ", sampleLength: " + juce::String (sampleLength) + ", curSampleOffset: " + juce::String (curSampleOffset));
+    bankParameters.tempo = juce::jlimit (20, 300, audioPlayerProperties.getBankTempo ());
+    bankParameters.pattern.fill (0);
+    auto patternSteps { juce::StringArray::fromTokens (audioPlayerProperties.getBankPattern (), ",", "") };
+    for (auto stepIndex { 0 }; stepIndex < juce::jmin (kNumBankSteps, patternSteps.size ()); ++stepIndex)
+        bankParameters.pattern [stepIndex] = static_cast<uint8_t> (patternSteps [stepIndex].trim ().getIntValue () & 0xFF);
+
+    bankParametersSnapshot.store (bankParameters);
 }
 
 void AudioPlayer::prepareSampleForPlayback ()
 {
-    jassert (playState == AudioPlayerProperties::PlayState::stop);
+    AudioBufferRefCounted::RefCountedPtr newSampleBuffer;
     if (channelProperties.isValid () && channelProperties.getSampleDataAudioBuffer () != nullptr)
     {
         LogAudioPlayer ("prepareSampleForPlayback: sample is ready");
-        std::unique_ptr <juce::MemoryAudioSource> readerSource { std::make_unique<juce::MemoryAudioSource> (*channelProperties.getSampleDataAudioBuffer ()->getAudioBuffer (), false, false) };
-        std::unique_ptr<MonoToStereoAudioSource> monoToStereoAudioSource { std::make_unique<MonoToStereoAudioSource> (readerSource.get (), false) };
-        std::unique_ptr<juce::ResamplingAudioSource> resamplingAudioSource { std::make_unique<juce::ResamplingAudioSource> (monoToStereoAudioSource.get (), false, 2) };
-        sampleRateRatio = sampleRate / channelProperties.getSampleDataSampleRate ();
-        resamplingAudioSource->setResamplingRatio (channelProperties.getSampleDataSampleRate () / sampleRate);
-        resamplingAudioSource->prepareToPlay (blockSize, sampleRate);
-        sampleBuffer = std::make_unique<juce::AudioBuffer<float>> (2, static_cast<int> (channelProperties.getSampleDataNumSamples () * sampleRate / channelProperties.getSampleDataSampleRate ()));
-        resamplingAudioSource->getNextAudioBlock (juce::AudioSourceChannelInfo (*sampleBuffer.get ()));
-        curSampleOffset = 0;
+        newSampleBuffer = channelProperties.getSampleDataAudioBuffer ();
+        if (channelProperties.getSampleDataSampleRate () > 0.0)
+            playbackParameters.sourceSampleRate = channelProperties.getSampleDataSampleRate ();
     }
     else
     {
         LogAudioPlayer ("prepareSampleForPlayback: sample is NOT ready");
     }
+    setSampleBuffer (kAuditionSlot, newSampleBuffer);
+    publishPlaybackParameters ();
+}
+
+void AudioPlayer::setSampleBuffer (int slotIndex, AudioBufferRefCounted::RefCountedPtr newSampleBuffer)
+{
+    auto& sampleBufferSlot { sampleBufferSlots [slotIndex] };
+    if (newSampleBuffer != sampleBufferSlot.sampleBuffer)
+    {
+        // the audio callback may still be reading the old buffer, so hold on to it until it is done
+        if (sampleBufferSlot.sampleBuffer != nullptr)
+            retiredSampleBuffers.push_back (sampleBufferSlot.sampleBuffer);
+        sampleBufferSlot.sampleBuffer = newSampleBuffer;
+        sampleBufferSlot.activeSampleBuffer.store (newSampleBuffer.get ());
+    }
+    releaseRetiredSampleBuffers ();
+}
+
+void AudioPlayer::publishPlaybackParameters ()
+{
+    playbackParametersSnapshot.store (playbackParameters);
+}
+
+void AudioPlayer::releaseRetiredSampleBuffers ()
+{
+    retiredSampleBuffers.erase (std::remove_if (retiredSampleBuffers.begin (), retiredSampleBuffers.end (),
+                                                [this] (const AudioBufferRefCounted::RefCountedPtr& retiredSampleBuffer)
+                                                {
+                                                    return std::none_of (sampleBufferSlots.begin (), sampleBufferSlots.end (), [&retiredSampleBuffer] (const SampleBufferSlot& sampleBufferSlot)
+                                                    {
+                                                        return sampleBufferSlot.sampleBufferInUse.load () == retiredSampleBuffer.get ();
+                                                    });
+                                                }), retiredSampleBuffers.end ());
 }
 
 void AudioPlayer::shutdownAudio ()
 {
+    cancelPendingUpdate ();
     audioSourcePlayer.setSource (nullptr);
     audioDeviceManager.removeAudioCallback (&audioSourcePlayer);
     audioDeviceManager.closeAudioDevice ();
+    readAheadThread.removeTimeSliceClient (this);
+    readAheadThread.stopThread (1000);
+    fileTransportSource.setSource (nullptr);
+    fileReaderSource.reset ();
 }
 
 void AudioPlayer::configureAudioDevice (juce::String config)
@@ -189,24 +290,36 @@ void AudioPlayer::configureAudioDevice (juce::String config)
 
 void AudioPlayer::handlePlayMode (AudioPlayerProperties::PlayMode newPlayMode)
 {
-    juce::ScopedLock sl (dataCS);
-    playMode = newPlayMode;
-    initSamplePoints ();
+    playbackParameters.playMode = newPlayMode;
+    updateVoiceParameters ();
 }
 
 void AudioPlayer::handlePlayState (AudioPlayerProperties::PlayState newPlayState)
 {
-    juce::ScopedLock sl (dataCS);
     if (newPlayState == AudioPlayerProperties::PlayState::stop)
     {
         LogAudioPlayer ("AudioPlayer::handlePlayState: stop");
+        playState.store (makePlayState (playbackParameters.restartCount, false));
+        {
+            const juce::ScopedLock sl (fileStreamLock);
+            fileTransportSource.stop ();
+        }
+        releaseRetiredSampleBuffers ();
     }
     else if (newPlayState == AudioPlayerProperties::PlayState::play)
     {
         LogAudioPlayer ("AudioPlayer::handlePlayState: play");
-        curSampleOffset = sampleStart;
+        ++playbackParameters.restartCount;
+        publishPlaybackParameters ();
+        if (playbackParameters.playMode == AudioPlayerProperties::PlayMode::file)
+        {
+            const juce::ScopedLock sl (fileStreamLock);
+            fileTransportSource.setPosition (0.0);
+            fileTransportSource.start ();
+            ++fileStreamGeneration;
+        }
+        playState.store (makePlayState (playbackParameters.restartCount, true));
     }
-    playState = newPlayState;
 }
 
 void AudioPlayer::showConfigDialog ()
@@ -223,13 +336,22 @@ void AudioPlayer::showConfigDialog ()
 void AudioPlayer::prepareToPlay (int samplesPerBlockExpected, double newSampleRate)
 {
     LogAudioPlayer ("prepareToPlay");
-    sampleRate = newSampleRate;
+    sampleRate.store (newSampleRate);
     blockSize = samplesPerBlockExpected;
-    prepareSampleForPlayback ();
+    squidVoice.prepare (newSampleRate, samplesPerBlockExpected);
+    for (auto& bankVoice : bankVoices)
+        bankVoice.prepare (newSampleRate, samplesPerBlockExpected);
+    voiceBuffer.setSize (1, juce::jmax (samplesPerBlockExpected, 128));
+    const juce::ScopedLock sl (fileStreamLock);
+    fileTransportSource.prepareToPlay (kFileStreamBlockSize, newSampleRate);
+    // anything already streamed is at the old rate
+    ++fileStreamGeneration;
 }
 
 void AudioPlayer::releaseResources ()
 {
+    const juce::ScopedLock sl (fileStreamLock);
+    fileTransportSource.releaseResources ();
 }
 
 void AudioPlayer::changeListenerCallback (juce::ChangeBroadcaster*)
@@ -243,83 +365,274 @@ void AudioPlayer::changeListenerCallback (juce::ChangeBroadcaster*)
     }
 }
 
+void AudioPlayer::handleAsyncUpdate ()
+{
+    // the audio callback reached the end of a one shot. only report it if play has not been pressed again since
+    if (playState.load () == makePlayState (playbackParameters.restartCount, false) &&
+        audioPlayerProperties.getPlayState () == AudioPlayerProperties::PlayState::play && playbackParameters.playMode != AudioPlayerProperties::PlayMode::bank)
+        audioPlayerProperties.setPlayState (AudioPlayerProperties::PlayState::stop, true);
+    releaseRetiredSampleBuffers ();
+}
+
+AudioBufferRefCounted* AudioPlayer::acquireSampleBuffer (int slotIndex) noexcept
+{
+    // publish the buffer we are about to use, then make sure it was not swapped out in between, otherwise the message thread may have already released it
+    auto& sampleBufferSlot { sampleBufferSlots [slotIndex] };
+    auto* sampleBuffer { sampleBufferSlot.activeSampleBuffer.load () };
+    for (;;)
+    {
+        sampleBufferSlot.sampleBufferInUse.store (sampleBuffer);
+        auto* latestSampleBuffer { sampleBufferSlot.activeSampleBuffer.load () };
+        if (latestSampleBuffer == sampleBuffer)
+            return sampleBuffer;
+        sampleBuffer = latestSampleBuffer;
+    }
+}
+
+void AudioPlayer::releaseSampleBuffer (int slotIndex) noexcept
+{
+    sampleBufferSlots [slotIndex].sampleBufferInUse.store (nullptr);
+}
+
+void AudioPlayer::finishPlayback (uint32_t restartCount) noexcept
+{
+    // the parameters snapshot may be stale, only stop if play has not been pressed again since it was taken
+    auto expectedPlayState { makePlayState (restartCount, true) };
+    if (playState.compare_exchange_strong (expectedPlayState, makePlayState (restartCount, false)))
+        triggerAsyncUpdate (); // let the message thread update the play state
+}
+
 void AudioPlayer::getNextAudioBlock (const juce::AudioSourceChannelInfo& bufferToFill)
 {
+    TRACE_SPAN ("AudioPlayer::getNextAudioBlock");
     bufferToFill.clearActiveBufferRegion ();
     // fill buffer with data
 
-    if (playState == AudioPlayerProperties::PlayState::stop)
+    if ((playState.load () & 1) == 0 || bufferToFill.buffer->getNumChannels () == 0)
+        return;
+
+    // NOTE: nothing in here blocks. the parameters come from SeqLock snapshots, and the sample buffers are claimed through acquireSampleBuffer
+    const auto callbackStartTicks { juce::Time::getHighResolutionTicks () };
+    const auto parameters { playbackParametersSnapshot.load () };
+    const auto restart { parameters.restartCount != lastRestartCount };
+    lastRestartCount = parameters.restartCount;
+    if (parameters.playMode == AudioPlayerProperties::PlayMode::bank)
+    {
+        renderBank (bufferToFill, restart);
+    }
+    else if (parameters.playMode == AudioPlayerProperties::PlayMode::file)
+    {
+        renderFile (bufferToFill, parameters);
+    }
+    else
+    {
+        if (restart)
+            squidVoice.trigger (parameters.sourceSampleRate);
+        renderChannel (bufferToFill, parameters);
+    }
+    recordCallbackMetrics (callbackStartTicks, bufferToFill.numSamples);
+}
+
+void AudioPlayer::recordCallbackMetrics (juce::int64 callbackStartTicks, int numSamples) noexcept
+{
+    // the load is the time spent rendering, as a percentage of the time the block takes to play. over 100% the device runs out of audio (a dropout)
+    const auto callbackTime { Metrics::getElapsedMicroseconds (callbackStartTicks) };
+    const auto blockTime { static_cast<double> (numSamples) * 1000000.0 / sampleRate.load () };
+    audioCallbackCount.add ();
+    audioCallbackTime.record (callbackTime);
+    if (blockTime <= 0.0)
         return;
+    audioCallbackLoad.record (static_cast<uint64_t> (static_cast<double> (callbackTime) * 100.0 / blockTime));
+    if (static_cast<double> (callbackTime) > blockTime)
+        audioOverruns.add ();
+}
+
+// reads what readAheadThread has streamed into fileFifo, without locking. if the stream falls behind the rest of the block is left silent
+void AudioPlayer::renderFile (const juce::AudioSourceChannelInfo& bufferToFill, const PlaybackParameters& parameters) noexcept
+{
+    const auto generation { fileStreamGeneration.load () };
+    if (generation != fileStreamGenerationRead.load ())
+    {
+        // the stream was restarted, drop what is left of the previous one. nothing new is written until this is acknowledged
+        fileFifo.finishedRead (fileFifo.getNumReady ());
+        fileStreamGenerationRead.store (generation);
+    }
+
+    // the end is checked before the samples are counted, so the last samples written are included
+    const auto streamEnded { fileStreamEndGeneration.load () == generation };
+    const auto numReady { fileFifo.getNumReady () };
+    const auto numSamples { juce::jmin (bufferToFill.numSamples, numReady) };
+    int start1, size1, start2, size2;
+    fileFifo.prepareToRead (numSamples, start1, size1, start2, size2);
+    const auto numChannels { juce::jmin (bufferToFill.buffer->getNumChannels (), kNumFileChannels) };
+    for (auto channel { 0 }; channel < numChannels; ++channel)
+    {
+        bufferToFill.buffer->copyFrom (channel, bufferToFill.startSample, fileFifoBuffer, channel, start1, size1);
+        if (size2 > 0)
+            bufferToFill.buffer->copyFrom (channel, bufferToFill.startSample + size1, fileFifoBuffer, channel, start2, size2);
+    }
+    fileFifo.finishedRead (size1 + size2);
+
+    if (streamEnded && numReady <= bufferToFill.numSamples)
+    {
+        LogAudioPlayer ("AudioPlayer::renderFile - file finished");
+        finishPlayback (parameters.restartCount);
+    }
+}
+
+// runs on readAheadThread, keeping fileFifo topped up from the transport source
+int AudioPlayer::useTimeSlice ()
+{
+    const juce::ScopedLock sl (fileStreamLock);
+    const auto generation { fileStreamGeneration.load () };
+    if (generation != fileStreamGenerationRead.load () || generation == fileStreamEndGeneration.load ())
+        return 10;
+
+    auto numSamplesWritten { 0 };
+    while (fileFifo.getFreeSpace () >= kFileStreamBlockSize)
+    {
+        // the transport stops on its own at the end of the file, and when the file could not be opened
+        if (! fileTransportSource.isPlaying ())
+        {
+            fileStreamEndGeneration.store (generation);
+            break;
+        }
+        fileTransportSource.getNextAudioBlock (juce::AudioSourceChannelInfo (fileStreamBuffer));
+        int start1, size1, start2, size2;
+        fileFifo.prepareToWrite (kFileStreamBlockSize, start1, size1, start2, size2);
+        for (auto channel { 0 }; channel < kNumFileChannels; ++channel)
+        {
+            fileFifoBuffer.copyFrom (channel, start1, fileStreamBuffer, channel, 0, size1);
+            if (size2 > 0)
+                fileFifoBuffer.copyFrom (channel, start2, fileStreamBuffer, channel, size1, size2);
+        }
+        fileFifo.finishedWrite (size1 + size2);
+        numSamplesWritten += size1 + size2;
+    }
+    return numSamplesWritten > 0 ? 1 : 10;
+}
 
+void AudioPlayer::renderChannel (const juce::AudioSourceChannelInfo& bufferToFill, const PlaybackParameters& parameters) noexcept
+{
+    auto& outputBuffer { *bufferToFill.buffer };
     const auto numOutputSamples { bufferToFill.numSamples };
+    auto* sampleBuffer { acquireSampleBuffer (kAuditionSlot) };
+    if (sampleBuffer == nullptr)
+    {
+        // nothing to play, so it is finished, rather than playing silence until stop is pressed
+        releaseSampleBuffer (kAuditionSlot);
+        finishPlayback (parameters.restartCount);
+        return;
+    }
+
+    // render the mono voice into the first output channel
+    squidVoice.setParameters (parameters.voiceParameters);
+    const auto& sourceBuffer { *sampleBuffer->getAudioBuffer () };
+    auto* outputData { outputBuffer.getWritePointer (0, bufferToFill.startSample) };
+    const auto voiceActive { squidVoice.render (sourceBuffer.getReadPointer (0), sourceBuffer.getNumSamples (), outputData, numOutputSamples) };
+    releaseSampleBuffer (kAuditionSlot);
+    if (! voiceActive)
+    {
+        LogAudioPlayer ("AudioPlayer::renderChannel - voice finished");
+        finishPlayback (parameters.restartCount);
+    }
+
+    // the source is mono, so duplicate it into any other channels
+    for (auto ch { 1 }; ch < outputBuffer.getNumChannels (); ++ch)
+        outputBuffer.copyFrom (ch, bufferToFill.startSample, outputBuffer, 0, bufferToFill.startSample, numOutputSamples);
+}
+
+// mixes the 8 channels of the edit bank, triggered from the step pattern. the four module outputs are spread across the stereo field
+void AudioPlayer::renderBank (const juce::AudioSourceChannelInfo& bufferToFill, bool restart) noexcept
+{
+    static const auto kOutputGains { [] ()
+    {
+        std::array<std::pair<float, float>, kNumOutputs> outputGains;
+        for (auto outputIndex { 0 }; outputIndex < kNumOutputs; ++outputIndex)
+        {
+            const auto panAngle { (outputIndex + 0.5f) / kNumOutputs * juce::MathConstants<float>::halfPi };
+            outputGains [outputIndex] = { std::cos (panAngle), std::sin (panAngle) };
+        }
+        return outputGains;
+    } () };
+
+    if (voiceBuffer.getNumSamples () == 0)
+        return;
+
     auto& outputBuffer { *bufferToFill.buffer };
-    const auto channels { juce::jmin (outputBuffer.getNumChannels (), sampleBuffer->getNumChannels ()) };
-
-    auto originalSampleOffset { 0 };
-    auto cachedSampleLength { 0 };
-    auto cachedSampleStart { 0 };
-    auto cachedLocalSampleOffset { 0 };
-    auto chachedPlayMode { AudioPlayerProperties::PlayMode::once };
-    {
-        // NOTE: I am using a lock in the audio callback ONLY BECAUSE the audio play back is a simple audition feature, not recording or performance playback
-        juce::ScopedLock sl (dataCS);
-        jassert (curSampleOffset >= sampleStart);
-        jassert (curSampleOffset < sampleStart + sampleLength);
-        originalSampleOffset =  curSampleOffset; // should be >= sampleStart and < sampleStart + sampleLength
-        cachedSampleLength = sampleLength;
-        cachedSampleStart = sampleStart;
-        chachedPlayMode = playMode;
-        cachedLocalSampleOffset = curSampleOffset - sampleStart;
-        LogAudioPlayer ("AudioPlayer::getNextAudioBlock - cachedSampleStart: " + juce::String (cachedSampleStart) + ", chachedSampleLength: " + juce::String (cachedSampleLength) +
-                        ", curSampleOffset: " + juce::String (curSampleOffset) + ", cachedLocalSampleOffset: " + juce::String (cachedLocalSampleOffset));
+    const auto numOutputSamples { bufferToFill.numSamples };
+    const auto parameters { bankParametersSnapshot.load () };
+    const auto samplesPerStep { juce::jmax (1.0, sampleRate.load () * 60.0 / parameters.tempo / 4.0) }; // 16th notes
+    if (restart)
+    {
+        for (auto& bankVoice : bankVoices)
+            bankVoice.stop ();
+        bankStepIndex = 0;
+        bankSamplesUntilNextStep = 0.0;
     }
-    auto numSamplesToCopy { 0 };
-    auto outputBufferWritePos { 0 };
-    while (cachedSampleLength > 0 && outputBufferWritePos < numOutputSamples)
-    {
-        numSamplesToCopy = juce::jmin (numOutputSamples - outputBufferWritePos, cachedSampleLength - cachedLocalSampleOffset);
-        LogAudioPlayer ("AudioPlayer::getNextAudioBlock - numSamplesToCopy: " + juce::String (numSamplesToCopy));
-        jassert (numSamplesToCopy >= 0);
-
-        // copy data from sample buffer to output buffer, this may, or may not, fill the entire output buffer
-        auto ch { 0 };
-        for (; ch < channels; ++ch)
-            outputBuffer.copyFrom (ch, bufferToFill.startSample + outputBufferWritePos, *sampleBuffer, ch, cachedSampleStart + cachedLocalSampleOffset, numSamplesToCopy);
-
-        // clear any unused channels
-        for (; ch < outputBuffer.getNumChannels (); ++ch)
-            outputBuffer.clear (ch, bufferToFill.startSample + outputBufferWritePos, numSamplesToCopy);
-
-        outputBufferWritePos += numSamplesToCopy;
-        cachedLocalSampleOffset += numSamplesToCopy;
-        if (chachedPlayMode == AudioPlayerProperties::PlayMode::loop)
+
+    for (auto channelIndex { 0 }; channelIndex < kNumChannels; ++channelIndex)
+        bankSampleBuffers [channelIndex] = acquireSampleBuffer (channelIndex);
+
+    const auto rightChannel { outputBuffer.getNumChannels () > 1 ? 1 : 0 };
+    auto outputOffset { 0 };
+    while (outputOffset < numOutputSamples)
+    {
+        if (bankSamplesUntilNextStep <= 0.0)
         {
-            if (cachedLocalSampleOffset >= cachedSampleLength)
-                cachedLocalSampleOffset = 0;
+            triggerBankStep (parameters);
+            bankStepIndex = (bankStepIndex + 1) % kNumBankSteps;
+            bankSamplesUntilNextStep += samplesPerStep;
         }
-        else
+        const auto numSamplesToRender { juce::jmin (numOutputSamples - outputOffset, voiceBuffer.getNumSamples (), static_cast<int> (std::ceil (bankSamplesUntilNextStep))) };
+        for (auto channelIndex { 0 }; channelIndex < kNumChannels; ++channelIndex)
         {
-            LogAudioPlayer ("AudioPlayer::getNextAudioBlock - outputBufferWritePos : " + juce::String (outputBufferWritePos) + ", numOutputSamples: " + juce::String (numOutputSamples));
-            if (outputBufferWritePos < numOutputSamples)
+            auto& bankVoice { bankVoices [channelIndex] };
+            const auto& channelParameters { parameters.channelParameters [channelIndex] };
+            auto* sampleBuffer { bankSampleBuffers [channelIndex] };
+            if (! bankVoice.isActive ())
+                continue;
+            if (! channelParameters.isAudible || sampleBuffer == nullptr)
             {
-                outputBuffer.clear (bufferToFill.startSample + outputBufferWritePos, numOutputSamples - outputBufferWritePos);
-                audioPlayerProperties.setPlayState (AudioPlayerProperties::PlayState::stop, true);
-                break;
+                bankVoice.stop ();
+                continue;
             }
+
+            voiceBuffer.clear (0, 0, numSamplesToRender);
+            bankVoice.setParameters (channelParameters.voiceParameters);
+            const auto& sourceBuffer { *sampleBuffer->getAudioBuffer () };
+            bankVoice.render (sourceBuffer.getReadPointer (0), sourceBuffer.getNumSamples (), voiceBuffer.getWritePointer (0), numSamplesToRender);
+            const auto [leftGain, rightGain] { kOutputGains [channelParameters.outputIndex] };
+            outputBuffer.addFrom (0, bufferToFill.startSample + outputOffset, voiceBuffer, 0, 0, numSamplesToRender, leftGain);
+            outputBuffer.addFrom (rightChannel, bufferToFill.startSample + outputOffset, voiceBuffer, 0, 0, numSamplesToRender, rightGain);
         }
+        outputOffset += numSamplesToRender;
+        bankSamplesUntilNextStep -= numSamplesToRender;
+    }
+
+    for (auto channelIndex { 0 }; channelIndex < kNumChannels; ++channelIndex)
+    {
+        bankSampleBuffers [channelIndex] = nullptr;
+        releaseSampleBuffer (channelIndex);
     }
+}
+
+void AudioPlayer::triggerBankStep (const BankParameters& parameters) noexcept
+{
+    // the gate of a channel is held for each step it is triggered on, so a channel in a gate loop mode plays until the next step without it
+    const auto stepChannels { parameters.pattern [bankStepIndex] };
+    for (auto channelIndex { 0 }; channelIndex < kNumChannels; ++channelIndex)
     {
-        // NOTE: I am using a lock in the audio callback ONLY BECAUSE the audio play back is a simple audition feature, not recording or performance playback
-        juce::ScopedLock sl (dataCS);
-        if (originalSampleOffset == curSampleOffset && cachedSampleStart == sampleStart && cachedSampleLength == sampleLength) // if the offset has not changed externally
-        {
-            curSampleOffset = cachedSampleStart + cachedLocalSampleOffset;
-            LogAudioPlayer ("AudioPlayer::getNextAudioBlock setting new curSampleOffset: " + juce::String (curSampleOffset) + ", cachedSampleStart: " + juce::String (cachedSampleStart) + ", chachedSampleLength: " + juce::String (cachedSampleLength) +
-                            ", cachedLocalSampleOffset: " + juce::String (cachedLocalSampleOffset));
-        }
-        else
+        const auto& channelParameters { parameters.channelParameters [channelIndex] };
+        if ((stepChannels & (1 << channelIndex)) == 0 || ! channelParameters.isAudible || bankSampleBuffers [channelIndex] == nullptr)
         {
-            LogAudioPlayer ("AudioPlayer::getNextAudioBlock - curSampleOffset: " + juce::String (cachedSampleStart) + " != originalSampleOffset: " + juce::String (originalSampleOffset));
+            bankVoices [channelIndex].release ();
+            continue;
         }
+
+        if (channelParameters.chokeChannel != -1)
+            bankVoices [channelParameters.chokeChannel].stop ();
+        bankVoices [channelIndex].setParameters (channelParameters.voiceParameters);
+        bankVoices [channelIndex].trigger (channelParameters.sourceSampleRate);
     }
 }
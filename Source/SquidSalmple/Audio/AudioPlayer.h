@@ -3,12 +3,16 @@
 #include <JuceHeader.h>
 #include "AudioPlayerProperties.h"
 #include "AudioSettingsProperties.h"
+#include "SquidVoice.h"
 #include "../SquidBankProperties.h"
 #include "../SquidChannelProperties.h"
 #include "../../AppProperties.h"
+#include "../../Utility/SeqLock.h"
 
 class AudioPlayer : public juce::AudioSource,
-                    public juce::ChangeListener
+                    public juce::ChangeListener,
+                    private juce::AsyncUpdater,
+                    private juce::TimeSliceClient
 {
 public:
 
@@ -16,60 +20,127 @@ public:
     void shutdownAudio ();
 
 private:
+    static constexpr int kNumChannels { 8 };
+    static constexpr int kNumOutputs { 4 }; // the module has an output for each pair of channels, 1+2, 3+4, 5+6, 7+8
+    static constexpr int kNumBankSteps { 16 };
+    static constexpr int kAuditionSlot { kNumChannels }; // sample buffer slot used for single channel audition, the bank preview uses 0-7
+    static constexpr int kFileReadAheadSize { 32768 }; // samples buffered ahead of playback when streaming a file from disk
+    static constexpr int kFileStreamBlockSize { 1024 }; // samples read from the file at a time
+    static constexpr int kNumFileChannels { 2 };
+
     AudioSettingsProperties audioSettingsProperties;
     AudioPlayerProperties audioPlayerProperties;
     AppProperties appProperties;
     SquidBankProperties bankProperties;
     SquidChannelProperties channelProperties;
+    std::array<SquidChannelProperties, kNumChannels> bankChannelProperties;
     juce::AudioDeviceManager audioDeviceManager;
     juce::AudioSourcePlayer audioSourcePlayer;
-    std::unique_ptr <juce::AudioBuffer<float>> sampleBuffer;
     juce::AudioDeviceSelectorComponent audioSetupComp { audioDeviceManager, 0, 0, 0, 256, false, false, true, false };
 
-    juce::CriticalSection dataCS;
-    AudioPlayerProperties::PlayState playState { AudioPlayerProperties::PlayState::stop };
-    AudioPlayerProperties::PlayMode playMode { AudioPlayerProperties::PlayMode::once };
-    int curSampleOffset { 0 };
-    int sampleStart { 0 };
-    int sampleLength { 0 };
+    // file preview streams from disk on readAheadThread. useTimeSlice pulls from the transport source, which reads the file and resamples it to the
+    // device rate, and writes into fileFifo, which the audio callback reads without locking. fileStreamLock is only taken by the message thread and
+    // readAheadThread. each start of the stream begins a new generation, the audio callback drops what is left of the previous one and acknowledges
+    // the new one (fileStreamGenerationRead) before anything new is written
+    juce::AudioFormatManager audioFormatManager;
+    juce::TimeSliceThread readAheadThread { "AudioPlayerReadAhead" };
+    juce::AudioTransportSource fileTransportSource;
+    std::unique_ptr<juce::AudioFormatReaderSource> fileReaderSource;
+    juce::CriticalSection fileStreamLock;
+    juce::AbstractFifo fileFifo { kFileReadAheadSize };
+    juce::AudioBuffer<float> fileFifoBuffer { kNumFileChannels, kFileReadAheadSize };
+    juce::AudioBuffer<float> fileStreamBuffer { kNumFileChannels, kFileStreamBlockSize }; // only touched on readAheadThread
+    std::atomic<uint32_t> fileStreamGeneration { 0 };
+    std::atomic<uint32_t> fileStreamGenerationRead { 0 };
+    std::atomic<uint32_t> fileStreamEndGeneration { 0 }; // the generation that has been streamed to the end of the file
 
-    double sampleRate { 44100.0 };
-    int blockSize { 128 };
-    double sampleRateRatio { 0.0 };
+    // everything the audio callback needs to know to render the voice, published from the message thread through a SeqLock
+    struct PlaybackParameters
+    {
+        SquidVoice::Parameters voiceParameters;
+        double sourceSampleRate { 44100.0 };
+        AudioPlayerProperties::PlayMode playMode { AudioPlayerProperties::PlayMode::once };
+        uint32_t restartCount { 0 }; // incremented to make the audio callback retrigger the voice
+    };
 
-    class MonoToStereoAudioSource : public juce::AudioSource
+    // the bank preview settings, published separately so single channel audition does not copy them every block
+    struct BankChannelParameters
     {
-    public:
-        MonoToStereoAudioSource (AudioSource* inputSource, const bool deleteInputWhenDeleted)
-            : input { inputSource, deleteInputWhenDeleted }
-        {
-            jassert (input != nullptr);
-        }
+        SquidVoice::Parameters voiceParameters;
+        double sourceSampleRate { 44100.0 };
+        int chokeChannel { -1 }; // channel to stop when this one is triggered, -1 for none
+        int outputIndex { 0 };
+        bool isAudible { true }; // false when muted, or when another channel is soloed
+    };
+    struct BankParameters
+    {
+        std::array<BankChannelParameters, kNumChannels> channelParameters;
+        std::array<uint8_t, kNumBankSteps> pattern {}; // bit mask of the channels to trigger on each step
+        int tempo { 120 };
+    };
 
-        void prepareToPlay (int, double) {}
-        void releaseResources () {}
-        void getNextAudioBlock (const juce::AudioSourceChannelInfo& bufferToFill)
-        {
-            jassert (bufferToFill.buffer->getNumChannels () == 2);
-            // use getNextAudioBlock to fill in the first channel
-            input->getNextAudioBlock (bufferToFill);
-            // and copy it to the second channel
-            bufferToFill.buffer->copyFrom (1, bufferToFill.startSample, bufferToFill.buffer->getReadPointer (0, bufferToFill.startSample), bufferToFill.numSamples);
-        }
-    private:
-        juce::OptionalScopedPointer<AudioSource> input;
+    // sample buffers are swapped by the message thread, and claimed by the audio callback through sampleBufferInUse. the message thread checks that
+    // before releasing a buffer it has swapped out
+    struct SampleBufferSlot
+    {
+        AudioBufferRefCounted::RefCountedPtr sampleBuffer; // only touched on the message thread
+        std::atomic<AudioBufferRefCounted*> activeSampleBuffer { nullptr };
+        std::atomic<AudioBufferRefCounted*> sampleBufferInUse { nullptr };
     };
 
+    // message thread state
+    std::array<SampleBufferSlot, kNumChannels + 1> sampleBufferSlots;
+    std::vector<AudioBufferRefCounted::RefCountedPtr> retiredSampleBuffers; // kept alive until the audio callback is done with them
+    PlaybackParameters playbackParameters;
+    BankParameters bankParameters;
+
+    // shared state
+    SeqLock<PlaybackParameters> playbackParametersSnapshot;
+    SeqLock<BankParameters> bankParametersSnapshot;
+    // the restart count and the playing flag are kept in one word, so the audio callback can only clear the flag for the restart it was playing.
+    // a play pressed in between changes the restart count, and the audio callback's compare and swap fails
+    std::atomic<uint64_t> playState { 0 };
+    std::atomic<double> sampleRate { 44100.0 };
+
+    // audio thread state
+    SquidVoice squidVoice;
+    std::array<SquidVoice, kNumChannels> bankVoices;
+    std::array<AudioBufferRefCounted*, kNumChannels> bankSampleBuffers {};
+    juce::AudioBuffer<float> voiceBuffer; // mono scratch for mixing the bank voices, sized in prepareToPlay
+    uint32_t lastRestartCount { 0 };
+    int bankStepIndex { 0 };
+    double bankSamplesUntilNextStep { 0.0 };
+    int blockSize { 128 };
+
     void configureAudioDevice (juce::String deviceName);
     void handlePlayMode (AudioPlayerProperties::PlayMode newPlayMode);
     void handlePlayState (AudioPlayerProperties::PlayState playState);
+    void initBankPreview ();
     void initFromChannel (int channelIndex);
-    void initSamplePoints ();
+    void initFromFile (juce::String fileName);
+    void updateBankParameters ();
+    void updateVoiceParameters ();
     void prepareSampleForPlayback ();
+    void publishPlaybackParameters ();
+    void releaseRetiredSampleBuffers ();
+    void setSampleBuffer (int slotIndex, AudioBufferRefCounted::RefCountedPtr newSampleBuffer);
     void showConfigDialog ();
+    void watchVoiceParameters (SquidChannelProperties& properties, std::function<void ()> onChange);
+
+    AudioBufferRefCounted* acquireSampleBuffer (int slotIndex) noexcept;
+    void releaseSampleBuffer (int slotIndex) noexcept;
+    void finishPlayback (uint32_t restartCount) noexcept;
+    static constexpr uint64_t makePlayState (uint32_t restartCount, bool playing) noexcept { return (static_cast<uint64_t> (restartCount) << 1) | (playing ? 1 : 0); }
+    void recordCallbackMetrics (juce::int64 callbackStartTicks, int numSamples) noexcept;
+    void renderFile (const juce::AudioSourceChannelInfo& bufferToFill, const PlaybackParameters& parameters) noexcept;
+    void renderChannel (const juce::AudioSourceChannelInfo& bufferToFill, const PlaybackParameters& parameters) noexcept;
+    void renderBank (const juce::AudioSourceChannelInfo& bufferToFill, bool restart) noexcept;
+    void triggerBankStep (const BankParameters& parameters) noexcept;
 
     void prepareToPlay (int samplesPerBlockExpected, double sampleRate) override;
     void getNextAudioBlock (const juce::AudioSourceChannelInfo& bufferToFill) override;
     void releaseResources () override;
     void changeListenerCallback (juce::ChangeBroadcaster* source) override;
-};
\ No newline at end of file
+    void handleAsyncUpdate () override;
+    int useTimeSlice () override;
+};
@@ -4,6 +4,10 @@ void AudioPlayerProperties::initValueTree ()
 {
     setPlayState (PlayState::stop, false);
     setSampleSource (-1, false);
+    setFileSource ("", false);
+    setBankTempo (120, false);
+    // each channel triggered once per bar, one after the other
+    setBankPattern ("1,0,2,0,4,0,8,0,16,0,32,0,64,0,128,0", false);
 }
 
 void AudioPlayerProperties::setPlayState (PlayState playState, bool includeSelfCallback)
@@ -21,6 +25,21 @@ void AudioPlayerProperties::setSampleSource (int channelIndex, bool includeSelfC
     setValue (channelIndex, SampleSourcePropertyId, includeSelfCallback);
 }
 
+void AudioPlayerProperties::setFileSource (juce::String fileName, bool includeSelfCallback)
+{
+    setValue (fileName, FileSourcePropertyId, includeSelfCallback);
+}
+
+void AudioPlayerProperties::setBankTempo (int bpm, bool includeSelfCallback)
+{
+    setValue (bpm, BankTempoPropertyId, includeSelfCallback);
+}
+
+void AudioPlayerProperties::setBankPattern (juce::String pattern, bool includeSelfCallback)
+{
+    setValue (pattern, BankPatternPropertyId, includeSelfCallback);
+}
+
 void AudioPlayerProperties::showConfigDialog (bool includeSelfCallback)
 {
     toggleValue (ShowConfigDialogPropertyId, includeSelfCallback);
@@ -41,6 +60,21 @@ int AudioPlayerProperties::getSampleSource ()
     return getValue<int> (SampleSourcePropertyId);
 }
 
+juce::String AudioPlayerProperties::getFileSource ()
+{
+    return getValue<juce::String> (FileSourcePropertyId);
+}
+
+int AudioPlayerProperties::getBankTempo ()
+{
+    return getValue<int> (BankTempoPropertyId);
+}
+
+juce::String AudioPlayerProperties::getBankPattern ()
+{
+    return getValue<juce::String> (BankPatternPropertyId);
+}
+
 void AudioPlayerProperties::valueTreePropertyChanged (juce::ValueTree& treeWhosePropertyHasChanged, const juce::Identifier& property)
 {
     if (treeWhosePropertyHasChanged == data)
@@ -60,6 +94,21 @@ void AudioPlayerProperties::valueTreePropertyChanged (juce::ValueTree& treeWhose
             if (onSampleSourceChanged != nullptr)
                 onSampleSourceChanged (getSampleSource ());
         }
+        else if (property == FileSourcePropertyId)
+        {
+            if (onFileSourceChange != nullptr)
+                onFileSourceChange (getFileSource ());
+        }
+        else if (property == BankTempoPropertyId)
+        {
+            if (onBankTempoChange != nullptr)
+                onBankTempoChange (getBankTempo ());
+        }
+        else if (property == BankPatternPropertyId)
+        {
+            if (onBankPatternChange != nullptr)
+                onBankPatternChange (getBankPattern ());
+        }
         else if (property == ShowConfigDialogPropertyId)
         {
             if (onShowConfigDialog != nullptr)
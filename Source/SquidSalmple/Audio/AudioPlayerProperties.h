@@ -11,19 +11,28 @@ public:
         : ValueTreeWrapper<AudioPlayerProperties> (AudioConfigTypeId, vt, wrapperType, shouldEnableCallbacks) {}
 
     enum class PlayState { stop, play };
-    enum class PlayMode { once, loop };
+    enum class PlayMode { once, loop, bank, file };
     void setPlayState (PlayState playState, bool includeSelfCallback);
     void setPlayMode (PlayMode playMode, bool includeSelfCallback);
     void setSampleSource (int channelIndex, bool includeSelfCallback);
+    void setFileSource (juce::String fileName, bool includeSelfCallback); // file to stream from disk in the file play mode
+    void setBankTempo (int bpm, bool includeSelfCallback);
+    void setBankPattern (juce::String pattern, bool includeSelfCallback); // 16 comma separated steps, each a bit mask of the channels to trigger
     void showConfigDialog (bool includeSelfCallback);
 
     PlayState getPlayState ();
     PlayMode getPlayMode ();
     int getSampleSource ();
+    juce::String getFileSource ();
+    int getBankTempo ();
+    juce::String getBankPattern ();
 
     std::function<void (PlayState playState)> onPlayStateChange;
     std::function<void (PlayMode playMode)> onPlayModeChange;
     std::function<void (int channelIndex)> onSampleSourceChanged;
+    std::function<void (juce::String fileName)> onFileSourceChange;
+    std::function<void (int bpm)> onBankTempoChange;
+    std::function<void (juce::String pattern)> onBankPatternChange;
     std::function<void ()> onShowConfigDialog;
 
     static inline const juce::Identifier AudioConfigTypeId { "AudioPlayer" };
@@ -31,6 +40,9 @@ public:
     static inline const juce::Identifier PlayModePropertyId         { "playMode" };
     static inline const juce::Identifier SampleSourcePropertyId     { "sampleSource" };
     static inline const juce::Identifier ShowConfigDialogPropertyId { "showConfigDialog" };
+    static inline const juce::Identifier FileSourcePropertyId       { "fileSource" };
+    static inline const juce::Identifier BankTempoPropertyId        { "bankTempo" };
+    static inline const juce::Identifier BankPatternPropertyId      { "bankPattern" };
 
     void initValueTree ();
     void processValueTree () {}
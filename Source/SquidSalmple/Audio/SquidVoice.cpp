@@ -0,0 +1,389 @@
+#include "SquidVoice.h"
+#include "../Metadata/SquidSalmpleDefs.h"
+
+static const auto kScaleMax { 65535. };
+static const auto kScaleStep { kScaleMax / 100 };
+
+// rate settings, in the order they are stored, 44k, 22k, 14k, 11k, 9k, 7k, 6k, 4k
+static const std::array<double, 8> kRateList { 44100.0, 22050.0, 14700.0, 11025.0, 8820.0, 7350.0, 6300.0, 4410.0 };
+static const auto kMaxEnvelopeSeconds { 10.0f };
+static const auto kMinEnvelopeSeconds { 0.005f };
+static const auto kReleaseSeconds { kMinEnvelopeSeconds }; // the fade out when the gate is let go in a gate loop mode
+
+// sin squared, across one sweep of a pitch shift tap, with an extra point at the end for the interpolation
+static constexpr int kPitchShiftWindowTableSize { 1024 };
+static const auto kPitchShiftWindowTable { [] ()
+{
+    std::array<float, kPitchShiftWindowTableSize + 1> windowTable;
+    for (auto tableIndex { 0 }; tableIndex <= kPitchShiftWindowTableSize; ++tableIndex)
+    {
+        const auto windowValue { std::sin (juce::MathConstants<double>::pi * tableIndex / kPitchShiftWindowTableSize) };
+        windowTable [static_cast<size_t> (tableIndex)] = static_cast<float> (windowValue * windowValue);
+    }
+    return windowTable;
+} () };
+
+SquidVoice::Parameters SquidVoice::getParameters (SquidChannelProperties& channelProperties)
+{
+    Parameters newParameters;
+    newParameters.startCue = static_cast<int> (SquidChannelProperties::byteOffsetToSampleOffset (channelProperties.getStartCue ()));
+    newParameters.loopCue = static_cast<int> (SquidChannelProperties::byteOffsetToSampleOffset (channelProperties.getLoopCue ()));
+    newParameters.endCue = static_cast<int> (SquidChannelProperties::byteOffsetToSampleOffset (channelProperties.getEndCue ()));
+    newParameters.loopMode = channelProperties.getLoopMode ();
+    newParameters.reverse = channelProperties.getReverse () != 0;
+    // 0 is used for 16 bits
+    const auto bits { channelProperties.getBits () };
+    newParameters.bits = bits == 0 ? 16 : juce::jlimit (1, 16, bits);
+    newParameters.rate = kRateList [juce::jlimit (0, static_cast<int> (kRateList.size ()) - 1, channelProperties.getRate ())];
+    // 50 is normal speed
+    newParameters.speed = juce::jmax (1, channelProperties.getSpeed ()) / (50 * kScaleStep);
+    newParameters.pitchShift = juce::jlimit (0.1f, 4.0f, channelProperties.getPitchShift () / 1000.0f);
+    newParameters.filterType = channelProperties.getFilterType ();
+    // the internal frequency value is inverted, with 0 being fully open. map the 0-99 ui value exponentially across 20Hz to 20kHz
+    const auto filterFrequency { channelProperties.getFilterFrequency () };
+    const auto filterFrequencyUiValue { filterFrequency == 0 ? 99 : juce::jlimit (0, 99, 98 - ((filterFrequency - 55) / 40)) };
+    newParameters.filterFrequency = 20.0f * std::pow (1000.0f, filterFrequencyUiValue / 99.0f);
+    newParameters.filterQ = 0.707f + static_cast<float> (channelProperties.getFilterResonance () / kScaleMax) * 15.0f;
+    // 50 is unity gain
+    newParameters.level = static_cast<float> (channelProperties.getLevel () / (50 * kScaleStep));
+    // attack time grows with the value, decay time shortens as the value rises. 0 turns either stage off
+    const auto attack { channelProperties.getAttack () };
+    newParameters.attackSeconds = attack == 0 ? 0.0f : juce::jmax (kMinEnvelopeSeconds, static_cast<float> (attack / kScaleMax) * kMaxEnvelopeSeconds);
+    const auto decay { channelProperties.getDecay () };
+    newParameters.decaySeconds = decay == 0 ? 0.0f : juce::jmax (kMinEnvelopeSeconds, static_cast<float> (1.0 - (decay / kScaleMax)) * kMaxEnvelopeSeconds);
+    return newParameters;
+}
+
+void SquidVoice::prepare (double newOutputSampleRate, int maxBlockSize)
+{
+    jassert (newOutputSampleRate > 0.0);
+    outputSampleRate = newOutputSampleRate;
+    scratchBuffer.assign (static_cast<size_t> (juce::jmax (maxBlockSize, 128)), 0.0f);
+    envelopeBuffer.assign (scratchBuffer.size (), 0.0f);
+    pitchShiftBuffer.assign (kPitchShiftBufferSize, 0.0f);
+    active = false;
+}
+
+void SquidVoice::setParameters (const Parameters& newParameters) noexcept
+{
+    parameters = newParameters;
+}
+
+void SquidVoice::trigger (double newSourceSampleRate) noexcept
+{
+    jassert (! scratchBuffer.empty ());
+    sourceSampleRate = newSourceSampleRate > 0.0 ? newSourceSampleRate : 44100.0;
+    active = parameters.endCue > parameters.startCue;
+    direction = parameters.reverse ? -1.0 : 1.0;
+    position = parameters.reverse ? parameters.endCue - 1 : parameters.startCue;
+    holdPhase = 1.0;
+    heldSample = 0.0f;
+
+    std::fill (pitchShiftBuffer.begin (), pitchShiftBuffer.end (), 0.0f);
+    pitchShiftWriteIndex = 0;
+    pitchShiftPhase = 0.0;
+    filterIc1eq = 0.0f;
+    filterIc2eq = 0.0f;
+
+    if (parameters.attackSeconds > 0.0f)
+    {
+        envelopeStage = EnvelopeStage::attack;
+        envelopeLevel = 0.0f;
+    }
+    else
+    {
+        envelopeStage = parameters.decaySeconds > 0.0f ? EnvelopeStage::decay : EnvelopeStage::sustain;
+        envelopeLevel = 1.0f;
+    }
+}
+
+void SquidVoice::release () noexcept
+{
+    const auto loopType { static_cast<LoopType> (parameters.loopMode) };
+    if (active && (loopType == LoopType::gate || loopType == LoopType::zigZagGate) && envelopeStage != EnvelopeStage::done)
+        envelopeStage = EnvelopeStage::release;
+}
+
+bool SquidVoice::render (const float* sourceData, int sourceNumSamples, float* outputData, int numSamples) noexcept
+{
+    jassert (! scratchBuffer.empty ());
+    if (! active || sourceData == nullptr || scratchBuffer.empty ())
+        return false;
+
+    // the scratch buffer is sized in prepare, so process larger blocks in pieces
+    auto outputOffset { 0 };
+    while (active && outputOffset < numSamples)
+    {
+        const auto numSamplesToRender { juce::jmin (numSamples - outputOffset, static_cast<int> (scratchBuffer.size ())) };
+        auto* data { scratchBuffer.data () };
+        const auto playbackActive { renderPlayback (sourceData, sourceNumSamples, data, numSamplesToRender) };
+        renderBitReduction (data, numSamplesToRender);
+        renderPitchShift (data, numSamplesToRender);
+        renderFilter (data, numSamplesToRender);
+        const auto envelopeActive { renderEnvelope (data, outputData + outputOffset, numSamplesToRender) };
+        active = playbackActive && envelopeActive;
+        outputOffset += numSamplesToRender;
+    }
+    return active;
+}
+
+// sample playback. playback starts at the start cue (the end cue when reversed). with a loop mode set, playback is then kept between the loop and end cues,
+// either wrapping around (normal) or changing direction at each end (zigZag). the gate variants loop the same way, until release () fades them out.
+// at the full rate, the stretch up to the next loop point is rendered in one run, with the position worked out from the start of the run, so there
+// are no bounds checks or loop carried position updates in the loop, and the compiler can vectorize it
+bool SquidVoice::renderPlayback (const float* sourceData, int sourceNumSamples, float* data, int numSamples) noexcept
+{
+    const auto loopType { static_cast<LoopType> (parameters.loopMode) };
+    const auto loopStart { static_cast<double> (juce::jmin (parameters.loopCue, parameters.endCue)) };
+    const auto loopEnd { static_cast<double> (parameters.endCue) };
+    const auto loopLength { loopEnd - loopStart };
+    const auto isLooping { loopType != LoopType::none && loopLength > 0.0 };
+    const auto isZigZag { loopType == LoopType::zigZag || loopType == LoopType::zigZagGate };
+    const auto lowerBound { isLooping ? loopStart : static_cast<double> (parameters.startCue) };
+    const auto increment { parameters.speed * sourceSampleRate / outputSampleRate };
+    // the full rate setting plays at the source rate, so skip the sample and hold
+    const auto holdIncrement { parameters.rate >= sourceSampleRate ? 1.0 : parameters.rate / outputSampleRate };
+    // the interpolation reads one sample behind and two ahead, the limits leave a sample more than that, for rounding in the run positions
+    const auto upperRunLimit { juce::jmin (loopEnd, static_cast<double> (sourceNumSamples - 3)) };
+    const auto lowerRunLimit { juce::jmax (lowerBound, 2.0) };
+
+    for (auto sampleIndex { 0 }; sampleIndex < numSamples;)
+    {
+        if (position >= loopEnd && direction > 0.0)
+        {
+            if (! isLooping)
+            {
+                juce::FloatVectorOperations::clear (data + sampleIndex, numSamples - sampleIndex);
+                return false;
+            }
+            if (isZigZag)
+            {
+                position = juce::jmax (loopStart, loopEnd - (position - loopEnd) - 1.0);
+                direction = -1.0;
+            }
+            else
+            {
+                position = loopStart + std::fmod (position - loopStart, loopLength);
+            }
+        }
+        else if (position < lowerBound && direction < 0.0)
+        {
+            if (! isLooping)
+            {
+                juce::FloatVectorOperations::clear (data + sampleIndex, numSamples - sampleIndex);
+                return false;
+            }
+            if (isZigZag)
+            {
+                position = juce::jmin (loopEnd - 1.0, loopStart + (loopStart - position));
+                direction = 1.0;
+            }
+            else
+            {
+                position = loopEnd - std::fmod (loopStart - position, loopLength);
+            }
+        }
+
+        if (holdIncrement >= 1.0 && position >= lowerRunLimit && position < upperRunLimit)
+        {
+            const auto samplesToLimit { direction > 0.0 ? std::ceil ((upperRunLimit - position) / increment) : std::floor ((position - lowerRunLimit) / increment) + 1.0 };
+            const auto runLength { static_cast<int> (juce::jmin (static_cast<double> (numSamples - sampleIndex), samplesToLimit)) };
+            const auto step { increment * direction };
+            const auto runStartPosition { position };
+            auto* runData { data + sampleIndex };
+            for (auto runIndex { 0 }; runIndex < runLength; ++runIndex)
+                runData [runIndex] = getInterpolatedSampleUnchecked (sourceData, runStartPosition + runIndex * step);
+            heldSample = runData [runLength - 1];
+            position = runStartPosition + runLength * step;
+            sampleIndex += runLength;
+            continue;
+        }
+
+        holdPhase += holdIncrement;
+        if (holdPhase >= 1.0)
+        {
+            holdPhase -= 1.0;
+            heldSample = getInterpolatedSample (sourceData, sourceNumSamples, position);
+        }
+        data [sampleIndex] = heldSample;
+        position += increment * direction;
+        ++sampleIndex;
+    }
+    return true;
+}
+
+// masks off the low bits of the 16 bit sample value. written as a plain loop over ints so the compiler vectorizes it
+void SquidVoice::renderBitReduction (float* data, int numSamples) noexcept
+{
+    if (parameters.bits >= 16)
+        return;
+
+    const auto mask { static_cast<int32_t> (~((1 << (16 - parameters.bits)) - 1)) };
+    juce::FloatVectorOperations::clip (data, data, -1.0f, 1.0f, numSamples);
+    for (auto sampleIndex { 0 }; sampleIndex < numSamples; ++sampleIndex)
+    {
+        const auto sampleValue { static_cast<int32_t> (data [sampleIndex] * 32767.0f) };
+        data [sampleIndex] = static_cast<float> (sampleValue & mask) * (1.0f / 32768.0f);
+    }
+}
+
+// two tap delay line pitch shifter. each tap sweeps across the window at the pitch ratio, and the taps are crossfaded so the jump back is not heard
+void SquidVoice::renderPitchShift (float* data, int numSamples) noexcept
+{
+    if (std::abs (parameters.pitchShift - 1.0f) < 0.001f)
+        return;
+
+    static_assert ((kPitchShiftBufferSize & kPitchShiftBufferMask) == 0, "pitch shift buffer size must be a power of 2");
+    static_assert (kPitchShiftWindowSize + 2 < kPitchShiftBufferSize, "pitch shift window must fit in the buffer");
+
+    const auto phaseIncrement { (1.0 - parameters.pitchShift) / kPitchShiftWindowSize };
+    auto readTap = [this] (double phase)
+    {
+        auto readPosition { pitchShiftWriteIndex - (1.0 + phase * kPitchShiftWindowSize) };
+        if (readPosition < 0.0)
+            readPosition += kPitchShiftBufferSize;
+        const auto readIndex { static_cast<int> (readPosition) };
+        const auto fraction { static_cast<float> (readPosition - readIndex) };
+        const auto sample1 { pitchShiftBuffer [static_cast<size_t> (readIndex & kPitchShiftBufferMask)] };
+        const auto sample2 { pitchShiftBuffer [static_cast<size_t> ((readIndex + 1) & kPitchShiftBufferMask)] };
+        return sample1 + (sample2 - sample1) * fraction;
+    };
+
+    for (auto sampleIndex { 0 }; sampleIndex < numSamples; ++sampleIndex)
+    {
+        pitchShiftBuffer [static_cast<size_t> (pitchShiftWriteIndex)] = data [sampleIndex];
+        auto otherPhase { pitchShiftPhase + 0.5 };
+        if (otherPhase >= 1.0)
+            otherPhase -= 1.0;
+        // sin squared window on one tap, cos squared on the other, so the gains always sum to 1
+        const auto windowPosition { static_cast<float> (pitchShiftPhase) * kPitchShiftWindowTableSize };
+        // the phase is below 1, but can round up to it as a float
+        const auto windowIndex { juce::jmin (static_cast<size_t> (windowPosition), static_cast<size_t> (kPitchShiftWindowTableSize - 1)) };
+        const auto gain { kPitchShiftWindowTable [windowIndex] + (kPitchShiftWindowTable [windowIndex + 1] - kPitchShiftWindowTable [windowIndex]) * (windowPosition - static_cast<float> (windowIndex)) };
+        data [sampleIndex] = readTap (pitchShiftPhase) * gain + readTap (otherPhase) * (1.0f - gain);
+
+        pitchShiftPhase += phaseIncrement;
+        if (pitchShiftPhase >= 1.0)
+            pitchShiftPhase -= 1.0;
+        else if (pitchShiftPhase < 0.0)
+            pitchShiftPhase += 1.0;
+        pitchShiftWriteIndex = (pitchShiftWriteIndex + 1) & kPitchShiftBufferMask;
+    }
+}
+
+// trapezoidal integrated state variable filter, which gives all four filter types from the same two integrators
+void SquidVoice::renderFilter (float* data, int numSamples) noexcept
+{
+    const auto filterType { static_cast<FilterType> (parameters.filterType) };
+    if (filterType == FilterType::off)
+        return;
+
+    const auto cutoff { juce::jlimit (20.0, outputSampleRate * 0.49, static_cast<double> (parameters.filterFrequency)) };
+    const auto g { static_cast<float> (std::tan (juce::MathConstants<double>::pi * cutoff / outputSampleRate)) };
+    const auto k { 1.0f / juce::jmax (0.5f, parameters.filterQ) };
+    const auto a1 { 1.0f / (1.0f + g * (g + k)) };
+    const auto a2 { g * a1 };
+    const auto a3 { g * a2 };
+
+    // each sample depends on the one before, so this can't be vectorized, but the filter type is chosen once per block, and the state is kept in locals
+    auto filterBlock = [this, data, numSamples, a1, a2, a3] (auto getOutput)
+    {
+        auto ic1eq { filterIc1eq };
+        auto ic2eq { filterIc2eq };
+        for (auto sampleIndex { 0 }; sampleIndex < numSamples; ++sampleIndex)
+        {
+            const auto v0 { data [sampleIndex] };
+            const auto v3 { v0 - ic2eq };
+            const auto v1 { a1 * ic1eq + a2 * v3 };
+            const auto v2 { ic2eq + a2 * ic1eq + a3 * v3 };
+            ic1eq = 2.0f * v1 - ic1eq;
+            ic2eq = 2.0f * v2 - ic2eq;
+            data [sampleIndex] = getOutput (v0, v1, v2);
+        }
+        filterIc1eq = ic1eq;
+        filterIc2eq = ic2eq;
+    };
+    switch (filterType)
+    {
+        case FilterType::lp: filterBlock ([] (float, float, float v2) { return v2; }); break;
+        case FilterType::bp: filterBlock ([] (float, float v1, float) { return v1; }); break;
+        case FilterType::notch: filterBlock ([k] (float v0, float v1, float) { return v0 - k * v1; }); break;
+        case FilterType::hp: filterBlock ([k] (float v0, float v1, float v2) { return v0 - k * v1 - v2; }); break;
+        case FilterType::off: break;
+    }
+}
+
+// linear attack then decay (or release), scaled by level and added to the output. returns false once the envelope has finished. while the level is
+// ramping, the gain of each sample is worked out from the start of the ramp, which vectorizes, and applied with FloatVectorOperations
+bool SquidVoice::renderEnvelope (const float* data, float* outputData, int numSamples) noexcept
+{
+    const auto attackIncrement { parameters.attackSeconds > 0.0f ? static_cast<float> (1.0 / (parameters.attackSeconds * outputSampleRate)) : 1.0f };
+    const auto decayDecrement { parameters.decaySeconds > 0.0f ? static_cast<float> (1.0 / (parameters.decaySeconds * outputSampleRate)) : 0.0f };
+    const auto releaseDecrement { static_cast<float> (1.0 / (kReleaseSeconds * outputSampleRate)) };
+
+    auto sampleIndex { 0 };
+    while (sampleIndex < numSamples && envelopeStage != EnvelopeStage::done)
+    {
+        if (envelopeStage == EnvelopeStage::sustain)
+        {
+            juce::FloatVectorOperations::addWithMultiply (outputData + sampleIndex, data + sampleIndex, envelopeLevel * parameters.level, numSamples - sampleIndex);
+            break;
+        }
+
+        const auto isAttack { envelopeStage == EnvelopeStage::attack };
+        const auto levelIncrement { isAttack ? attackIncrement : -(envelopeStage == EnvelopeStage::decay ? decayDecrement : releaseDecrement) };
+        const auto targetLevel { isAttack ? 1.0f : 0.0f };
+        const auto samplesToTarget { juce::jmax (1, static_cast<int> (std::ceil ((targetLevel - envelopeLevel) / levelIncrement))) };
+        const auto rampLength { juce::jmin (numSamples - sampleIndex, samplesToTarget) };
+        const auto rampStartLevel { envelopeLevel };
+        auto* gains { envelopeBuffer.data () };
+        for (auto rampIndex { 0 }; rampIndex < rampLength; ++rampIndex)
+            gains [rampIndex] = juce::jlimit (0.0f, 1.0f, rampStartLevel + levelIncrement * static_cast<float> (rampIndex + 1)) * parameters.level;
+        juce::FloatVectorOperations::addWithMultiply (outputData + sampleIndex, data + sampleIndex, gains, rampLength);
+        sampleIndex += rampLength;
+
+        if (rampLength < samplesToTarget)
+        {
+            envelopeLevel = juce::jlimit (0.0f, 1.0f, rampStartLevel + levelIncrement * static_cast<float> (rampLength));
+        }
+        else
+        {
+            envelopeLevel = targetLevel;
+            if (isAttack)
+                envelopeStage = decayDecrement > 0.0f ? EnvelopeStage::decay : EnvelopeStage::sustain;
+            else
+                envelopeStage = EnvelopeStage::done;
+        }
+    }
+    return envelopeStage != EnvelopeStage::done;
+}
+
+// 4 point, 3rd order Hermite interpolation, between y0 and y1
+static inline float hermite (float ym1, float y0, float y1, float y2, float fraction) noexcept
+{
+    const auto c1 { 0.5f * (y1 - ym1) };
+    const auto c2 { ym1 - 2.5f * y0 + 2.0f * y1 - 0.5f * y2 };
+    const auto c3 { 0.5f * (y2 - ym1) + 1.5f * (y0 - y1) };
+    return ((c3 * fraction + c2) * fraction + c1) * fraction + y0;
+}
+
+// reads one sample behind and two ahead of the read position, samples outside of the source are treated as silence
+float SquidVoice::getInterpolatedSample (const float* sourceData, int sourceNumSamples, double position) noexcept
+{
+    const auto readIndex { static_cast<int> (std::floor (position)) };
+    const auto fraction { static_cast<float> (position - readIndex) };
+    auto getSample = [sourceData, sourceNumSamples] (int index)
+    {
+        if (index < 0 || index >= sourceNumSamples)
+            return 0.0f;
+        return sourceData [index];
+    };
+    return hermite (getSample (readIndex - 1), getSample (readIndex), getSample (readIndex + 1), getSample (readIndex + 2), fraction);
+}
+
+float SquidVoice::getInterpolatedSampleUnchecked (const float* sourceData, double position) noexcept
+{
+    const auto readIndex { static_cast<int> (position) };
+    const auto fraction { static_cast<float> (position - readIndex) };
+    return hermite (sourceData [readIndex - 1], sourceData [readIndex], sourceData [readIndex + 1], sourceData [readIndex + 2], fraction);
+}
@@ -0,0 +1,87 @@
+#pragma once
+
+#include <JuceHeader.h>
+#include "../SquidChannelProperties.h"
+
+// SquidVoice - renders one channel the way the Squid Salmple module plays it, for auditioning edits. the signal path is
+// sample playback (cues, loop mode, reverse, speed) -> rate reduction -> bit reduction -> pitch shift -> filter -> envelope and level
+// the gate loop modes loop while the gate is held, and fade out when release () is called, the other modes ignore the gate
+// NOTE: the parameter to sound mappings are approximations of the module, based on the parameter descriptions in the manual
+class SquidVoice
+{
+public:
+    // everything render () needs, in ready to use units. trivially copyable so it can be handed to the audio thread through a SeqLock
+    struct Parameters
+    {
+        int startCue { 0 }; // in samples
+        int loopCue { 0 };
+        int endCue { 0 };
+        int loopMode { 0 }; // LoopType
+        bool reverse { false };
+        int bits { 16 };
+        double rate { 44100.0 }; // sample and hold rate, in Hz
+        double speed { 1.0 };
+        float pitchShift { 1.0f }; // pitch ratio, independent of speed
+        int filterType { 0 }; // FilterType
+        float filterFrequency { 20000.0f }; // in Hz
+        float filterQ { 0.707f };
+        float level { 1.0f };
+        float attackSeconds { 0.0f };
+        float decaySeconds { 0.0f };
+    };
+    static Parameters getParameters (SquidChannelProperties& channelProperties);
+
+    void prepare (double newOutputSampleRate, int maxBlockSize);
+    void setParameters (const Parameters& newParameters) noexcept;
+    void trigger (double newSourceSampleRate) noexcept;
+    // the gate has been let go
+    void release () noexcept;
+    void stop () noexcept { active = false; }
+    bool isActive () const noexcept { return active; }
+
+    // adds numSamples of output to outputData, returns false once the voice has finished
+    bool render (const float* sourceData, int sourceNumSamples, float* outputData, int numSamples) noexcept;
+
+    static float getInterpolatedSample (const float* sourceData, int sourceNumSamples, double position) noexcept;
+    // no bounds checks, the samples at position - 1 to position + 2 must be in the source
+    static float getInterpolatedSampleUnchecked (const float* sourceData, double position) noexcept;
+
+private:
+    static constexpr int kPitchShiftBufferSize { 4096 };
+    static constexpr int kPitchShiftBufferMask { kPitchShiftBufferSize - 1 };
+    static constexpr double kPitchShiftWindowSize { 2048.0 };
+
+    Parameters parameters;
+    double outputSampleRate { 44100.0 };
+    double sourceSampleRate { 44100.0 };
+    bool active { false };
+
+    // playback
+    double position { 0.0 };
+    double direction { 1.0 };
+    double holdPhase { 1.0 };
+    float heldSample { 0.0f };
+
+    // pitch shift
+    std::vector<float> pitchShiftBuffer;
+    int pitchShiftWriteIndex { 0 };
+    double pitchShiftPhase { 0.0 };
+
+    // state variable filter
+    float filterIc1eq { 0.0f };
+    float filterIc2eq { 0.0f };
+
+    // envelope
+    enum class EnvelopeStage { attack, decay, sustain, release, done };
+    EnvelopeStage envelopeStage { EnvelopeStage::sustain };
+    float envelopeLevel { 1.0f };
+
+    std::vector<float> scratchBuffer;
+    std::vector<float> envelopeBuffer; // the envelope gain of each sample, while the level is ramping
+
+    bool renderPlayback (const float* sourceData, int sourceNumSamples, float* data, int numSamples) noexcept;
+    void renderBitReduction (float* data, int numSamples) noexcept;
+    void renderPitchShift (float* data, int numSamples) noexcept;
+    void renderFilter (float* data, int numSamples) noexcept;
+    bool renderEnvelope (const float* data, float* outputData, int numSamples) noexcept;
+};
@@ -1,5 +1,4 @@
 #include "BankHelpers.h"
-#include "../CvParameterProperties.h"
 #include "../SquidBankProperties.h"
 #include "../SquidChannelProperties.h"
 
@@ -47,23 +46,10 @@ namespace BankHelpers
     {
         SquidChannelProperties channelPropertiesOne (channelOneVT, SquidChannelProperties::WrapperType::client, SquidChannelProperties::EnableCallbacks::no);
         SquidChannelProperties channelPropertiesTwo (channelTwoVT, SquidChannelProperties::WrapperType::client, SquidChannelProperties::EnableCallbacks::no);
-        bool doesMatch { true };
-        for (auto cvAssignIndex { 0 }; cvAssignIndex < 8; ++cvAssignIndex)
-        {
-            channelPropertiesOne.forEachCvParameter (cvAssignIndex, [&doesMatch, cvAssignIndex, &channelPropertiesTwo] (juce::ValueTree srcParameterVT)
-            {
-                CvParameterProperties channelCvParameterPropertiesOne { srcParameterVT, CvParameterProperties::WrapperType::client, CvParameterProperties::EnableCallbacks::no };
-                const auto cvParameterId { channelCvParameterPropertiesOne.getId () };
-                CvParameterProperties channelCvParameterPropertiesTwo { channelPropertiesTwo.getCvParameterVT (cvAssignIndex, cvParameterId), CvParameterProperties::WrapperType::client, CvParameterProperties::EnableCallbacks::no };
-                if ((channelCvParameterPropertiesOne.getEnabled () != channelCvParameterPropertiesTwo.getEnabled ()) ||
-                    (channelCvParameterPropertiesOne.getAttenuation () != channelCvParameterPropertiesTwo.getAttenuation ()) ||
-                    (channelCvParameterPropertiesOne.getOffset () != channelCvParameterPropertiesTwo.getOffset ()))
-                    doesMatch = false;
-                return doesMatch;
-            });
-
-        }
-        return doesMatch;
+        for (auto cvAssignIndex { 0 }; cvAssignIndex < SquidChannelProperties::kNumCvInputs; ++cvAssignIndex)
+            if (! channelPropertiesOne.isCvAssignEqual (channelPropertiesTwo, cvAssignIndex))
+                return false;
+        return true;
     }
 
     bool areCueSetsEqual (juce::ValueTree channelOneVT, juce::ValueTree channelTwoVT)
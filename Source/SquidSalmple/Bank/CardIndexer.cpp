@@ -0,0 +1,114 @@
+#include "CardIndexer.h"
+#include "../Metadata/BusyChunkReader.h"
+#include "../Metadata/SquidMetaDataReader.h"
+#include "../../Utility/DebugLog.h"
+#include "../../Utility/Trace.h"
+
+#define LOG_CARD_INDEXER 0
+#if LOG_CARD_INDEXER
+#define LogCardIndexer(text) DebugLog ("CardIndexer", text);
+#else
+#define LogCardIndexer(text) ;
+#endif
+
+CardIndexer::CardIndex CardIndexer::index (juce::File rootFolder, int numThreads)
+{
+    TRACE_SPAN ("CardIndexer::index");
+    LogCardIndexer ("index - indexing: " + rootFolder.getFullPathName ());
+    [[maybe_unused]] const auto indexStartTime { juce::Time::getMillisecondCounterHiRes () };
+
+    const auto bankDirectories { getBankDirectories (rootFolder) };
+    CardIndex cardIndex (bankDirectories.size ());
+    if (cardIndex.empty ())
+        return cardIndex;
+
+    // each bank is a separate job, the entries are preallocated so the jobs don't share anything
+    std::atomic<int> banksRemaining { static_cast<int> (cardIndex.size ()) };
+    juce::WaitableEvent indexComplete;
+    juce::ThreadPool threadPool (juce::jlimit (1, static_cast<int> (cardIndex.size ()), numThreads));
+    for (auto bankIndex { 0u }; bankIndex < bankDirectories.size (); ++bankIndex)
+    {
+        auto& bankEntry { cardIndex [bankIndex] };
+        bankEntry.bankNumber = bankDirectories [bankIndex].first;
+        threadPool.addJob ([bankDirectory = bankDirectories [bankIndex].second, &bankEntry, &banksRemaining, &indexComplete] ()
+        {
+            indexBank (bankDirectory, bankEntry);
+            if (--banksRemaining == 0)
+                indexComplete.signal ();
+        });
+    }
+    indexComplete.wait ();
+
+    LogCardIndexer ("index - " + juce::String (cardIndex.size ()) + " banks indexed in " + juce::String (juce::Time::getMillisecondCounterHiRes () - indexStartTime, 3) + " ms");
+    return cardIndex;
+}
+
+std::vector<std::pair<int, juce::File>> CardIndexer::getBankDirectories (juce::File rootFolder)
+{
+    std::vector<std::pair<int, juce::File>> bankDirectories;
+    for (const auto& entry : juce::RangedDirectoryIterator (rootFolder, false, "Bank *", juce::File::findDirectories))
+    {
+        const auto bankDirectory { entry.getFile () };
+        const auto bankNumber { bankDirectory.getFileName ().substring (5).getIntValue () };
+        if (bankNumber < 1 || bankNumber > kMaxBanks)
+            continue;
+        bankDirectories.emplace_back (bankNumber, bankDirectory);
+    }
+    std::sort (bankDirectories.begin (), bankDirectories.end (), [] (const auto& bankOne, const auto& bankTwo) { return bankOne.first < bankTwo.first; });
+    return bankDirectories;
+}
+
+void CardIndexer::forEachChannel (const CardIndex& cardIndex, std::function<bool (const BankEntry& bankEntry, int channelIndex, const ChannelEntry& channelEntry)> channelCallback)
+{
+    jassert (channelCallback != nullptr);
+    for (const auto& bankEntry : cardIndex)
+        for (auto channelIndex { 0 }; channelIndex < kNumChannels; ++channelIndex)
+            if (! channelCallback (bankEntry, channelIndex, bankEntry.channels [static_cast<size_t> (channelIndex)]))
+                return;
+}
+
+// same search as EditManager::loadBank, without converting old style banks
+juce::File CardIndexer::findSampleFile (juce::File bankDirectory, int channelIndex)
+{
+    if (auto channelDirectory { bankDirectory.getChildFile (juce::String (channelIndex + 1)) }; channelDirectory.isDirectory ())
+    {
+        if (const auto& entry { juce::RangedDirectoryIterator (channelDirectory.getFullPathName (), false, "*.wav", juce::File::findFiles) }; entry != juce::RangedDirectoryIterator {})
+            return entry->getFile ();
+        return {};
+    }
+    if (auto oldStyleNamingSampleFile { bankDirectory.getChildFile (juce::String ("chan-00") + juce::String (channelIndex + 1)).withFileExtension ("wav") }; oldStyleNamingSampleFile.existsAsFile ())
+        return oldStyleNamingSampleFile;
+    return {};
+}
+
+void CardIndexer::indexBank (juce::File bankDirectory, BankEntry& bankEntry)
+{
+    TRACE_SPAN ("CardIndexer::indexBank");
+    if (auto infoTxtFile { bankDirectory.getChildFile ("info.txt") }; infoTxtFile.existsAsFile ())
+    {
+        if (auto infoTxtInputStream { infoTxtFile.createInputStream () }; infoTxtInputStream != nullptr)
+            bankEntry.bankName = infoTxtInputStream->readNextLine ().substring (0, 11);
+    }
+
+    for (auto channelIndex { 0 }; channelIndex < kNumChannels; ++channelIndex)
+    {
+        auto& channelEntry { bankEntry.channels [static_cast<size_t> (channelIndex)] };
+        channelEntry.channelRecord.channelIndex = static_cast<uint8_t> (channelIndex);
+        indexChannel (findSampleFile (bankDirectory, channelIndex), channelEntry);
+    }
+}
+
+void CardIndexer::indexChannel (juce::File sampleFile, ChannelEntry& channelEntry)
+{
+    channelEntry.sampleFile = sampleFile;
+    if (sampleFile == juce::File ())
+        return;
+
+    channelEntry.channelRecord.sampleFileName = sampleFile.getFullPathName ();
+    BusyChunkReader busyChunkReader;
+    juce::MemoryBlock busyChunkData;
+    if (busyChunkReader.readMetaData (sampleFile, busyChunkData))
+        channelEntry.hasMetaData = SquidMetaDataReader::decodeMetaData (busyChunkData, channelEntry.channelRecord);
+    // the reserved sections aren't useful for searching or reporting, and dropping them keeps the index small
+    channelEntry.channelRecord.reservedData.fill (nullptr);
+}
@@ -0,0 +1,43 @@
+#pragma once
+
+#include <JuceHeader.h>
+#include "../ChannelRecord.h"
+
+// CardIndexer - reads the metadata of every channel of every bank in a folder (ie. the root of an SD card), without going through the EditManager.
+// only the 'busy' chunk of each sample is read, the audio is not decoded, and the banks are read in parallel
+class CardIndexer
+{
+public:
+    static constexpr int kMaxBanks { 99 };
+    static constexpr int kNumChannels { 8 };
+
+    struct ChannelEntry
+    {
+        juce::File sampleFile; // juce::File () if the channel has no sample
+        bool hasMetaData { false };
+        ChannelRecord channelRecord; // defaults if there is no metadata. the reserved sections are not kept
+    };
+
+    struct BankEntry
+    {
+        int bankNumber { 0 }; // 1 - 99
+        juce::String bankName;
+        std::array<ChannelEntry, kNumChannels> channels;
+    };
+
+    using CardIndex = std::vector<BankEntry>;
+
+    // returns an entry for each 'Bank N' folder found, ordered by bank number
+    CardIndex index (juce::File rootFolder, int numThreads = juce::SystemStats::getNumCpus ());
+
+    static void forEachChannel (const CardIndex& cardIndex, std::function<bool (const BankEntry& bankEntry, int channelIndex, const ChannelEntry& channelEntry)> channelCallback);
+
+    // the 'Bank N' folders in rootFolder, as bank number/folder pairs ordered by bank number
+    static std::vector<std::pair<int, juce::File>> getBankDirectories (juce::File rootFolder);
+    // the sample file of a channel, or juce::File () if the channel has no sample
+    static juce::File findSampleFile (juce::File bankDirectory, int channelIndex);
+
+private:
+    static void indexBank (juce::File bankDirectory, BankEntry& bankEntry);
+    static void indexChannel (juce::File sampleFile, ChannelEntry& channelEntry);
+};
@@ -0,0 +1,132 @@
+#include "SampleContentIndex.h"
+#include "CardIndexer.h"
+#include "../../Utility/DebugLog.h"
+#include "../../Utility/Hash64.h"
+#include "../../Utility/Metrics.h"
+#include "../../Utility/Trace.h"
+#include <set>
+
+#define LOG_SAMPLE_CONTENT_INDEX 0
+#if LOG_SAMPLE_CONTENT_INDEX
+#define LogSampleContentIndex(text) DebugLog ("SampleContentIndex", text);
+#else
+#define LogSampleContentIndex(text) ;
+#endif
+
+static auto& hashCacheHits { Metrics::getCounter ("contentIndex.cacheHits") };
+static auto& hashCacheMisses { Metrics::getCounter ("contentIndex.cacheMisses") };
+
+bool SampleContentIndex::scan (juce::File rootFolder, std::function<bool ()> shouldContinue)
+{
+    TRACE_SPAN ("SampleContentIndex::scan");
+    LogSampleContentIndex ("scan - scanning: " + rootFolder.getFullPathName ());
+    [[maybe_unused]] const auto scanStartTime { juce::Time::getMillisecondCounterHiRes () };
+
+    auto numFilesHashed { 0 };
+    std::map<uint64_t, std::vector<SampleLocation>> locationsByHash;
+    std::set<juce::String> scannedCacheKeys;
+    for (const auto& [bankNumber, bankDirectory] : CardIndexer::getBankDirectories (rootFolder))
+    {
+        for (auto channelIndex { 0 }; channelIndex < CardIndexer::kNumChannels; ++channelIndex)
+        {
+            if (shouldContinue != nullptr && ! shouldContinue ())
+                return false;
+
+            const auto sampleFile { CardIndexer::findSampleFile (bankDirectory, channelIndex) };
+            if (sampleFile == juce::File ())
+                continue;
+
+            const auto cacheKey { sampleFile.getFullPathName () };
+            scannedCacheKeys.insert (cacheKey);
+            const auto fileSize { sampleFile.getSize () };
+            const auto modificationTime { sampleFile.getLastModificationTime () };
+            std::optional<uint64_t> contentHash;
+            auto isCached { false };
+            {
+                juce::ScopedLock sl (indexLock);
+                if (const auto cacheEntry { hashCache.find (cacheKey) }; cacheEntry != hashCache.end () &&
+                    cacheEntry->second.fileSize == fileSize && cacheEntry->second.modificationTime == modificationTime)
+                {
+                    contentHash = cacheEntry->second.contentHash;
+                    isCached = true;
+                }
+            }
+            if (isCached)
+            {
+                hashCacheHits.add ();
+            }
+            else
+            {
+                hashCacheMisses.add ();
+                contentHash = hashSampleData (sampleFile);
+                ++numFilesHashed;
+                juce::ScopedLock sl (indexLock);
+                hashCache [cacheKey] = { fileSize, modificationTime, contentHash };
+            }
+            if (contentHash.has_value ())
+                locationsByHash [contentHash.value ()].push_back ({ bankNumber, channelIndex, sampleFile });
+        }
+    }
+
+    // locations are added in bank and channel order, so each group, and the list of groups, ends up in that order
+    DuplicateGroups newDuplicateGroups;
+    for (auto& [contentHash, locations] : locationsByHash)
+        if (locations.size () > 1)
+            newDuplicateGroups.push_back ({ contentHash, std::move (locations) });
+    std::sort (newDuplicateGroups.begin (), newDuplicateGroups.end (), [] (const DuplicateGroup& groupOne, const DuplicateGroup& groupTwo)
+    {
+        const auto& locationOne { groupOne.locations.front () };
+        const auto& locationTwo { groupTwo.locations.front () };
+        return std::tie (locationOne.bankNumber, locationOne.channelIndex) < std::tie (locationTwo.bankNumber, locationTwo.channelIndex);
+    });
+
+    LogSampleContentIndex ("scan - " + juce::String (newDuplicateGroups.size ()) + " duplicate groups, " + juce::String (numFilesHashed) + " files hashed, in " +
+                           juce::String (juce::Time::getMillisecondCounterHiRes () - scanStartTime, 3) + " ms");
+    juce::ScopedLock sl (indexLock);
+    // drop the entries for files that are no longer a sample on this card, or no longer exist, so the cache does not grow with every edit
+    for (auto cacheEntry { hashCache.begin () }; cacheEntry != hashCache.end ();)
+    {
+        const auto& cacheKey { cacheEntry->first };
+        const auto isStale { scannedCacheKeys.count (cacheKey) == 0 && (juce::File (cacheKey).isAChildOf (rootFolder) || ! juce::File (cacheKey).existsAsFile ()) };
+        cacheEntry = isStale ? hashCache.erase (cacheEntry) : std::next (cacheEntry);
+    }
+    duplicateGroups = std::move (newDuplicateGroups);
+    numFilesHashedByLastScan = numFilesHashed;
+    return true;
+}
+
+SampleContentIndex::DuplicateGroups SampleContentIndex::getDuplicateGroups ()
+{
+    juce::ScopedLock sl (indexLock);
+    return duplicateGroups;
+}
+
+int SampleContentIndex::getNumFilesHashedByLastScan ()
+{
+    juce::ScopedLock sl (indexLock);
+    return numFilesHashedByLastScan;
+}
+
+std::optional<uint64_t> SampleContentIndex::hashSampleData (juce::File sampleFile)
+{
+    juce::MemoryMappedFile mappedSampleFile (sampleFile, juce::MemoryMappedFile::readOnly);
+    const auto* fileData { static_cast<const uint8_t*> (mappedSampleFile.getData ()) };
+    const auto fileSize { mappedSampleFile.getSize () };
+    constexpr size_t kChunkHeaderSize { 8 };
+    constexpr size_t kRiffHeaderSize { kChunkHeaderSize + 4 };
+    if (fileData == nullptr || fileSize < kRiffHeaderSize || std::memcmp (fileData, "RIFF", 4) != 0 || std::memcmp (fileData + 8, "WAVE", 4) != 0)
+        return {};
+
+    // walk the chunks until the 'data' chunk, checking every length against the end of the file
+    for (auto chunkOffset { kRiffHeaderSize }; chunkOffset + kChunkHeaderSize <= fileSize;)
+    {
+        const auto* chunkHeader { fileData + chunkOffset };
+        const auto chunkLength { static_cast<size_t> (juce::ByteOrder::littleEndianInt (chunkHeader + 4)) };
+        if (chunkLength > fileSize - chunkOffset - kChunkHeaderSize)
+            return {};
+        if (std::memcmp (chunkHeader, "data", 4) == 0)
+            return Hash64::hash (chunkHeader + kChunkHeaderSize, chunkLength);
+        chunkOffset += kChunkHeaderSize + chunkLength + (chunkLength & 1);
+    }
+    return {};
+}
@@ -0,0 +1,46 @@
+#pragma once
+
+#include <JuceHeader.h>
+
+// SampleContentIndex - hashes the audio ('data' chunk) of every channel sample on a card, so samples with the same audio can be found, regardless
+// of file name or metadata. the hashes are cached by file path, size and modification time, so a rescan only hashes files that have changed, and each completed
+// scan drops the entries for files that are gone
+class SampleContentIndex
+{
+public:
+    struct SampleLocation
+    {
+        int bankNumber { 0 }; // 1 - 99
+        int channelIndex { 0 }; // 0 - 7
+        juce::File sampleFile;
+    };
+
+    struct DuplicateGroup
+    {
+        uint64_t contentHash { 0 };
+        std::vector<SampleLocation> locations; // always more than one, ordered by bank and channel
+    };
+    using DuplicateGroups = std::vector<DuplicateGroup>;
+
+    // thread safe, a scan can run on a background thread while the results of the previous scan are read. shouldContinue is polled between files
+    // returns false if the scan was stopped early, in which case the previous results are kept
+    bool scan (juce::File rootFolder, std::function<bool ()> shouldContinue = nullptr);
+    DuplicateGroups getDuplicateGroups ();
+    int getNumFilesHashedByLastScan ();
+
+    // hash of the audio data of a WAV file, found through a memory mapped view of the file's chunks. no value if the file is not a readable WAV file
+    static std::optional<uint64_t> hashSampleData (juce::File sampleFile);
+
+private:
+    struct CacheEntry
+    {
+        juce::int64 fileSize { 0 };
+        juce::Time modificationTime;
+        std::optional<uint64_t> contentHash;
+    };
+
+    juce::CriticalSection indexLock;
+    std::map<juce::String, CacheEntry> hashCache; // keyed by full path name
+    DuplicateGroups duplicateGroups;
+    int numFilesHashedByLastScan { 0 };
+};
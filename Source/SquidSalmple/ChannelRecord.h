@@ -0,0 +1,101 @@
+#pragma once
+
+#include <JuceHeader.h>
+#include "SquidChannelProperties.h"
+#include "Metadata/SquidSalmpleDefs.h"
+
+// ChannelRecord - a plain copy of the settings of one channel. a load decodes the metadata into a record, and then applies it to the
+// SquidChannelProperties tree in a single pass (SquidChannelProperties::applyChannelRecord), instead of setting each field through the tree as it is read
+struct ChannelRecord
+{
+    static constexpr double kScaleStep { 65535. / 100 };
+    static constexpr int kNumCvInputs { SquidChannelProperties::kNumCvInputs };
+    static constexpr int kNumCvParameters { SquidChannelProperties::kNumCvParameterIds }; // indexed by CvParameterIndex, none2 is unused
+    static constexpr int kNumReservedSections { 15 };
+
+    struct CvAssign
+    {
+        bool enabled { false };
+        uint16_t offset { 0 };
+        int16_t attenuation { 99 }; // -99 to 99
+    };
+
+    struct CueSet
+    {
+        uint32_t start { 0 };
+        uint32_t loop { 0 };
+        uint32_t end { 0 };
+    };
+
+    // the defaults match SquidChannelProperties::initValueTree
+    uint8_t loadedVersion { static_cast<uint8_t> (kSignatureAndVersionCurrent & 0xFF) };
+    uint8_t channelIndex { 0 }; // not applied, the channel a tree represents does not change
+    uint8_t channelSource { 0 };
+    uint8_t choke { 0 };
+    uint8_t recDest { 0 };
+    uint8_t bits { 0 };
+    uint8_t rate { 0 };
+    uint8_t loopMode { 0 };
+    uint8_t reverse { 0 };
+    uint8_t xfade { 0 };
+    uint8_t eTrig { 0 };
+    uint8_t quant { 0 };
+    uint8_t steps { 0 };
+    uint8_t filterType { 0 };
+    uint16_t attack { 0 };
+    uint16_t decay { 0 };
+    uint16_t level { static_cast<uint16_t> (30 * kScaleStep) };
+    uint16_t speed { static_cast<uint16_t> (50 * kScaleStep) };
+    uint16_t filterFrequency { 0 };
+    uint16_t filterResonance { 0 };
+    uint16_t pitchShift { 1000 };
+    uint16_t channelFlags { 0 };
+    uint32_t startCue { 0 };
+    uint32_t loopCue { 0 };
+    uint32_t endCue { 0 };
+    uint32_t endOfData { 0 };
+
+    int numCueSets { 1 };
+    int curCueSet { 0 };
+    std::array<CueSet, kCueNumSets> cueSets {};
+    std::array<std::array<CvAssign, kNumCvParameters>, kNumCvInputs> cvAssigns {};
+    std::array<ReservedDataRefCounted::RefCountedPtr, kNumReservedSections> reservedData; // nullptr leaves the default contents in place
+    juce::String sampleFileName;
+
+    int sampleDataBits { 0 };
+    double sampleDataSampleRate { 0.0 };
+    uint32_t sampleDataNumSamples { 0 };
+    int sampleDataNumChannels { 0 };
+    AudioBufferRefCounted::RefCountedPtr sampleDataAudioBuffer;
+
+    // same rules as SquidChannelProperties::setCueSetPoints, an index one past the end adds a cue set
+    void setCueSetPoints (int cueSetIndex, uint32_t start, uint32_t loop, uint32_t end)
+    {
+        jassert (cueSetIndex <= numCueSets && cueSetIndex < kCueNumSets);
+        if (cueSetIndex > numCueSets || cueSetIndex >= kCueNumSets)
+            return;
+
+        cueSets [static_cast<size_t> (cueSetIndex)] = { start, loop, end };
+        if (cueSetIndex == numCueSets)
+        {
+            ++numCueSets;
+        }
+        else if (cueSetIndex == curCueSet)
+        {
+            startCue = start;
+            loopCue = loop;
+            endCue = end;
+        }
+    }
+
+    // same rules as SquidChannelProperties::setCurCueSet, the current cues follow the selected cue set
+    void setCurCueSet (int cueSetIndex)
+    {
+        curCueSet = cueSetIndex;
+        const auto isValidCueSet { cueSetIndex >= 0 && cueSetIndex < numCueSets };
+        const auto cueSet { isValidCueSet ? cueSets [static_cast<size_t> (cueSetIndex)] : CueSet {} };
+        startCue = cueSet.start;
+        loopCue = cueSet.loop;
+        endCue = cueSet.end;
+    }
+};
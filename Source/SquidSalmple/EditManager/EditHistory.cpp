@@ -0,0 +1,341 @@
+#include "EditHistory.h"
+
+EditHistory::~EditHistory ()
+{
+    vtData.removeListener (this);
+}
+
+void EditHistory::init (juce::ValueTree vt, juce::Array<juce::Identifier> propertiesToIgnore)
+{
+    jassert (! vtData.isValid ());
+    vtData = vt;
+    ignoredProperties = propertiesToIgnore;
+    vtData.addListener (this);
+    startRecording ();
+}
+
+void EditHistory::stopRecording ()
+{
+    closeTransaction ();
+    recording = false;
+}
+
+void EditHistory::startRecording ()
+{
+    resetHistory ();
+    mirror = vtData.createCopy ();
+    recording = true;
+}
+
+bool EditHistory::canUndo () noexcept
+{
+    return numUndoable > 0;
+}
+
+bool EditHistory::canRedo () noexcept
+{
+    return numUndoable < numTransactions;
+}
+
+bool EditHistory::undo ()
+{
+    closeTransaction ();
+    if (! canUndo ())
+        return false;
+
+    --numUndoable;
+    const auto& transaction { getTransaction (numUndoable) };
+    const juce::ScopedValueSetter<bool> applyingHistorySetter (applyingHistory, true);
+    for (auto delta { transaction.deltas.rbegin () }; delta != transaction.deltas.rend (); ++delta)
+        applyDelta (*delta, true);
+    return true;
+}
+
+bool EditHistory::redo ()
+{
+    closeTransaction ();
+    if (! canRedo ())
+        return false;
+
+    const auto& transaction { getTransaction (numUndoable) };
+    ++numUndoable;
+    const juce::ScopedValueSetter<bool> applyingHistorySetter (applyingHistory, true);
+    for (const auto& delta : transaction.deltas)
+        applyDelta (delta, false);
+    return true;
+}
+
+EditHistory::Transaction& EditHistory::getTransaction (int transactionIndex) noexcept
+{
+    jassert (transactionIndex >= 0 && transactionIndex < numTransactions);
+    return transactions [static_cast<size_t> ((firstTransaction + transactionIndex) % kMaxTransactions)];
+}
+
+std::optional<juce::Array<int>> EditHistory::getPath (juce::ValueTree tree)
+{
+    juce::Array<int> path;
+    for (auto pathTree { tree }; pathTree != vtData;)
+    {
+        auto parent { pathTree.getParent () };
+        if (! parent.isValid ())
+            return {};
+        path.insert (0, parent.indexOf (pathTree));
+        pathTree = parent;
+    }
+    return path;
+}
+
+juce::ValueTree EditHistory::getTree (juce::ValueTree root, const juce::Array<int>& path)
+{
+    auto tree { root };
+    for (const auto childIndex : path)
+        tree = tree.getChild (childIndex);
+    return tree;
+}
+
+void EditHistory::addDelta (Delta&& delta)
+{
+    if (! transactionOpen)
+    {
+        // a new edit discards the transactions that could have been redone
+        while (numTransactions > numUndoable)
+        {
+            auto& transaction { getTransaction (numTransactions - 1) };
+            numDeltas -= transaction.deltas.size ();
+            transaction = {};
+            --numTransactions;
+        }
+        if (numTransactions == kMaxTransactions)
+            dropOldestTransaction ();
+        ++numTransactions;
+        numUndoable = numTransactions;
+        transactionOpen = true;
+        // the transaction is closed once the current message loop callback has finished making its changes
+        triggerAsyncUpdate ();
+    }
+
+    auto& transaction { getTransaction (numTransactions - 1) };
+    transaction.lastChangeTime = juce::Time::getMillisecondCounter ();
+    // for repeated changes of one property, only the first previous value and the last new value are needed
+    if (delta.type == Delta::Type::propertyChanged && ! transaction.deltas.empty ())
+    {
+        auto& lastDelta { transaction.deltas.back () };
+        if (lastDelta.type == Delta::Type::propertyChanged && lastDelta.property == delta.property && lastDelta.path == delta.path)
+        {
+            lastDelta.newValue = delta.newValue;
+            return;
+        }
+    }
+    transaction.deltas.push_back (std::move (delta));
+    ++numDeltas;
+    while (numDeltas > kMaxDeltas && numTransactions > 1)
+        dropOldestTransaction ();
+}
+
+void EditHistory::closeTransaction ()
+{
+    if (! transactionOpen)
+        return;
+    transactionOpen = false;
+    cancelPendingUpdate ();
+    if (numTransactions < 2)
+        return;
+
+    // merge into the previous transaction if this one only sets properties which that one set, shortly before
+    constexpr size_t kMaxDeltasToCoalesce { 16 };
+    auto& currentTransaction { getTransaction (numTransactions - 1) };
+    auto& previousTransaction { getTransaction (numTransactions - 2) };
+    if (currentTransaction.deltas.size () > kMaxDeltasToCoalesce || currentTransaction.lastChangeTime - previousTransaction.lastChangeTime > kCoalesceTime)
+        return;
+    std::vector<Delta*> matchingDeltas;
+    for (const auto& delta : currentTransaction.deltas)
+    {
+        if (delta.type != Delta::Type::propertyChanged)
+            return;
+        const auto matchingDelta { std::find_if (previousTransaction.deltas.rbegin (), previousTransaction.deltas.rend (), [&delta] (const Delta& previousDelta)
+        {
+            return previousDelta.type == Delta::Type::propertyChanged && previousDelta.property == delta.property && previousDelta.path == delta.path;
+        }) };
+        if (matchingDelta == previousTransaction.deltas.rend ())
+            return;
+        matchingDeltas.push_back (&*matchingDelta);
+    }
+    for (size_t deltaIndex { 0 }; deltaIndex < matchingDeltas.size (); ++deltaIndex)
+        matchingDeltas [deltaIndex]->newValue = currentTransaction.deltas [deltaIndex].newValue;
+    previousTransaction.lastChangeTime = currentTransaction.lastChangeTime;
+    numDeltas -= currentTransaction.deltas.size ();
+    currentTransaction = {};
+    --numTransactions;
+    numUndoable = numTransactions;
+}
+
+void EditHistory::dropOldestTransaction ()
+{
+    jassert (numTransactions > 0);
+    auto& transaction { getTransaction (0) };
+    numDeltas -= transaction.deltas.size ();
+    transaction = {};
+    firstTransaction = (firstTransaction + 1) % kMaxTransactions;
+    --numTransactions;
+    numUndoable = std::max (0, numUndoable - 1);
+}
+
+void EditHistory::applyDelta (const Delta& delta, bool isUndo)
+{
+    auto tree { getTree (vtData, delta.path) };
+    jassert (tree.isValid ());
+    if (! tree.isValid ())
+        return;
+
+    switch (delta.type)
+    {
+        case Delta::Type::propertyChanged:
+        {
+            const auto& value { isUndo ? delta.previousValue : delta.newValue };
+            if (value.isVoid ())
+                tree.removeProperty (delta.property, nullptr);
+            else
+                tree.setProperty (delta.property, value, nullptr);
+        }
+        break;
+        case Delta::Type::childAdded:
+        {
+            if (isUndo)
+                tree.removeChild (delta.index, nullptr);
+            else
+                tree.addChild (delta.child.createCopy (), delta.index, nullptr);
+        }
+        break;
+        case Delta::Type::childRemoved:
+        {
+            if (isUndo)
+                tree.addChild (delta.child.createCopy (), delta.index, nullptr);
+            else
+                tree.removeChild (delta.index, nullptr);
+        }
+        break;
+        case Delta::Type::childMoved:
+        {
+            if (isUndo)
+                tree.moveChild (delta.newIndex, delta.index, nullptr);
+            else
+                tree.moveChild (delta.index, delta.newIndex, nullptr);
+        }
+        break;
+    }
+}
+
+void EditHistory::resetHistory ()
+{
+    cancelPendingUpdate ();
+    for (auto& transaction : transactions)
+        transaction = {};
+    firstTransaction = 0;
+    numTransactions = 0;
+    numUndoable = 0;
+    numDeltas = 0;
+    transactionOpen = false;
+}
+
+void EditHistory::handleAsyncUpdate ()
+{
+    closeTransaction ();
+}
+
+void EditHistory::valueTreePropertyChanged (juce::ValueTree& vt, const juce::Identifier& property)
+{
+    if (! recording || ignoredProperties.contains (property))
+        return;
+    const auto path { getPath (vt) };
+    if (! path.has_value ())
+        return;
+    auto mirrorTree { getTree (mirror, path.value ()) };
+    jassert (mirrorTree.isValid ());
+    if (! mirrorTree.isValid ())
+        return;
+
+    const auto previousValue { mirrorTree.getProperty (property) };
+    const auto newValue { vt.getProperty (property) };
+    if (previousValue.equalsWithSameType (newValue))
+        return;
+    if (newValue.isVoid ())
+        mirrorTree.removeProperty (property, nullptr);
+    else
+        mirrorTree.setProperty (property, newValue, nullptr);
+    if (applyingHistory)
+        return;
+
+    Delta delta;
+    delta.type = Delta::Type::propertyChanged;
+    delta.path = path.value ();
+    delta.property = property;
+    delta.previousValue = previousValue;
+    delta.newValue = newValue;
+    addDelta (std::move (delta));
+}
+
+void EditHistory::valueTreeChildAdded (juce::ValueTree& parent, juce::ValueTree& child)
+{
+    if (! recording)
+        return;
+    const auto path { getPath (parent) };
+    if (! path.has_value ())
+        return;
+    auto mirrorParent { getTree (mirror, path.value ()) };
+    jassert (mirrorParent.isValid ());
+    const auto childIndex { parent.indexOf (child) };
+    mirrorParent.addChild (child.createCopy (), childIndex, nullptr);
+    if (applyingHistory)
+        return;
+
+    Delta delta;
+    delta.type = Delta::Type::childAdded;
+    delta.path = path.value ();
+    delta.child = child.createCopy ();
+    delta.index = childIndex;
+    addDelta (std::move (delta));
+}
+
+void EditHistory::valueTreeChildRemoved (juce::ValueTree& parent, [[maybe_unused]] juce::ValueTree& child, int index)
+{
+    if (! recording)
+        return;
+    const auto path { getPath (parent) };
+    if (! path.has_value ())
+        return;
+    auto mirrorParent { getTree (mirror, path.value ()) };
+    jassert (mirrorParent.isValid ());
+    // the mirror's copy of the child is no longer changed once it is removed, so it can be kept as is
+    auto removedChild { mirrorParent.getChild (index) };
+    mirrorParent.removeChild (index, nullptr);
+    if (applyingHistory)
+        return;
+
+    Delta delta;
+    delta.type = Delta::Type::childRemoved;
+    delta.path = path.value ();
+    delta.child = removedChild;
+    delta.index = index;
+    addDelta (std::move (delta));
+}
+
+void EditHistory::valueTreeChildOrderChanged (juce::ValueTree& parent, int oldIndex, int newIndex)
+{
+    if (! recording)
+        return;
+    const auto path { getPath (parent) };
+    if (! path.has_value ())
+        return;
+    auto mirrorParent { getTree (mirror, path.value ()) };
+    jassert (mirrorParent.isValid ());
+    mirrorParent.moveChild (oldIndex, newIndex, nullptr);
+    if (applyingHistory)
+        return;
+
+    Delta delta;
+    delta.type = Delta::Type::childMoved;
+    delta.path = path.value ();
+    delta.index = oldIndex;
+    delta.newIndex = newIndex;
+    addDelta (std::move (delta));
+}
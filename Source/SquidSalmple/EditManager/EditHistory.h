@@ -0,0 +1,81 @@
+#pragma once
+
+#include <JuceHeader.h>
+
+// EditHistory - undo/redo for a ValueTree (the edit bank)
+//
+// Each change to the tree is recorded as a delta: a property's previous and new value, or the child that was added, removed or moved, identified by
+// the child indexes leading to the changed tree. The previous values come from a mirror of the tree (ValueTree::createCopy, which shares the property
+// data with the tree), which is kept in step with each change.
+//
+// The changes made during one message loop callback are grouped into one transaction (an undo step). A transaction which only sets properties that
+// the transaction before it also set, within kCoalesceTime of it, is merged into that one, so dragging a slider is a single step. The transactions
+// are kept in a ring buffer, bounded by the number of transactions and the total number of deltas, and the oldest are dropped first.
+class EditHistory : private juce::ValueTree::Listener,
+                    private juce::AsyncUpdater
+{
+public:
+    ~EditHistory ();
+
+    void init (juce::ValueTree vt, juce::Array<juce::Identifier> propertiesToIgnore);
+    // stop recording while the tree is replaced as a whole (ie. loading), startRecording then restarts the history from the current state
+    void stopRecording ();
+    void startRecording ();
+
+    bool canUndo () noexcept;
+    bool canRedo () noexcept;
+    bool undo ();
+    bool redo ();
+
+private:
+    struct Delta
+    {
+        enum class Type { propertyChanged, childAdded, childRemoved, childMoved };
+        Type type { Type::propertyChanged };
+        juce::Array<int> path;
+        juce::Identifier property;
+        juce::var previousValue; // void if the property did not exist
+        juce::var newValue; // void if the property was removed
+        juce::ValueTree child; // a copy of the child that was added or removed
+        int index { 0 };
+        int newIndex { 0 };
+    };
+
+    struct Transaction
+    {
+        std::vector<Delta> deltas;
+        uint32_t lastChangeTime { 0 };
+    };
+
+    static constexpr int kMaxTransactions { 256 };
+    static constexpr size_t kMaxDeltas { 200000 };
+    static constexpr uint32_t kCoalesceTime { 500 };
+
+    juce::ValueTree vtData;
+    juce::ValueTree mirror;
+    juce::Array<juce::Identifier> ignoredProperties;
+    bool recording { false };
+    bool applyingHistory { false };
+
+    std::array<Transaction, kMaxTransactions> transactions;
+    int firstTransaction { 0 }; // ring buffer index of the oldest transaction
+    int numTransactions { 0 };
+    int numUndoable { 0 }; // transactions [0, numUndoable) can be undone, [numUndoable, numTransactions) can be redone
+    size_t numDeltas { 0 };
+    bool transactionOpen { false };
+
+    Transaction& getTransaction (int transactionIndex) noexcept;
+    std::optional<juce::Array<int>> getPath (juce::ValueTree tree);
+    juce::ValueTree getTree (juce::ValueTree root, const juce::Array<int>& path);
+    void addDelta (Delta&& delta);
+    void closeTransaction ();
+    void dropOldestTransaction ();
+    void applyDelta (const Delta& delta, bool isUndo);
+    void resetHistory ();
+
+    void handleAsyncUpdate () override;
+    void valueTreePropertyChanged (juce::ValueTree& vt, const juce::Identifier& property) override;
+    void valueTreeChildAdded (juce::ValueTree& parent, juce::ValueTree& child) override;
+    void valueTreeChildRemoved (juce::ValueTree& parent, juce::ValueTree& child, int index) override;
+    void valueTreeChildOrderChanged (juce::ValueTree& parent, int oldIndex, int newIndex) override;
+};
@@ -1,11 +1,14 @@
 #include "EditManager.h"
-#include "../CvParameterProperties.h"
+#include "../ChannelRecord.h"
+#include "../Bank/BankHelpers.h"
 #include "../Bank/BankManagerProperties.h"
 #include "../Metadata/SquidSalmpleDefs.h"
 #include "../Metadata/SquidMetaDataReader.h"
 #include "../Metadata/SquidMetaDataWriter.h"
 #include "../../Utility/DebugLog.h"
+#include "../../Utility/Metrics.h"
 #include "../../Utility/PersistentRootProperties.h"
+#include "../../Utility/Trace.h"
 #include "../../SRC//libsamplerate-0.1.9/src/samplerate.h"
 
 #define LOG_EDIT_MANAGER 0
@@ -21,6 +24,14 @@ constexpr auto kMaxSeconds { 11 };
 constexpr auto kSupportedSampleRate { 44100 };
 constexpr auto kMaxSampleLength { 524287 };
 
+static auto& bankLoadCount { Metrics::getCounter ("bank.loads") };
+static auto& bankLoadTime { Metrics::getHistogram ("bank.loadTime", "us") };
+static auto& channelLoadTime { Metrics::getHistogram ("bank.channelLoadTime", "us") };
+static auto& bankSaveCount { Metrics::getCounter ("bank.saves") };
+static auto& bankSaveTime { Metrics::getHistogram ("bank.saveTime", "us") };
+static auto& sampleConvertCount { Metrics::getCounter ("sample.conversions") };
+static auto& sampleConvertTime { Metrics::getHistogram ("sample.convertTime", "us") };
+
 EditManager::EditManager ()
 {
     audioFormatManager.registerBasicFormats ();
@@ -54,6 +65,15 @@ void EditManager::init (juce::ValueTree rootPropertiesVT)
         channelPropertiesList [channelIndex].wrap (channelPropertiesVT, SquidChannelProperties::WrapperType::client, SquidChannelProperties::EnableCallbacks::yes);
         return true;
     });
+    squidBankProperties.getValueTree ().addListener (this);
+    // the load triggers are not edits
+    editHistory.init (squidBankProperties.getValueTree (), { SquidBankProperties::LoadBeginPropertyId, SquidBankProperties::LoadCompletePropertyId,
+                                                             SquidChannelProperties::LoadBeginPropertyId, SquidChannelProperties::LoadCompletePropertyId });
+}
+
+EditManager::~EditManager ()
+{
+    squidBankProperties.getValueTree ().removeListener (this);
 }
 
 bool EditManager::isAltOutput (int channelIndex)
@@ -207,23 +227,28 @@ bool EditManager::isCueStepOn (SquidChannelProperties& channelProperties)
 
 void EditManager::loadChannel (juce::ValueTree squidChannelPropertiesVT, uint8_t channelIndex, juce::File sampleFile)
 {
+    TRACE_SPAN ("EditManager::loadChannel");
+    Metrics::ScopedLatency loadLatency (channelLoadTime);
+    [[maybe_unused]] const auto loadStartTime { juce::Time::getMillisecondCounterHiRes () };
     SquidChannelProperties theSquidChannelProperties { squidChannelPropertiesVT,
                                                        SquidChannelProperties::WrapperType::owner,
                                                        SquidChannelProperties::EnableCallbacks::no };
-    SquidChannelProperties newSquidChannelProperties { {}, SquidChannelProperties::WrapperType::owner, SquidChannelProperties::EnableCallbacks::no };
+    // the sample data and metadata are read into a plain record, which is then applied to the channel tree in one pass
+    ChannelRecord channelRecord;
     if (sampleFile.exists ())
     {
         // TODO - check for import errors and handle accordingly
-        addSampleToChannelProperties (newSquidChannelProperties.getValueTree (), sampleFile);
+        addSampleToChannelRecord (channelRecord, sampleFile);
         SquidMetaDataReader squidMetaDataReader;
-        squidMetaDataReader.read (newSquidChannelProperties.getValueTree (), sampleFile, channelIndex);
+        squidMetaDataReader.read (channelRecord, sampleFile, channelIndex);
     }
     else
     {
-        newSquidChannelProperties.setChannelIndex (channelIndex, false);
-        newSquidChannelProperties.setSampleFileName (sampleFile.getFullPathName (), false);
+        channelRecord.channelIndex = channelIndex;
+        channelRecord.sampleFileName = sampleFile.getFullPathName ();
     }
-    theSquidChannelProperties.copyFrom (newSquidChannelProperties.getValueTree (), SquidChannelProperties::CopyType::all, SquidChannelProperties::CheckIndex::no);
+    theSquidChannelProperties.applyChannelRecord (channelRecord);
+    LogEditManager ("loadChannel - channel " + juce::String (channelIndex + 1) + " loaded in " + juce::String (juce::Time::getMillisecondCounterHiRes () - loadStartTime, 3) + " ms");
 }
 
 void EditManager::renameSample (int channelIndex, juce::String newSampleName)
@@ -263,7 +288,7 @@ void EditManager::saveChannel (juce::ValueTree /*squidChannelPropertiesVT*/, uin
         {
             tempFile.moveFileTo (tempFile.withFileExtension ("wav"));
             originalFile.withFileExtension ("old").moveToTrash ();
-            copyBank (squidBankProperties, uneditedSquidBankProperties);
+            updateUneditedBank ();
         }
         else
         {
@@ -280,7 +305,12 @@ void EditManager::saveChannel (juce::ValueTree /*squidChannelPropertiesVT*/, uin
 
 void EditManager::saveBank ()
 {
+    TRACE_SPAN ("EditManager::saveBank");
+    Metrics::ScopedLatency saveLatency (bankSaveTime);
+    bankSaveCount.add ();
     jassert (bankDirectory.exists ());
+    // the files that an undo would refer to are replaced by the save, so the history restarts from the saved bank
+    editHistory.stopRecording ();
     // update info.txt file in bank directory
     auto infoTxtFile { bankDirectory.getChildFile ("info.txt") };
     infoTxtFile.replaceWithText (squidBankProperties.getName ());
@@ -298,7 +328,7 @@ void EditManager::saveBank ()
             {
                 const auto extension { entry.getFile ().getFileExtension ().toLowerCase () };
                 if (extension == ".wav" || extension == "._wav")
-                    entry.getFile ().moveToTrash ();
+                    removeReplacedFile (entry.getFile ());
             }
             continue;
         }
@@ -315,7 +345,7 @@ void EditManager::saveBank ()
                 tempFile.moveFileTo (newFile);
                 squidChannelPropertiesToSave.setSampleFileName (newFile.getFullPathName (), false);
                 // and delete the original
-                originalFile.withFileExtension ("old").moveToTrash ();
+                removeReplacedFile (originalFile.withFileExtension ("old"));
                 // also delete any other wav or _wav files in directory
                 for (const auto& entry : juce::RangedDirectoryIterator (tempFile.getParentDirectory (), false, "*", juce::File::findFiles))
                 {
@@ -323,7 +353,7 @@ void EditManager::saveBank ()
                         continue;
                     const auto extension { entry.getFile ().getFileExtension ().toLowerCase () };
                     if (extension == ".wav" || extension == "._wav")
-                        entry.getFile ().moveToTrash ();
+                        removeReplacedFile (entry.getFile ());
                 }
             }
             else
@@ -337,7 +367,16 @@ void EditManager::saveBank ()
         }
     }
     // finally, copy the new data to the unedited buffer
-    copyBank (squidBankProperties, uneditedSquidBankProperties);
+    updateUneditedBank ();
+    editHistory.startRecording ();
+}
+
+void EditManager::removeReplacedFile (juce::File replacedFile)
+{
+    if (trashReplacedFiles)
+        replacedFile.moveToTrash ();
+    else
+        replacedFile.deleteFile ();
 }
 
 void EditManager::cleanupChannelTempFiles ()
@@ -465,9 +504,13 @@ juce::ValueTree EditManager::getDefaultChannelProperties (int channelIndex)
 
 void EditManager::loadBank (juce::File bankDirectoryToLoad)
 {
+    TRACE_SPAN ("EditManager::loadBank");
+    Metrics::ScopedLatency loadLatency (bankLoadTime);
+    bankLoadCount.add ();
+    editHistory.stopRecording ();
     SquidBankProperties theSquidBankProperties ({}, SquidBankProperties::WrapperType::owner, SquidBankProperties::EnableCallbacks::no);
     copyBank (theSquidBankProperties, squidBankProperties);
-    copyBank (squidBankProperties, uneditedSquidBankProperties);
+    updateUneditedBank ();
 
     // check for info.txt
     auto infoTxtFile { bankDirectoryToLoad.getChildFile ("info.txt") };
@@ -517,15 +560,38 @@ void EditManager::loadBank (juce::File bankDirectoryToLoad)
 
     bankDirectory = bankDirectoryToLoad;
     copyBank (theSquidBankProperties, squidBankProperties);
-    copyBank (squidBankProperties, uneditedSquidBankProperties);
+    updateUneditedBank ();
+    editHistory.startRecording ();
 }
 
 // TODO - this is not complete. it takes a bankIndex, but I think that is incorrect, in that the EditManager only deals with the edit buffer
 //        refer to client code to decide how to change things
 void EditManager::loadBankDefaults (uint8_t /*bankIndex*/)
 {
+    editHistory.stopRecording ();
     copyBank (defaultSquidBankProperties, squidBankProperties);
-    copyBank (squidBankProperties, uneditedSquidBankProperties);
+    updateUneditedBank ();
+    editHistory.startRecording ();
+}
+
+bool EditManager::canUndo ()
+{
+    return editHistory.canUndo ();
+}
+
+bool EditManager::canRedo ()
+{
+    return editHistory.canRedo ();
+}
+
+void EditManager::undo ()
+{
+    editHistory.undo ();
+}
+
+void EditManager::redo ()
+{
+    editHistory.redo ();
 }
 
 void EditManager::copyBank (SquidBankProperties& srcBankProperties, SquidBankProperties& destBankProperties)
@@ -544,10 +610,101 @@ void EditManager::copyBank (SquidBankProperties& srcBankProperties, SquidBankPro
     destBankProperties.triggerLoadComplete (false);
 }
 
-void EditManager::addSampleToChannelProperties (juce::ValueTree channelPropertiesVT, juce::File sampleFile)
+void EditManager::updateUneditedBank ()
+{
+    uneditedSquidBankProperties.triggerLoadBegin (false);
+    uneditedSquidBankProperties.setName (squidBankProperties.getName (), false);
+    auto uneditedBankVT { uneditedSquidBankProperties.getValueTree () };
+    for (auto channelIndex { 0 }; channelIndex < 8; ++channelIndex)
+    {
+        // an unchanged channel is still identical to its snapshot
+        if (! channelChangedSinceSnapshot [channelIndex])
+            continue;
+        const auto uneditedChannelIndex { uneditedBankVT.indexOf (uneditedSquidBankProperties.getChannelVT (channelIndex)) };
+        jassert (uneditedChannelIndex != -1);
+        uneditedBankVT.removeChild (uneditedChannelIndex, nullptr);
+        uneditedBankVT.addChild (channelPropertiesList [channelIndex].getValueTree ().createCopy (), uneditedChannelIndex, nullptr);
+        uneditedChannelDigests [channelIndex] = editChannelDigests [channelIndex];
+        channelChangedSinceSnapshot [channelIndex] = false;
+    }
+    uneditedSquidBankProperties.triggerLoadComplete (false);
+}
+
+int EditManager::getEditChannelIndex (juce::ValueTree vt)
+{
+    for (; vt.isValid (); vt = vt.getParent ())
+    {
+        if (vt.getType () != SquidChannelProperties::SquidChannelTypeId)
+            continue;
+        for (auto channelIndex { 0 }; channelIndex < 8; ++channelIndex)
+            if (channelPropertiesList [channelIndex].getValueTree () == vt)
+                return channelIndex;
+        break;
+    }
+    return -1;
+}
+
+void EditManager::markChannelChanged (juce::ValueTree vt)
+{
+    if (const auto channelIndex { getEditChannelIndex (vt) }; channelIndex != -1)
+    {
+        channelChangedSinceSnapshot [channelIndex] = true;
+        editChannelDigests [channelIndex].reset ();
+    }
+}
+
+bool EditManager::isBankEdited ()
+{
+    auto isEdited { squidBankProperties.getName () != uneditedSquidBankProperties.getName () };
+    [[maybe_unused]] auto digestsUpdated { false };
+    for (auto channelIndex { 0 }; channelIndex < 8 && ! isEdited; ++channelIndex)
+    {
+        if (! editChannelDigests [channelIndex].has_value ())
+        {
+            editChannelDigests [channelIndex] = channelPropertiesList [channelIndex].getDigest ();
+            digestsUpdated = true;
+        }
+        if (! uneditedChannelDigests [channelIndex].has_value ())
+        {
+            digestsUpdated = true;
+            SquidChannelProperties uneditedChannelProperties (uneditedSquidBankProperties.getChannelVT (channelIndex), SquidChannelProperties::WrapperType::client, SquidChannelProperties::EnableCallbacks::no);
+            uneditedChannelDigests [channelIndex] = uneditedChannelProperties.getDigest ();
+        }
+        isEdited = editChannelDigests [channelIndex] != uneditedChannelDigests [channelIndex];
+    }
+#if JUCE_DEBUG
+    // cross-check against the full comparison, which the digest has to stay in step with. the save button polls this, so the comparison only runs
+    // when the digests were just recomputed and all report the bank as unchanged, which is where a digest missing a property would go unnoticed
+    if (digestsUpdated && ! isEdited)
+        jassert (BankHelpers::areEntireBanksEqual (uneditedSquidBankProperties.getValueTree (), squidBankProperties.getValueTree ()));
+#endif
+    return isEdited;
+}
+
+void EditManager::valueTreePropertyChanged (juce::ValueTree& vt, [[maybe_unused]] const juce::Identifier& property)
 {
+    markChannelChanged (vt);
+}
+
+void EditManager::valueTreeChildAdded (juce::ValueTree& parent, [[maybe_unused]] juce::ValueTree& child)
+{
+    markChannelChanged (parent);
+}
+
+void EditManager::valueTreeChildRemoved (juce::ValueTree& parent, [[maybe_unused]] juce::ValueTree& child, [[maybe_unused]] int index)
+{
+    markChannelChanged (parent);
+}
+
+void EditManager::valueTreeChildOrderChanged (juce::ValueTree& parent, [[maybe_unused]] int oldIndex, [[maybe_unused]] int newIndex)
+{
+    markChannelChanged (parent);
+}
+
+void EditManager::addSampleToChannelRecord (ChannelRecord& channelRecord, juce::File sampleFile)
+{
+    TRACE_SPAN ("EditManager::addSampleToChannelRecord");
     jassert (sampleFile.exists ());
-    SquidChannelProperties channelProperties (channelPropertiesVT, SquidChannelProperties::WrapperType::client, SquidChannelProperties::EnableCallbacks::no);
     juce::WavAudioFormat wavAudioFormat;
     auto inputStream { sampleFile.createInputStream () };
     // we have to use the WavAudioFormat::createReaderFor interface here, since the file may be our renamed ._wav type, which the AudioFormatManager will reject based on extension
@@ -582,25 +739,40 @@ void EditManager::addSampleToChannelProperties (juce::ValueTree channelPropertie
             }
         }
 
-        channelProperties.setSampleDataBits (sampleFileReader->bitsPerSample, false);
-        channelProperties.setSampleDataSampleRate (sampleFileReader->sampleRate, false);
-        channelProperties.setSampleDataNumSamples (lengthInSamples, false);
-        channelProperties.setSampleDataNumChannels (1, false);
-        channelProperties.setSampleDataAudioBuffer (abrc, false);
+        channelRecord.sampleDataBits = static_cast<int> (sampleFileReader->bitsPerSample);
+        channelRecord.sampleDataSampleRate = sampleFileReader->sampleRate;
+        channelRecord.sampleDataNumSamples = lengthInSamples;
+        channelRecord.sampleDataNumChannels = 1;
+        channelRecord.sampleDataAudioBuffer = abrc;
     }
     else
     {
         inputStream.release ();
-        channelProperties.setSampleDataBits (0, false);
-        channelProperties.setSampleDataSampleRate (0.0, false);
-        channelProperties.setSampleDataNumSamples (0, false);
-        channelProperties.setSampleDataNumChannels (0, false);
-        channelProperties.setSampleDataAudioBuffer ({}, false);
+        channelRecord.sampleDataBits = 0;
+        channelRecord.sampleDataSampleRate = 0.0;
+        channelRecord.sampleDataNumSamples = 0;
+        channelRecord.sampleDataNumChannels = 0;
+        channelRecord.sampleDataAudioBuffer = {};
     }
 }
 
+void EditManager::addSampleToChannelProperties (juce::ValueTree channelPropertiesVT, juce::File sampleFile)
+{
+    SquidChannelProperties channelProperties (channelPropertiesVT, SquidChannelProperties::WrapperType::client, SquidChannelProperties::EnableCallbacks::no);
+    ChannelRecord channelRecord;
+    addSampleToChannelRecord (channelRecord, sampleFile);
+    channelProperties.setSampleDataBits (channelRecord.sampleDataBits, false);
+    channelProperties.setSampleDataSampleRate (channelRecord.sampleDataSampleRate, false);
+    channelProperties.setSampleDataNumSamples (channelRecord.sampleDataNumSamples, false);
+    channelProperties.setSampleDataNumChannels (channelRecord.sampleDataNumChannels, false);
+    channelProperties.setSampleDataAudioBuffer (channelRecord.sampleDataAudioBuffer, false);
+}
+
 void EditManager::sampleConvert (juce::AudioFormatReader* reader, juce::AudioBuffer<float>& outputBuffer)
 {
+    TRACE_SPAN ("EditManager::sampleConvert");
+    Metrics::ScopedLatency convertLatency (sampleConvertTime);
+    sampleConvertCount.add ();
     juce::AudioBuffer<float> inputBuffer;
     const auto numChannels { reader->numChannels };
     const auto numSamples { reader->lengthInSamples };
@@ -811,16 +983,7 @@ void EditManager::cloneCvAssigns (int srcChannelIndex, int srcCvAssignIndex, int
     jassert (destCvAssignIndex >= 0 && destCvAssignIndex < 8);
     auto& srcChannelProperties { channelPropertiesList [srcChannelIndex] };
     auto& destChannelProperties { channelPropertiesList [destChannelIndex] };
-    srcChannelProperties.forEachCvParameter (srcCvAssignIndex, [this, &destChannelProperties, destCvAssignIndex] (juce::ValueTree srcParameterVT)
-    {
-        CvParameterProperties srcCvParameterProperties { srcParameterVT, CvParameterProperties::WrapperType::client, CvParameterProperties::EnableCallbacks::no };
-        const auto cvParameterId { srcCvParameterProperties.getId () };
-        CvParameterProperties dstCvParameterProperties { destChannelProperties.getCvParameterVT (destCvAssignIndex, cvParameterId), CvParameterProperties::WrapperType::client, CvParameterProperties::EnableCallbacks::no };
-        dstCvParameterProperties.setEnabled (srcCvParameterProperties.getEnabled (), false);
-        dstCvParameterProperties.setAttenuation (srcCvParameterProperties.getAttenuation (), false);
-        dstCvParameterProperties.setOffset (srcCvParameterProperties.getOffset (), false);
-        return true;
-    });
+    destChannelProperties.copyCvAssignFrom (srcChannelProperties, srcCvAssignIndex, destCvAssignIndex);
 }
 
 void EditManager::forChannels (std::vector<int> channelIndexList, std::function<void (juce::ValueTree)> channelCallback)
@@ -945,6 +1108,7 @@ bool EditManager::isSquidManagerSupportedAudioFile (const juce::File file)
 
 bool EditManager::copySampleToChannel (juce::File srcFile, juce::File destFile)
 {
+    TRACE_SPAN ("EditManager::copySampleToChannel");
     if (isSquidSalmpleSupportedAudioFile (srcFile))
     {
         // TODO handle case where file of same name already exists
@@ -1,6 +1,7 @@
 #pragma once
 
 #include <JuceHeader.h>
+#include "EditHistory.h"
 #include "../SquidBankProperties.h"
 #include "../SquidChannelProperties.h"
 #include "../../AppProperties.h"
@@ -16,10 +17,14 @@ struct FileInfo
     bool usesFloatingPointData { false };
 };
 
-class EditManager
+// the unedited bank holds immutable snapshots of the edit bank's channels (juce::ValueTree::createCopy, which shares the property data, including
+// the audio buffers, instead of duplicating it). a snapshot is only retaken for a channel that has changed since the last one, and is put in place
+// by swapping the channel tree, so updating the unedited bank does not copy each property of each channel
+class EditManager : private juce::ValueTree::Listener
 {
 public:
     EditManager ();
+    ~EditManager ();
 
     void init (juce::ValueTree rootPropertiesVT);
 
@@ -36,7 +41,10 @@ public:
     juce::ValueTree getChannelPropertiesVT (int channelIndex);
     std::unique_ptr<juce::AudioFormatReader> getReaderFor (const juce::File file);
     juce::String getFileTypesList ();
+    bool canRedo ();
+    bool canUndo ();
     bool isAltOutput (int channelIndex);
+    bool isBankEdited ();
     bool isAltOutput (juce::ValueTree channelPropertiesVT);
     FileInfo getFileInfo (juce::File file);
     bool isCueRandomOn (int channelIndex);
@@ -50,6 +58,7 @@ public:
     void loadChannel (juce::ValueTree squidChannelPropertiesVT, uint8_t channelIndex, juce::File sampleFile);
     void renameSample (int channelIndex, juce::String newSampleName);
     void saveChannel (juce::ValueTree squidChannelPropertiesVT, uint8_t channelIndex, juce::File sampleFile);
+    void redo ();
     void saveBank ();
     void setBankDefaults ();
     void setBankUnedited ();
@@ -57,9 +66,13 @@ public:
     void setChannelUnedited (int channelIndex);
     void setCueRandom (int channelIndex, bool on);
     void setCueStep (int channelIndex, bool on);
+    // saveBank moves the files it replaces to the trash, unless this is turned off, when they are deleted
+    void setTrashReplacedFiles (bool shouldTrashReplacedFiles) noexcept { trashReplacedFiles = shouldTrashReplacedFiles; }
     void setAltOutput (int channelIndex, bool useAltOutput);
     void setAltOutput (juce::ValueTree channelPropertiesVT, bool useAltOutput);
     void swapChannels (int firstChannel, int secondChannel);
+    void undo ();
+    void updateUneditedBank ();
     juce::ValueTree getUneditedBankProperties ();
     juce::ValueTree getDefaultBankProperties ();
     juce::ValueTree getUneditedChannelProperties (int channelIndex);
@@ -72,17 +85,32 @@ private:
     SquidBankProperties defaultSquidBankProperties;
     SquidBankProperties squidBankProperties;
     juce::File bankDirectory;
+    bool trashReplacedFiles { true };
     std::array<SquidChannelProperties, 8> channelPropertiesList;
+    EditHistory editHistory;
+    std::array<bool, 8> channelChangedSinceSnapshot { true, true, true, true, true, true, true, true };
+    // SquidChannelProperties::getDigest of each channel, cleared when an edit channel changes, and retaken when next needed
+    std::array<std::optional<uint64_t>, 8> editChannelDigests;
+    std::array<std::optional<uint64_t>, 8> uneditedChannelDigests;
 
     juce::AudioFormatManager audioFormatManager;
     juce::StringArray audioFileExtensions;
 
     void addSampleToChannelProperties (juce::ValueTree channelProperties, juce::File sampleFile);
+    void addSampleToChannelRecord (ChannelRecord& channelRecord, juce::File sampleFile);
     void cleanupChannelTempFiles ();
     void copyBank (SquidBankProperties& srcBankProperties, SquidBankProperties& destBankProperties);
+    int getEditChannelIndex (juce::ValueTree vt);
     bool isAltOutput (SquidChannelProperties& channelProperties);
     bool isCueRandomOn (SquidChannelProperties& channelProperties);
     bool isCueStepOn (SquidChannelProperties& channelProperties);
     void sampleConvert (juce::AudioFormatReader* reader, juce::AudioBuffer<float>& outputBuffer);
     void setAltOutput (SquidChannelProperties& channelProperties, bool useAltOutput);
+    void markChannelChanged (juce::ValueTree vt);
+    void removeReplacedFile (juce::File replacedFile);
+
+    void valueTreePropertyChanged (juce::ValueTree& vt, const juce::Identifier& property) override;
+    void valueTreeChildAdded (juce::ValueTree& parent, juce::ValueTree& child) override;
+    void valueTreeChildRemoved (juce::ValueTree& parent, juce::ValueTree& child, int index) override;
+    void valueTreeChildOrderChanged (juce::ValueTree& parent, int oldIndex, int newIndex) override;
 };
\ No newline at end of file
@@ -0,0 +1,323 @@
+#pragma once
+
+#include <JuceHeader.h>
+#include "BusyChunkLayout.h"
+#include "../ChannelRecord.h"
+
+// BusyChunkCodec - moves channel settings between a 'busy' chunk and a ChannelRecord. the field accessors are listed once in the tables below,
+// and the decode/encode code for each metadata version is generated from them and the BusyChunkLayout for that version
+namespace BusyChunkCodec
+{
+    using FieldId = BusyChunkLayout::FieldId;
+
+    struct ScalarField
+    {
+        FieldId id;
+        void (*setValue) (ChannelRecord& channelRecord, uint32_t value);
+        uint32_t (*getValue) (const ChannelRecord& channelRecord);
+    };
+
+    inline constexpr ScalarField kScalarFields []
+    {
+        { FieldId::attack,
+          [] (ChannelRecord& cr, uint32_t value) { cr.attack = static_cast<uint16_t> (value); },
+          [] (const ChannelRecord& cr) { return static_cast<uint32_t> (cr.attack); } },
+        { FieldId::quality,
+          [] (ChannelRecord& cr, uint32_t value) { cr.bits = static_cast<uint8_t> (value); },
+          [] (const ChannelRecord& cr) { return static_cast<uint32_t> (cr.bits); } },
+        { FieldId::channelFlags,
+          [] (ChannelRecord& cr, uint32_t value) { cr.channelFlags = static_cast<uint16_t> (value); },
+          [] (const ChannelRecord& cr) { return static_cast<uint32_t> (cr.channelFlags); } },
+        { FieldId::channelSource,
+          [] (ChannelRecord& cr, uint32_t value) { cr.channelSource = static_cast<uint8_t> (value); },
+          [] (const ChannelRecord& cr) { return static_cast<uint32_t> (cr.channelSource); } },
+        { FieldId::choke,
+          [] (ChannelRecord& cr, uint32_t value) { cr.choke = static_cast<uint8_t> (value); },
+          [] (const ChannelRecord& cr) { return static_cast<uint32_t> (cr.choke); } },
+        { FieldId::decay,
+          [] (ChannelRecord& cr, uint32_t value) { cr.decay = static_cast<uint16_t> (value); },
+          [] (const ChannelRecord& cr) { return static_cast<uint32_t> (cr.decay); } },
+        { FieldId::sampleEnd,
+          [] (ChannelRecord& cr, uint32_t value) { cr.endCue = value; },
+          [] (const ChannelRecord& cr) { return cr.endCue; } },
+        { FieldId::endOfData,
+          [] (ChannelRecord& cr, uint32_t value) { cr.endOfData = value; },
+          [] (const ChannelRecord& cr) { return cr.endOfData; } },
+        { FieldId::externalTrigger,
+          [] (ChannelRecord& cr, uint32_t value) { cr.eTrig = static_cast<uint8_t> (value); },
+          [] (const ChannelRecord& cr) { return static_cast<uint32_t> (cr.eTrig); } },
+        { FieldId::cutoffFrequency,
+          [] (ChannelRecord& cr, uint32_t value)
+          {
+              cr.filterType = static_cast<uint8_t> (value & 0x000F);
+              cr.filterFrequency = static_cast<uint16_t> (value >> 4);
+          },
+          [] (const ChannelRecord& cr) { return static_cast<uint32_t> ((cr.filterFrequency << 4) + cr.filterType); } },
+        { FieldId::resonance,
+          [] (ChannelRecord& cr, uint32_t value) { cr.filterResonance = static_cast<uint16_t> (value); },
+          [] (const ChannelRecord& cr) { return static_cast<uint32_t> (cr.filterResonance); } },
+        { FieldId::level,
+          [] (ChannelRecord& cr, uint32_t value) { cr.level = static_cast<uint16_t> (value); },
+          [] (const ChannelRecord& cr) { return static_cast<uint32_t> (cr.level); } },
+        { FieldId::loopPosition,
+          [] (ChannelRecord& cr, uint32_t value) { cr.loopCue = value; },
+          [] (const ChannelRecord& cr) { return cr.loopCue; } },
+        { FieldId::loop,
+          [] (ChannelRecord& cr, uint32_t value) { cr.loopMode = static_cast<uint8_t> (value); },
+          [] (const ChannelRecord& cr) { return static_cast<uint32_t> (cr.loopMode); } },
+        { FieldId::quantizeMode,
+          [] (ChannelRecord& cr, uint32_t value) { cr.quant = static_cast<uint8_t> (value); },
+          [] (const ChannelRecord& cr) { return static_cast<uint32_t> (cr.quant); } },
+        { FieldId::pitchShift,
+          [] (ChannelRecord& cr, uint32_t value) { cr.pitchShift = static_cast<uint16_t> (value); },
+          [] (const ChannelRecord& cr) { return static_cast<uint32_t> (cr.pitchShift); } },
+        { FieldId::rate,
+          [] (ChannelRecord& cr, uint32_t value) { cr.rate = static_cast<uint8_t> (value); },
+          [] (const ChannelRecord& cr) { return static_cast<uint32_t> (cr.rate); } },
+        { FieldId::recDest,
+          [] (ChannelRecord& cr, uint32_t value) { cr.recDest = static_cast<uint8_t> (value); },
+          [] (const ChannelRecord& cr) { return static_cast<uint32_t> (cr.recDest); } },
+        { FieldId::reverse,
+          [] (ChannelRecord& cr, uint32_t value) { cr.reverse = static_cast<uint8_t> (value); },
+          [] (const ChannelRecord& cr) { return static_cast<uint32_t> (cr.reverse); } },
+        // NOTE: the speed is set to 32750 for channels 5-8, which is a special case for the Squid. The speed is not used in this case, but the channel does not work without an appropriate value.
+        //       This value of 32750 is the one that I found to work, there may be others.
+        { FieldId::speed,
+          [] (ChannelRecord& cr, uint32_t value) { cr.speed = static_cast<uint16_t> (value); },
+          [] (const ChannelRecord& cr) { return static_cast<uint32_t> (cr.channelIndex < 5 ? cr.speed : 32750); } },
+        { FieldId::sampleStart,
+          [] (ChannelRecord& cr, uint32_t value) { cr.startCue = value; },
+          [] (const ChannelRecord& cr) { return cr.startCue; } },
+        { FieldId::stepTrigNum,
+          [] (ChannelRecord& cr, uint32_t value) { cr.steps = static_cast<uint8_t> (value); },
+          [] (const ChannelRecord& cr) { return static_cast<uint32_t> (cr.steps); } },
+        { FieldId::xfade,
+          [] (ChannelRecord& cr, uint32_t value) { cr.xfade = static_cast<uint8_t> (value); },
+          [] (const ChannelRecord& cr) { return static_cast<uint32_t> (cr.xfade); } },
+    };
+
+    // the 'reserved' sections are not understood, they are kept so they can be written back out unchanged. listed in ChannelRecord::reservedData order
+    inline constexpr FieldId kReservedFields []
+    {
+        FieldId::reserved1, FieldId::reserved2, FieldId::reserved3, FieldId::reserved4, FieldId::reserved5,
+        FieldId::reserved6, FieldId::reserved7, FieldId::reserved8, FieldId::reserved9, FieldId::reserved10,
+        FieldId::reserved11, FieldId::reserved12, FieldId::reserved13, FieldId::reserved14, FieldId::reserved15,
+    };
+    static_assert (std::size (kReservedFields) == ChannelRecord::kNumReservedSections, "every reserved section needs a slot in ChannelRecord");
+
+    // little endian, as stored by the module
+    template <int Size>
+    uint32_t readValue (const uint8_t* data) noexcept
+    {
+        static_assert (Size == k8BitSize || Size == k16BitSize || Size == k32BitSize, "unsupported field size");
+        if constexpr (Size == k8BitSize)
+            return data [0];
+        else if constexpr (Size == k16BitSize)
+            return juce::ByteOrder::littleEndianShort (data);
+        else
+            return juce::ByteOrder::littleEndianInt (data);
+    }
+
+    template <int Size>
+    void writeValue (uint8_t* data, uint32_t value) noexcept
+    {
+        static_assert (Size == k8BitSize || Size == k16BitSize || Size == k32BitSize, "unsupported field size");
+        for (auto byteIndex { 0 }; byteIndex < Size; ++byteIndex)
+            data [byteIndex] = static_cast<uint8_t> (value >> (byteIndex * 8));
+    }
+
+    template <uint8_t Version, size_t FieldIndex>
+    void decodeScalarField (const uint8_t* data, ChannelRecord& channelRecord)
+    {
+        constexpr auto& scalarField { kScalarFields [FieldIndex] };
+        constexpr auto fieldLocation { BusyChunkLayout::kLayout<Version> [scalarField.id] };
+        if constexpr (fieldLocation.isPresent ())
+            scalarField.setValue (channelRecord, readValue<fieldLocation.elementSize> (data + fieldLocation.offset));
+    }
+
+    template <uint8_t Version, size_t FieldIndex>
+    void encodeScalarField (uint8_t* data, const ChannelRecord& channelRecord)
+    {
+        constexpr auto& scalarField { kScalarFields [FieldIndex] };
+        constexpr auto fieldLocation { BusyChunkLayout::kLayout<Version> [scalarField.id] };
+        if constexpr (fieldLocation.isPresent ())
+            writeValue<fieldLocation.elementSize> (data + fieldLocation.offset, scalarField.getValue (channelRecord));
+    }
+
+    template <uint8_t Version, size_t... FieldIndex>
+    void decodeScalarFields (const uint8_t* data, ChannelRecord& channelRecord, std::index_sequence<FieldIndex...>)
+    {
+        (decodeScalarField<Version, FieldIndex> (data, channelRecord), ...);
+    }
+
+    template <uint8_t Version, size_t... FieldIndex>
+    void encodeScalarFields (uint8_t* data, const ChannelRecord& channelRecord, std::index_sequence<FieldIndex...>)
+    {
+        (encodeScalarField<Version, FieldIndex> (data, channelRecord), ...);
+    }
+
+    // the pitch shift cv assign arrived with the pitch shift parameter, and older layouts have unused entries where it would be
+    template <uint8_t Version>
+    constexpr bool hasCvParameter (int parameterId)
+    {
+        constexpr auto& layout { BusyChunkLayout::kLayout<Version> };
+        constexpr auto cvParamsRowLength { layout [FieldId::cvParams].elementCount / BusyChunkLayout::kNumCvInputs };
+        if (parameterId == CvParameterIndex::PitchShift)
+            return layout [FieldId::pitchShift].isPresent ();
+        return parameterId < cvParamsRowLength && parameterId != CvParameterIndex::none2;
+    }
+
+    template <uint8_t Version>
+    constexpr int getCvParamOffset (int cvInputIndex, int parameterId)
+    {
+        constexpr auto cvParams { BusyChunkLayout::kLayout<Version> [FieldId::cvParams] };
+        constexpr auto cvParamsRowLength { cvParams.elementCount / BusyChunkLayout::kNumCvInputs };
+        return cvParams.offset + (((cvInputIndex * cvParamsRowLength) + parameterId) * cvParams.elementSize);
+    }
+
+    template <uint8_t Version>
+    void decodeCvAssigns (const uint8_t* data, ChannelRecord& channelRecord)
+    {
+        constexpr auto cvFlags { BusyChunkLayout::kLayout<Version> [FieldId::cvFlags] };
+        for (auto curCvInputIndex { 0 }; curCvInputIndex < BusyChunkLayout::kNumCvInputs; ++curCvInputIndex)
+        {
+            const auto cvAssignFlags { readValue<cvFlags.elementSize> (data + cvFlags.offset + (curCvInputIndex * cvFlags.elementSize)) };
+            auto& cvInputAssigns { channelRecord.cvAssigns [static_cast<size_t> (curCvInputIndex)] };
+            for (auto parameterId { 0 }; parameterId < ChannelRecord::kNumCvParameters; ++parameterId)
+            {
+                if (! hasCvParameter<Version> (parameterId))
+                    continue;
+                const auto* cvParamData { data + getCvParamOffset<Version> (curCvInputIndex, parameterId) };
+                auto& cvAssign { cvInputAssigns [static_cast<size_t> (parameterId)] };
+                cvAssign.enabled = (cvAssignFlags & CvParameterIndex::getCvEnabledFlag (parameterId)) != 0;
+                cvAssign.offset = static_cast<uint16_t> (readValue<k16BitSize> (cvParamData + 0));
+                cvAssign.attenuation = static_cast<int16_t> (static_cast<uint16_t> (readValue<k16BitSize> (cvParamData + 2))); // signed, sign extend it
+            }
+        }
+    }
+
+    template <uint8_t Version>
+    void encodeCvAssigns (uint8_t* data, const ChannelRecord& channelRecord)
+    {
+        constexpr auto cvFlags { BusyChunkLayout::kLayout<Version> [FieldId::cvFlags] };
+        for (auto curCvInputIndex { 0 }; curCvInputIndex < BusyChunkLayout::kNumCvInputs; ++curCvInputIndex)
+        {
+            // we set bits in cvAssignedFlags for each parameter that has cv enabled
+            uint32_t cvAssignedFlags { CvAssignedFlag::none };
+            const auto& cvInputAssigns { channelRecord.cvAssigns [static_cast<size_t> (curCvInputIndex)] };
+            for (auto parameterId { 0 }; parameterId < ChannelRecord::kNumCvParameters; ++parameterId)
+            {
+                if (! hasCvParameter<Version> (parameterId))
+                    continue;
+                const auto& cvAssign { cvInputAssigns [static_cast<size_t> (parameterId)] };
+                if (cvAssign.enabled)
+                    cvAssignedFlags |= CvParameterIndex::getCvEnabledFlag (parameterId);
+                auto* cvParamData { data + getCvParamOffset<Version> (curCvInputIndex, parameterId) };
+                writeValue<k16BitSize> (cvParamData + 0, cvAssign.offset);
+                writeValue<k16BitSize> (cvParamData + 2, static_cast<uint16_t> (cvAssign.attenuation));
+            }
+            writeValue<cvFlags.elementSize> (data + cvFlags.offset + (curCvInputIndex * cvFlags.elementSize), cvAssignedFlags);
+        }
+    }
+
+    template <uint8_t Version>
+    void decodeCueSets (const uint8_t* data, ChannelRecord& channelRecord)
+    {
+        constexpr auto& layout { BusyChunkLayout::kLayout<Version> };
+        constexpr auto cues { layout [FieldId::cues] };
+        const auto numCues { std::min (readValue<k8BitSize> (data + layout [FieldId::cuesCount].offset), static_cast<uint32_t> (cues.elementCount)) };
+        const auto curCue { readValue<k8BitSize> (data + layout [FieldId::cuesSelected].offset) };
+        // NOTE: the cue set count is updated by setCueSetPoints, so it is not set directly
+        for (uint32_t curCueSetIndex { 0 }; curCueSetIndex < numCues; ++curCueSetIndex)
+        {
+            const auto* cueSetData { data + cues.offset + (curCueSetIndex * cues.elementSize) };
+            const auto startCue { readValue<k32BitSize> (cueSetData + 0) };
+            const auto endCue { readValue<k32BitSize> (cueSetData + 4) };
+            const auto loopCue { readValue<k32BitSize> (cueSetData + 8) };
+            channelRecord.setCueSetPoints (static_cast<int> (curCueSetIndex), startCue, loopCue, endCue);
+        }
+        channelRecord.setCurCueSet (static_cast<int> (curCue));
+    }
+
+    template <uint8_t Version>
+    void encodeCueSets (uint8_t* data, const ChannelRecord& channelRecord)
+    {
+        constexpr auto& layout { BusyChunkLayout::kLayout<Version> };
+        constexpr auto cues { layout [FieldId::cues] };
+        const auto numCues { channelRecord.numCueSets };
+        writeValue<k8BitSize> (data + layout [FieldId::cuesCount].offset, static_cast<uint32_t> (numCues));
+        writeValue<k8BitSize> (data + layout [FieldId::cuesSelected].offset, static_cast<uint32_t> (channelRecord.curCueSet));
+        for (auto curCueSetIndex { 0 }; curCueSetIndex < numCues; ++curCueSetIndex)
+        {
+            const auto& cueSet { channelRecord.cueSets [static_cast<size_t> (curCueSetIndex)] };
+            auto* cueSetData { data + cues.offset + (curCueSetIndex * cues.elementSize) };
+            writeValue<k32BitSize> (cueSetData + 0, cueSet.start);
+            writeValue<k32BitSize> (cueSetData + 4, cueSet.end);
+            writeValue<k32BitSize> (cueSetData + 8, cueSet.loop);
+        }
+    }
+
+    template <uint8_t Version>
+    void decodeReservedFields (const uint8_t* data, ChannelRecord& channelRecord)
+    {
+        // a reserved section that has shrunk since this layout can't be carried over, it is left unset so the current default is used instead
+        for (auto reservedIndex { 0u }; reservedIndex < std::size (kReservedFields); ++reservedIndex)
+        {
+            const auto fieldId { kReservedFields [reservedIndex] };
+            const auto fieldLocation { BusyChunkLayout::kLayout<Version> [fieldId] };
+            if (! fieldLocation.isPresent () || fieldLocation.getSize () > BusyChunkLayout::kLayout<BusyChunkLayout::kCurrentVersion> [fieldId].getSize ())
+                continue;
+            channelRecord.reservedData [reservedIndex] = new ReservedDataRefCounted (data + fieldLocation.offset, static_cast<size_t> (fieldLocation.getSize ()));
+        }
+    }
+
+    template <uint8_t Version>
+    void encodeReservedFields (uint8_t* data, const ChannelRecord& channelRecord)
+    {
+        for (auto reservedIndex { 0u }; reservedIndex < std::size (kReservedFields); ++reservedIndex)
+        {
+            const auto fieldLocation { BusyChunkLayout::kLayout<Version> [kReservedFields [reservedIndex]] };
+            if (! fieldLocation.isPresent ())
+                continue;
+            auto reservedData { channelRecord.reservedData [reservedIndex] };
+            if (reservedData == nullptr)
+                reservedData = SquidChannelProperties::getDefaultReservedData (static_cast<int> (reservedIndex));
+            const auto& reservedBytes { reservedData->getData () };
+            std::memcpy (data + fieldLocation.offset, reservedBytes.getData (), std::min (reservedBytes.getSize (), static_cast<size_t> (fieldLocation.getSize ())));
+        }
+    }
+
+    // reads every field of the given layout version. the signature and version field is checked, and handled, by the caller
+    template <uint8_t Version>
+    void decode (const uint8_t* data, ChannelRecord& channelRecord)
+    {
+        decodeScalarFields<Version> (data, channelRecord, std::make_index_sequence<std::size (kScalarFields)> {});
+        decodeCvAssigns<Version> (data, channelRecord);
+        decodeCueSets<Version> (data, channelRecord);
+        decodeReservedFields<Version> (data, channelRecord);
+    }
+
+    // writes every field of the given layout version, except the signature and version field. data must be kLayout<Version>.size bytes
+    template <uint8_t Version>
+    void encode (uint8_t* data, const ChannelRecord& channelRecord)
+    {
+        encodeScalarFields<Version> (data, channelRecord, std::make_index_sequence<std::size (kScalarFields)> {});
+        encodeCvAssigns<Version> (data, channelRecord);
+        encodeCueSets<Version> (data, channelRecord);
+        encodeReservedFields<Version> (data, channelRecord);
+    }
+
+    template <size_t... LayoutIndex>
+    void decodeVersion (uint8_t version, const uint8_t* data, ChannelRecord& channelRecord, std::index_sequence<LayoutIndex...>)
+    {
+        // use the first layout that covers the version
+        [[maybe_unused]] const auto decoded { ((version <= BusyChunkLayout::kLayoutVersions [LayoutIndex] ? (decode<BusyChunkLayout::kLayoutVersions [LayoutIndex]> (data, channelRecord), true) : false) || ...) };
+    }
+
+    // reads the chunk with the layout for the given metadata version
+    inline void decode (uint8_t version, const uint8_t* data, ChannelRecord& channelRecord)
+    {
+        jassert (version >= BusyChunkLayout::kFirstSupportedVersion);
+        decodeVersion (version, data, channelRecord, std::make_index_sequence<std::size (BusyChunkLayout::kLayoutVersions)> {});
+    }
+};
@@ -0,0 +1,182 @@
+#pragma once
+
+#include <JuceHeader.h>
+#include "SquidSalmpleDefs.h"
+
+// BusyChunkLayout - the layout of the Squid Salmple 'busy' metadata chunk, described once as a table of fields in the order they are stored.
+// the field offsets for any metadata version are computed from the table at compile time, so a field that changed between firmware versions is
+// just another row with a different version range
+namespace BusyChunkLayout
+{
+    constexpr uint8_t kFirstSupportedVersion { 115 }; // version 114 can't be read
+    constexpr uint8_t kPitchShiftVersion { 119 }; // firmware 1.90 added pitch shift, and an extra cv parameter
+    constexpr uint8_t kCurrentVersion { static_cast<uint8_t> (kSignatureAndVersionCurrent & 0xFF) };
+    constexpr uint8_t kLastVersion { 255 };
+
+    enum class FieldId
+    {
+        signatureAndVersion,
+        reserved1,
+        sampleStart,
+        reserved2,
+        sampleEnd,
+        endOfData,
+        quality,
+        loop, // NONE, NORMAL, ZIGZAG, GATE, ZIGZAG_GATE
+        reserved3,
+        loopPosition,
+        reserved4,
+        xfade,
+        reverse,
+        reserved5,
+        decay,
+        attack,
+        reserved6,
+        cutoffFrequency, // frequency in the upper 12 bits, filter type in the lower 4
+        resonance,
+        rate,
+        reserved7,
+        speed,
+        level,
+        channelSource,
+        recDest,
+        reserved8,
+        cvFlags, // a bit mask of the enabled parameters for each cv input
+        cvParams, // offset and attenuation for each parameter of each cv input
+        reserved9,
+        channelFlags,
+        stepTrigCur,
+        stepTrigNum, // Off, 2, 3, 4, 5, 6, 7 ,8
+        reserved10,
+        externalTrigger, // Off, > 1, > 2, > 3, > 4, > 5, > 6, > 7, > 8, On
+        quantizeMode, // none, chromatic, octave, major, minor, harmonicMinor, pentatonicMajor, pentatonicMinor, lydian, phrygian, japanese, rootAndFifth, oneChord, fourChord, fiveChord
+        reserved11,
+        choke, // C1, C2, C3, C4, C5, C6, C7, C8
+        reserved12,
+        cues, // start, end, loop for each cue set
+        cuesCount,
+        cuesQueued,
+        cuesSelected,
+        reserved13,
+        pitchShift,
+        reserved14,
+        reserved15,
+        numFields
+    };
+    constexpr auto kNumFields { static_cast<size_t> (FieldId::numFields) };
+
+    struct FieldDescription
+    {
+        FieldId id;
+        int elementSize { 0 };
+        int elementCount { 1 };
+        uint8_t firstVersion { kFirstSupportedVersion };
+        uint8_t lastVersion { kLastVersion };
+    };
+
+    constexpr auto kNumCvInputs { kCvInputsCount + kCvInputsExtra };
+    constexpr auto kCvParamEntrySize { 2 * k16BitSize }; // offset, attenuation
+    constexpr auto kCueSetEntrySize { 3 * k32BitSize }; // start, end, loop
+
+    // every field, in the order it is stored in the chunk
+    constexpr FieldDescription kFieldDescriptions []
+    {
+        { FieldId::signatureAndVersion, k32BitSize },
+        { FieldId::reserved1, k8BitSize, 4 },
+        { FieldId::sampleStart, k32BitSize },
+        { FieldId::reserved2, k8BitSize, 4 },
+        { FieldId::sampleEnd, k32BitSize },
+        { FieldId::endOfData, k32BitSize },
+        { FieldId::quality, k8BitSize },
+        { FieldId::loop, k8BitSize },
+        { FieldId::reserved3, k8BitSize, 2 },
+        { FieldId::loopPosition, k32BitSize },
+        { FieldId::reserved4, k8BitSize, 5 },
+        { FieldId::xfade, k8BitSize },
+        { FieldId::reverse, k8BitSize },
+        { FieldId::reserved5, k8BitSize, 5 },
+        { FieldId::decay, k16BitSize },
+        { FieldId::attack, k16BitSize },
+        { FieldId::reserved6, k8BitSize, 2 },
+        { FieldId::cutoffFrequency, k16BitSize },
+        { FieldId::resonance, k16BitSize },
+        { FieldId::rate, k8BitSize },
+        { FieldId::reserved7, k8BitSize, 3 },
+        { FieldId::speed, k16BitSize },
+        { FieldId::level, k16BitSize },
+        { FieldId::channelSource, k8BitSize },
+        { FieldId::recDest, k8BitSize },
+        { FieldId::reserved8, k8BitSize, 12 },
+        { FieldId::cvFlags, k16BitSize, kNumCvInputs, kFirstSupportedVersion, kPitchShiftVersion - 1 },
+        { FieldId::cvFlags, k32BitSize, kNumCvInputs, kPitchShiftVersion },
+        { FieldId::cvParams, kCvParamEntrySize, kNumCvInputs * (kCvParamsCount_186 + kCvParamsExtra), kFirstSupportedVersion, kPitchShiftVersion - 1 },
+        { FieldId::cvParams, kCvParamEntrySize, kNumCvInputs * (kCvParamsCount_190 + kCvParamsExtra), kPitchShiftVersion },
+        { FieldId::reserved9, k8BitSize, (kCvParamsCount_186 + kCvParamsExtra) * k32BitSize, kFirstSupportedVersion, kPitchShiftVersion - 1 },
+        { FieldId::reserved9, k8BitSize, (kCvParamsCount_190 + kCvParamsExtra) * k32BitSize, kPitchShiftVersion },
+        { FieldId::channelFlags, k16BitSize },
+        { FieldId::stepTrigCur, k8BitSize },
+        { FieldId::stepTrigNum, k8BitSize },
+        { FieldId::reserved10, k8BitSize, 2 },
+        { FieldId::externalTrigger, k8BitSize },
+        { FieldId::quantizeMode, k8BitSize },
+        { FieldId::reserved11, k8BitSize },
+        { FieldId::choke, k8BitSize },
+        { FieldId::reserved12, k8BitSize, 2 },
+        { FieldId::cues, kCueSetEntrySize, kCueNumSets },
+        { FieldId::cuesCount, k8BitSize },
+        { FieldId::cuesQueued, k8BitSize },
+        { FieldId::cuesSelected, k8BitSize },
+        { FieldId::reserved13, k8BitSize, 253, kFirstSupportedVersion, kPitchShiftVersion - 1 },
+        { FieldId::reserved13, k8BitSize, 1, kPitchShiftVersion }, // alignment padding
+        { FieldId::pitchShift, k16BitSize, 1, kPitchShiftVersion },
+        { FieldId::reserved14, k8BitSize, 2, kPitchShiftVersion }, // padding
+        { FieldId::reserved15, k8BitSize, 62 * k32BitSize, kPitchShiftVersion },
+    };
+
+    struct FieldLocation
+    {
+        int offset { -1 }; // -1 when the field is not in this version
+        int elementSize { 0 };
+        int elementCount { 0 };
+
+        constexpr bool isPresent () const { return offset >= 0; }
+        constexpr int getSize () const { return elementSize * elementCount; }
+    };
+
+    struct Layout
+    {
+        std::array<FieldLocation, kNumFields> fields {};
+        int size { 0 };
+
+        constexpr const FieldLocation& operator[] (FieldId fieldId) const { return fields [static_cast<size_t> (fieldId)]; }
+    };
+
+    constexpr Layout makeLayout (uint8_t version)
+    {
+        Layout layout;
+        for (const auto& fieldDescription : kFieldDescriptions)
+        {
+            if (version < fieldDescription.firstVersion || version > fieldDescription.lastVersion)
+                continue;
+            auto& fieldLocation { layout.fields [static_cast<size_t> (fieldDescription.id)] };
+            fieldLocation.offset = layout.size;
+            fieldLocation.elementSize = fieldDescription.elementSize;
+            fieldLocation.elementCount = fieldDescription.elementCount;
+            layout.size += fieldDescription.elementSize * fieldDescription.elementCount;
+        }
+        return layout;
+    }
+
+    template <uint8_t Version>
+    inline constexpr Layout kLayout { makeLayout (Version) };
+
+    // the expected chunk size for a metadata version only known at runtime
+    constexpr int getLayoutSize (uint8_t version) { return makeLayout (version).size; }
+
+    // the last metadata version of each distinct layout, oldest first. a version is read with the first layout that covers it
+    constexpr uint8_t kLayoutVersions [] { kPitchShiftVersion - 1, kLastVersion };
+
+    static_assert (kLayout<kPitchShiftVersion - 1>.size == 1848, "firmware 1.86 busy chunk size changed");
+    static_assert (kLayout<kCurrentVersion>.size == 1936, "firmware 1.90 busy chunk size changed");
+    static_assert (kLayout<kCurrentVersion>.size == kLayout<kLastVersion>.size, "the current version must use the latest layout");
+};
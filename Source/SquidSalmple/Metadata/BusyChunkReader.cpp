@@ -2,45 +2,57 @@
 
 bool BusyChunkReader::readMetaData (juce::File sampleFile, juce::MemoryBlock& busyChunkData)
 {
-    // TODO - handle error conditions
     auto sampleInputStream { sampleFile.createInputStream () };
     jassert (sampleInputStream != nullptr && sampleInputStream->openedOk ());
-    auto busyChunkLocated { findChunk (sampleInputStream.get (), kBusyChunkType) };
-    if (! busyChunkLocated.has_value ())
+    if (sampleInputStream == nullptr || ! sampleInputStream->openedOk ())
         return false;
-    sampleInputStream->readIntoMemoryBlock (busyChunkData, busyChunkLocated.value ());
-    return true;
+    return readMetaData (*sampleInputStream, busyChunkData);
+}
+
+bool BusyChunkReader::readMetaData (juce::InputStream& sampleInputStream, juce::MemoryBlock& busyChunkData)
+{
+    // the busy chunk is normally the last chunk inside the RIFF chunk, but files written by older versions have it appended after the RIFF chunk.
+    // findChunk does not stop at the end of the RIFF chunk, so both are found
+    if (! enterWaveChunk (&sampleInputStream))
+        return false;
+    auto busyChunkLocated { findChunk (&sampleInputStream, kBusyChunkType) };
+    if (! busyChunkLocated.has_value () || busyChunkLocated.value () > getBytesRemaining (&sampleInputStream))
+        return false;
+    const auto bytesRead { sampleInputStream.readIntoMemoryBlock (busyChunkData, busyChunkLocated.value ()) };
+    return bytesRead == busyChunkLocated.value ();
 }
 
 BusyChunkReader::MarkerList BusyChunkReader::getMarkerList (juce::File sampleFile)
 {
     auto sampleInputStream { sampleFile.createInputStream () };
     jassert (sampleInputStream != nullptr && sampleInputStream->openedOk ());
-    // locate RIFF chunk (should be first?)
-    auto riffChunkLocated { findChunk (sampleInputStream.get (), kRIFFChunkType) };
-    if (! riffChunkLocated.has_value ())
+    if (sampleInputStream == nullptr || ! sampleInputStream->openedOk ())
         return {};
-    // read RIFF format identifier
-    char riffFormat [4];
-    if (sampleInputStream->read (&riffFormat, 4) != 4)
-        return {};
-    // verify is WAVE format
-    if (std::memcmp (kWAVEFormatId, riffFormat, 4) != 0)
+    return getMarkerList (*sampleInputStream);
+}
+
+BusyChunkReader::MarkerList BusyChunkReader::getMarkerList (juce::InputStream& sampleInputStream)
+{
+    if (! enterWaveChunk (&sampleInputStream))
         return {};
     // locate the marker list chunk
-    auto markersChunkLocated { findChunk (sampleInputStream.get (), kMarkerListChunkType) };
-    if (! markersChunkLocated.has_value ())
+    auto markersChunkLocated { findChunk (&sampleInputStream, kMarkerListChunkType) };
+    if (! markersChunkLocated.has_value () || markersChunkLocated.value () < kSizeOfMarkerCount || markersChunkLocated.value () > getBytesRemaining (&sampleInputStream))
         return {};
     // read in the entire markers chunk
     juce::MemoryBlock markersChunkData;
-    auto bytesRead { sampleInputStream->readIntoMemoryBlock (markersChunkData, markersChunkLocated.value ()) };
+    auto bytesRead { sampleInputStream.readIntoMemoryBlock (markersChunkData, markersChunkLocated.value ()) };
     if (bytesRead != markersChunkLocated.value ())
         return {};
-    uint8_t* markersChunkDataPtr { static_cast<uint8_t*> (markersChunkData.getData ()) };
+    const auto* markersChunkDataPtr { static_cast<const uint8_t*> (markersChunkData.getData ()) };
     // first 4 bytes are number of markers (little endian)
-    uint32_t numMarkers { juce::ByteOrder::swapIfBigEndian (*reinterpret_cast<uint32_t*> (markersChunkDataPtr)) };
-    markersChunkDataPtr += sizeof (uint32_t);
+    const auto numMarkers { juce::ByteOrder::littleEndianInt (markersChunkDataPtr) };
+    markersChunkDataPtr += kSizeOfMarkerCount;
+    // don't trust the count, it must fit in the chunk
+    if (numMarkers > (markersChunkData.getSize () - kSizeOfMarkerCount) / kSizeOfCuePoint)
+        return {};
     MarkerList markerList;
+    markerList.reserve (numMarkers);
     for (uint32_t curMarker { 0 }; curMarker < numMarkers; ++curMarker)
     {
         // typedef struct {
@@ -53,39 +65,54 @@ BusyChunkReader::MarkerList BusyChunkReader::getMarkerList (juce::File sampleFil
         // } CuePoint;
         //
         // I am assuming that the Squid only reads the most simple of WAV files, and does not use the Playlist Chunk
-        // which means that all I need to grab out of here is the dwPosition (sample position) value
-        // first lets skip over the dwIndentifier field
-        markersChunkDataPtr += sizeof (uint32_t);
-        // put sample offset into list
-        markerList.emplace_back (juce::ByteOrder::swapIfBigEndian (*reinterpret_cast<uint32_t*> (markersChunkDataPtr)));
-        // skip over sample offset and remaining data members
-        constexpr auto kSizeOfFccChunkID { 4 };
-        markersChunkDataPtr += sizeof (uint32_t) + kSizeOfFccChunkID + (sizeof (uint32_t) * 3);
+        // which means that all I need to grab out of here is the dwPosition (sample position) value, which follows the dwIdentifier field
+        markerList.emplace_back (juce::ByteOrder::littleEndianInt (markersChunkDataPtr + sizeof (uint32_t)));
+        markersChunkDataPtr += kSizeOfCuePoint;
     }
-    return markerList; // return dummy list for test
+    return markerList;
+}
+
+// positions the stream at the first chunk inside the RIFF chunk, if it is a WAVE file
+bool BusyChunkReader::enterWaveChunk (juce::InputStream* is)
+{
+    // locate RIFF chunk (should be first?)
+    auto riffChunkLocated { findChunk (is, kRIFFChunkType) };
+    if (! riffChunkLocated.has_value ())
+        return false;
+    // read RIFF format identifier
+    char riffFormat [4];
+    if (is->read (&riffFormat, 4) != 4)
+        return false;
+    // verify is WAVE format
+    return std::memcmp (kWAVEFormatId, riffFormat, 4) == 0;
 }
 
 std::optional<uint32_t> BusyChunkReader::findChunk (juce::InputStream* is, char* chunkType)
 {
-    auto chunkLocated { false };
-    auto chunkLength { 0 };
-    while (! chunkLocated)
+    // every pass reads a chunk header, and either returns or moves forward past the chunk, so this always ends at the end of the stream
+    while (true)
     {
         const auto chunk { getChunkData (is) };
         if (! chunk.has_value ())
-            break;
+            return std::nullopt;
         const auto chunkInfo { chunk.value () };
-        if (std::memcmp (chunkType, chunkInfo.chunkType, 4) != 0)
-        {
-            const auto bytesToSkip { (chunkInfo.chunkLength & 1) == 0 ? chunkInfo.chunkLength : chunkInfo.chunkLength + 1 };
-            const auto seekSuccess { is->setPosition (is->getPosition () + bytesToSkip) };
-            jassert (seekSuccess);
-            continue;
-        }
-        chunkLength = chunkInfo.chunkLength;
-        chunkLocated = true;
+        if (std::memcmp (chunkType, chunkInfo.chunkType, 4) == 0)
+            return chunkInfo.chunkLength;
+
+        // a length running past the end of the stream means the file is truncated, or this is not really a chunk header
+        const auto bytesToSkip { static_cast<juce::int64> (chunkInfo.chunkLength) + (chunkInfo.chunkLength & 1) };
+        if (bytesToSkip > getBytesRemaining (is) || ! is->setPosition (is->getPosition () + bytesToSkip))
+            return std::nullopt;
     }
-    return chunkLocated ? std::optional<uint32_t> { chunkLength } : std::nullopt;
+}
+
+juce::int64 BusyChunkReader::getBytesRemaining (juce::InputStream* is)
+{
+    const auto totalLength { is->getTotalLength () };
+    // NOTE: streams of unknown length are not limited here, reads past the end will just come up short
+    if (totalLength < 0)
+        return std::numeric_limits<juce::int64>::max ();
+    return std::max (juce::int64 { 0 }, totalLength - is->getPosition ());
 }
 
 std::optional<BusyChunkReader::ChunkInfo> BusyChunkReader::getChunkData (juce::InputStream* is)
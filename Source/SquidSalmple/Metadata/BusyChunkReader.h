@@ -11,17 +11,25 @@ public:
     bool readMetaData (juce::File sampleFile, juce::MemoryBlock& busyChunkData);
     MarkerList getMarkerList (juce::File sampleFile);
 
+    // the stream versions parse from the current position, and fail cleanly on truncated or malformed data
+    bool readMetaData (juce::InputStream& sampleInputStream, juce::MemoryBlock& busyChunkData);
+    MarkerList getMarkerList (juce::InputStream& sampleInputStream);
+
 private:
     static inline char kBusyChunkType [4] { 'b', 'u', 's', 'y' };
     static inline char kRIFFChunkType [4] { 'R', 'I', 'F', 'F' };
     static inline char kWAVEFormatId [4] { 'W', 'A', 'V', 'E' };
     static inline char kMarkerListChunkType [4] { 'c', 'u', 'e', ' ' };
+    static constexpr uint32_t kSizeOfMarkerCount { 4 };
+    static constexpr uint32_t kSizeOfCuePoint { 24 };
     struct ChunkInfo
     {
         char chunkType [4];
         uint32_t chunkLength { 0 };
     };
 
+    bool enterWaveChunk (juce::InputStream* is);
     std::optional<uint32_t> findChunk (juce::InputStream* is, char* chunkType);
     std::optional<ChunkInfo> getChunkData (juce::InputStream* is);
+    juce::int64 getBytesRemaining (juce::InputStream* is);
 };
\ No newline at end of file
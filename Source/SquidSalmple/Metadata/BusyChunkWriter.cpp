@@ -1,53 +1,76 @@
 #include "BusyChunkWriter.h"
+#include "../../Utility/SampleConversion.h"
 
-// TODO - handle error conditions
+// writes a 44.1k, 16 bit, mono WAV file, with the busy chunk as the last chunk inside the RIFF chunk. all of the chunk sizes are
+// known before anything is written, so the file is written front to back in one pass, and nothing has to be patched afterwards
 bool BusyChunkWriter::write (juce::AudioBuffer<float>& audioBuffer, juce::File outputSampleFile, juce::MemoryBlock& busyChunkData)
 {
-    // write audio data
-    {
-        // create/open temp file
-        auto outputSampleStream { outputSampleFile.createOutputStream () };
-        jassert (outputSampleStream != nullptr && outputSampleStream->openedOk ());
-        outputSampleStream->setPosition (0);
-        outputSampleStream->truncate ();
-        juce::WavAudioFormat wavAudioFormat;
-        std::unique_ptr<juce::AudioFormatWriter> writer { wavAudioFormat.createWriterFor (outputSampleStream.release (), 44100.0, 1, 16, {}, 0) };
-        jassert (writer != nullptr);
-        if (writer == nullptr)
-            return false;
-        auto writeSuccess { writer->writeFromAudioSampleBuffer (audioBuffer, 0, audioBuffer.getNumSamples ()) };
-        jassert (writeSuccess == true);
-        if (writeSuccess == false)
-            return false;
-    }
+    jassert (audioBuffer.getNumChannels () > 0);
+    if (audioBuffer.getNumChannels () == 0)
+        return false;
+
+    const auto numSamples { audioBuffer.getNumSamples () };
+    const auto dataChunkLength { static_cast<uint32_t> (numSamples) * kBytesPerSample };
+    const auto busyChunkLength { static_cast<uint32_t> (busyChunkData.getSize ()) };
+    const auto riffChunkLength { 4 + (kChunkHeaderSize + kFormatChunkLength) +
+                                 (kChunkHeaderSize + getPaddedLength (dataChunkLength)) +
+                                 (kChunkHeaderSize + getPaddedLength (busyChunkLength)) };
 
-    // write metadata
     auto outputSampleStream { outputSampleFile.createOutputStream () };
     jassert (outputSampleStream != nullptr && outputSampleStream->openedOk ());
-    auto positionAtEndSuccess { outputSampleStream->setPosition (outputSampleFile.getSize ()) };
-    jassert (positionAtEndSuccess == true);
-    // write new busy chunk identifier
-    auto writeSuccess = outputSampleStream->write (kBusyChunkType, 4);
+    if (outputSampleStream == nullptr || ! outputSampleStream->openedOk ())
+        return false;
+    outputSampleStream->setPosition (0);
+    outputSampleStream->truncate ();
+
+    auto writeSuccess { writeChunkHeader (*outputSampleStream, kRIFFChunkType, riffChunkLength) &&
+                        outputSampleStream->write (kWAVEFormatId, 4) &&
+                        writeChunkHeader (*outputSampleStream, kFormatChunkType, kFormatChunkLength) &&
+                        outputSampleStream->writeShort (1) && // PCM
+                        outputSampleStream->writeShort (kNumChannels) &&
+                        outputSampleStream->writeInt (kSampleRate) &&
+                        outputSampleStream->writeInt (kSampleRate * kBytesPerSample * kNumChannels) &&
+                        outputSampleStream->writeShort (kBytesPerSample * kNumChannels) &&
+                        outputSampleStream->writeShort (kBytesPerSample * 8) &&
+                        writeChunkHeader (*outputSampleStream, kDataChunkType, dataChunkLength) };
     jassert (writeSuccess == true);
-    // write length
-    uint32_t chunkLength { juce::ByteOrder::swapIfBigEndian (static_cast<uint32_t> (busyChunkData.getSize ())) };
-    writeSuccess = outputSampleStream->write (&chunkLength, 4);
+    if (! writeSuccess)
+        return false;
+
+    // write audio data, converting a block at a time
+    const auto* sourceSamples { audioBuffer.getReadPointer (0) };
+    std::array<int16_t, kConversionBlockSize> convertedSamples;
+    for (auto sampleIndex { 0 }; sampleIndex < numSamples && writeSuccess; sampleIndex += kConversionBlockSize)
+    {
+        const auto samplesInBlock { std::min (kConversionBlockSize, numSamples - sampleIndex) };
+        SampleConversion::floatToInt16 (sourceSamples + sampleIndex, convertedSamples.data (), samplesInBlock);
+        writeSuccess = outputSampleStream->write (convertedSamples.data (), static_cast<size_t> (samplesInBlock) * kBytesPerSample);
+    }
     jassert (writeSuccess == true);
-    // write new busyChunk
-    writeSuccess = outputSampleStream->write (busyChunkData.getData (), busyChunkData.getSize ());
+    if (! writeSuccess)
+        return false;
+
+    // write metadata
+    writeSuccess = writePadByte (*outputSampleStream, dataChunkLength) &&
+                   writeChunkHeader (*outputSampleStream, kBusyChunkType, busyChunkLength) &&
+                   outputSampleStream->write (busyChunkData.getData (), busyChunkData.getSize ()) &&
+                   writePadByte (*outputSampleStream, busyChunkLength);
     jassert (writeSuccess == true);
-    return true;
+    if (! writeSuccess)
+        return false;
+
+    outputSampleStream->flush ();
+    jassert (outputSampleStream->getStatus ().wasOk ());
+    return outputSampleStream->getStatus ().wasOk ();
+}
+
+bool BusyChunkWriter::writeChunkHeader (juce::OutputStream& outputStream, const char* chunkType, uint32_t chunkLength)
+{
+    return outputStream.write (chunkType, 4) && outputStream.writeInt (static_cast<int> (chunkLength));
 }
 
-std::optional<BusyChunkWriter::ChunkInfo> BusyChunkWriter::getChunkData (juce::InputStream* is)
+bool BusyChunkWriter::writePadByte (juce::OutputStream& outputStream, uint32_t chunkLength)
 {
-    ChunkInfo chunkInfo;
-    if (is->read (&chunkInfo.chunkType, 4) != 4)
-        return std::nullopt;
-    uint32_t chunkLength { 0 };
-    if (is->read (&chunkLength, 4) != 4)
-        return std::nullopt;
-    chunkInfo.chunkLength = juce::ByteOrder::swapIfBigEndian (chunkLength);
-
-    return chunkInfo;
+    // RIFF chunks are word aligned
+    return (chunkLength & 1) == 0 || outputStream.writeByte (0);
 }
@@ -12,11 +12,18 @@ public:
 
 private:
     static inline char kBusyChunkType [4] { 'b', 'u', 's', 'y' };
-    struct ChunkInfo
-    {
-        char chunkType [4];
-        uint32_t chunkLength { 0 };
-    };
+    static inline char kRIFFChunkType [4] { 'R', 'I', 'F', 'F' };
+    static inline char kWAVEFormatId [4] { 'W', 'A', 'V', 'E' };
+    static inline char kFormatChunkType [4] { 'f', 'm', 't', ' ' };
+    static inline char kDataChunkType [4] { 'd', 'a', 't', 'a' };
+    static constexpr uint32_t kChunkHeaderSize { 8 };
+    static constexpr uint32_t kFormatChunkLength { 16 };
+    static constexpr int kSampleRate { 44100 };
+    static constexpr int kNumChannels { 1 };
+    static constexpr int kBytesPerSample { 2 };
+    static constexpr int kConversionBlockSize { 4096 };
 
-    std::optional<ChunkInfo> getChunkData (juce::InputStream* is);
-};
\ No newline at end of file
+    static constexpr uint32_t getPaddedLength (uint32_t chunkLength) { return chunkLength + (chunkLength & 1); }
+    bool writeChunkHeader (juce::OutputStream& outputStream, const char* chunkType, uint32_t chunkLength);
+    bool writePadByte (juce::OutputStream& outputStream, uint32_t chunkLength);
+};
@@ -1,10 +1,11 @@
 #include "SquidMetaDataReader.h"
+#include "BusyChunkCodec.h"
 #include "BusyChunkReader.h"
 #include "SquidSalmpleDefs.h"
-#include "../CvParameterProperties.h"
-#include "../SquidChannelProperties.h"
+#include "../ChannelRecord.h"
 #include "../../Utility/DebugLog.h"
 #include "../../Utility/DumpStack.h"
+#include "../../Utility/Trace.h"
 
 #define LOG_READER 0
 #if LOG_READER
@@ -13,51 +14,63 @@
 #define LogReader(text) ;
 #endif
 
-enum class MetaDataStatus
+bool SquidMetaDataReader::decodeMetaData (const juce::MemoryBlock& busyChunkData, ChannelRecord& channelRecord)
 {
-    invalid,
-    fw186,
-    latest
-};
+    if (busyChunkData.getSize () < k32BitSize)
+    {
+        juce::Logger::outputDebugString ("'busy' metadata chunk is too small");
+        return false;
+    }
+    const auto* data { static_cast<const uint8_t*> (busyChunkData.getData ()) };
+    const auto busyChunkVersion { BusyChunkCodec::readValue<k32BitSize> (data) };
+    if ((busyChunkVersion & 0xFFFFFF00) != (kSignatureAndVersionCurrent & 0xFFFFFF00))
+    {
+        juce::Logger::outputDebugString ("'busy' metadata chunk has wrong signature");
+        return false;
+    }
+    const auto metaDataVersion { static_cast<uint8_t> (busyChunkVersion & 0x000000FF) };
+    channelRecord.loadedVersion = metaDataVersion;
+    if (metaDataVersion < BusyChunkLayout::kFirstSupportedVersion) // I know I can't read in 114, so I am assuming I can read in anything after that
+    {
+        juce::Logger::outputDebugString ("Unsupported version. Reverting to default metadata");
+        return false;
+    }
+    if (busyChunkData.getSize () < static_cast<size_t> (BusyChunkLayout::getLayoutSize (metaDataVersion)))
+    {
+        juce::Logger::outputDebugString ("'busy' metadata chunk is too small for version " + juce::String (metaDataVersion));
+        return false;
+    }
+    BusyChunkCodec::decode (metaDataVersion, data, channelRecord);
+    return true;
+}
 
-void SquidMetaDataReader::read (juce::ValueTree channelPropertiesVT, juce::File sampleFile, uint8_t channelIndex)
+void SquidMetaDataReader::read (ChannelRecord& channelRecord, juce::File sampleFile, uint8_t channelIndex)
 {
+    TRACE_SPAN ("SquidMetaDataReader::read");
     LogReader ("read - reading: " + juce::String (sampleFile.getFullPathName ()));
-    SquidChannelProperties squidChannelProperties { channelPropertiesVT, SquidChannelProperties::WrapperType::owner, SquidChannelProperties::EnableCallbacks::no };
     BusyChunkReader busyChunkReader;
     busyChunkData.reset ();
-    auto metaDataStatus { MetaDataStatus::invalid };
+    auto hasMetaData { false };
     if (busyChunkReader.readMetaData (sampleFile, busyChunkData))
     {
         LogReader (sampleFile.getFileName () + " contains metadata");
-        const auto busyChunkVersion { getValue <SquidSalmple::DataLayout_186::kBusyChunkSignatureAndVersionSize> (SquidSalmple::DataLayout_186::kBusyChunkSignatureAndVersionOffset) };
-        if ((busyChunkVersion & 0xFFFFFF00) != (kSignatureAndVersionCurrent & 0xFFFFFF00))
-        {
-            juce::Logger::outputDebugString ("'busy' metadata chunk has wrong signature");
-        }
-        else
-        {
-            const auto metaDataVersion { static_cast<uint8_t> (busyChunkVersion & 0x000000FF) };
-            squidChannelProperties.setLoadedVersion (metaDataVersion, false);
-            if (metaDataVersion < 115) // I know I can't read in 114, so I am assuming I can read in anything after that
-                juce::Logger::outputDebugString ("Unsupported version. Reverting to default metadata");
-            else if (metaDataVersion < static_cast<uint8_t> (kSignatureAndVersionCurrent & 0xFF)) // currently 119
-                metaDataStatus = MetaDataStatus::fw186;
-            else
-                metaDataStatus = MetaDataStatus::latest;
-        }
+        hasMetaData = decodeMetaData (busyChunkData, channelRecord);
     }
 
-    // METADATA IS THE LATEST
-    if (metaDataStatus == MetaDataStatus::latest)
+    if (hasMetaData)
     {
-        LogReader (sampleFile.getFileName () + " has metadata version 119 or newer");
-        squidChannelProperties.setAttack (getValue <SquidSalmple::DataLayout_190::kAttackSize> (SquidSalmple::DataLayout_190::kAttackOffset), false);
-        squidChannelProperties.setBits (getValue <SquidSalmple::DataLayout_190::kQualitySize> (SquidSalmple::DataLayout_190::kQualityOffset), false);
-        squidChannelProperties.setChannelFlags (getValue <SquidSalmple::DataLayout_190::kChannelFlagsSize> (SquidSalmple::DataLayout_190::kChannelFlagsOffset), false);
-        jassert (! ((squidChannelProperties.getChannelFlags () & ChannelFlags::kCueRandom) && (squidChannelProperties.getChannelFlags () & ChannelFlags::kCueStepped)));
+        const auto metaDataVersion { channelRecord.loadedVersion };
+        LogReader (sampleFile.getFileName () + " has metadata version " + juce::String (metaDataVersion));
+        if (metaDataVersion < BusyChunkLayout::kPitchShiftVersion)
+        {
+            // NOTE: since importing an old version of metadata is a new feature (v1.3), I'm going to write this to the log file so we can track when this happens
+            // assuming there are no issues I will remove this in a subsequent release
+            DebugLog ("SquidMetaDataReader", "importing metadata version " + juce::String (metaDataVersion) + " from " + sampleFile.getFileName ());
+        }
+
+        jassert (! ((channelRecord.channelFlags & ChannelFlags::kCueRandom) && (channelRecord.channelFlags & ChannelFlags::kCueStepped)));
 #if JUCE_DEBUG
-        const auto channelFlags { squidChannelProperties.getChannelFlags () };
+        const auto channelFlags { channelRecord.channelFlags };
         juce::String channelFlagsString;
         if (channelFlags == 0)
         {
@@ -85,61 +98,10 @@ void SquidMetaDataReader::read (juce::ValueTree channelPropertiesVT, juce::File
 
         LogReader ("Channel Flags: " + channelFlagsString);
 #endif
-        squidChannelProperties.setChannelSource (getValue <SquidSalmple::DataLayout_190::kChannelSourceSize> (SquidSalmple::DataLayout_190::kChannelSourceOffset), false);
-        squidChannelProperties.setChoke (getValue <SquidSalmple::DataLayout_190::kChokeSize> (SquidSalmple::DataLayout_190::kChokeOffset), false);
-        squidChannelProperties.setDecay (getValue <SquidSalmple::DataLayout_190::kDecaySize> (SquidSalmple::DataLayout_190::kDecayOffset), false);
-        squidChannelProperties.setEndCue (getValue <SquidSalmple::DataLayout_190::kSampleEndSize> (SquidSalmple::DataLayout_190::kSampleEndOffset), false);
-        squidChannelProperties.setEndOfData (getValue <SquidSalmple::DataLayout_190::kEndOfDataSize> (SquidSalmple::DataLayout_190::kEndOFDataOffset), false);
-        squidChannelProperties.setETrig (getValue <SquidSalmple::DataLayout_190::kExternalTriggerSize> (SquidSalmple::DataLayout_190::kExternalTriggerOffset), false);
-        uint16_t frequencyAndType { getValue <SquidSalmple::DataLayout_190::kCutoffFrequencySize> (SquidSalmple::DataLayout_190::kCutoffFrequencyOffset) };
-        squidChannelProperties.setFilterType (frequencyAndType & 0x000F, false);
-        squidChannelProperties.setFilterFrequency (frequencyAndType >> 4, false);
-        squidChannelProperties.setFilterResonance (getValue <SquidSalmple::DataLayout_190::kResonanceSize> (SquidSalmple::DataLayout_190::kResonanceOffset), false);
-        squidChannelProperties.setLevel (getValue <SquidSalmple::DataLayout_190::kLevelSize> (SquidSalmple::DataLayout_190::kLevelOffset), false);
-        squidChannelProperties.setLoopCue (getValue <SquidSalmple::DataLayout_190::kLoopPositionSize> (SquidSalmple::DataLayout_190::kLoopPositionOffset), false);
-        squidChannelProperties.setLoopMode (getValue <SquidSalmple::DataLayout_190::kLoopSize> (SquidSalmple::DataLayout_190::kLoopOffset), false);
-        squidChannelProperties.setQuant (getValue <SquidSalmple::DataLayout_190::kQuantizeModeSize> (SquidSalmple::DataLayout_190::kQuantizeModeOffset), false);
-        squidChannelProperties.setPitchShift (getValue<SquidSalmple::DataLayout_190::kPitchShiftSize> (SquidSalmple::DataLayout_190::kPitchShiftOffset), false);
-        squidChannelProperties.setRate (getValue <SquidSalmple::DataLayout_190::kRateSize> (SquidSalmple::DataLayout_190::kRateOffset), false);
-        squidChannelProperties.setRecDest (getValue <SquidSalmple::DataLayout_190::kRecDestSize> (SquidSalmple::DataLayout_190::kRecDestOffset), false);
-        squidChannelProperties.setReverse (getValue <SquidSalmple::DataLayout_190::kReverseSize> (SquidSalmple::DataLayout_190::kReverseOffset), false);
-        squidChannelProperties.setSpeed (getValue <SquidSalmple::DataLayout_190::kSpeedSize> (SquidSalmple::DataLayout_190::kSpeedOffset), false);
-        squidChannelProperties.setStartCue (getValue <SquidSalmple::DataLayout_190::kSampleStartSize> (SquidSalmple::DataLayout_190::kSampleStartOffset), false);
-        squidChannelProperties.setSteps (getValue<SquidSalmple::DataLayout_190::kStepTrigNumSize> (SquidSalmple::DataLayout_190::kStepTrigNumOffset), false);
-        squidChannelProperties.setXfade (getValue <SquidSalmple::DataLayout_190::kXfadeSize> (SquidSalmple::DataLayout_190::kXfadeOffset), false);
-
-        ////////////////////////////////////
-        // cv assign
-        constexpr auto rowSize { (kCvParamsCount_190 + kCvParamsExtra) * 4 };
-        for (auto curCvInputIndex { 0 }; curCvInputIndex < kCvInputsCount + kCvInputsExtra; ++curCvInputIndex)
-        {
-            squidChannelProperties.forEachCvParameter (curCvInputIndex, [this, curCvInputIndex, rowSize] (juce::ValueTree cvParameterVT)
-            {
-                CvParameterProperties cvParameterProperties { cvParameterVT, CvParameterProperties::WrapperType::client, CvParameterProperties::EnableCallbacks::no };
-                const auto parameterId { cvParameterProperties.getId () };
-
-                const auto cvAssignedFlagMask { CvParameterIndex::getCvEnabledFlag (parameterId) };
-                const auto cvAssignFlags { getValue <4> (SquidSalmple::DataLayout_190::kCvFlagsOffset + (4 * curCvInputIndex)) };
-                const auto isEnabled { cvAssignFlags & cvAssignedFlagMask };
-
-                const auto cvParamOffset { SquidSalmple::DataLayout_190::kCvParamsOffset + (curCvInputIndex * rowSize) + (parameterId * 4) };
-                const auto offset { getValue <2> (cvParamOffset + 0) };
-                const auto attenuation { static_cast<int32_t> (getValue <2> (cvParamOffset + 2)) };
-
-                LogReader (juce::String ("cv: ") + juce::String (curCvInputIndex) + ", param: (" + CvParameterIndex::getParameterName (cvAssignedFlagMask) + ")" + juce::String (parameterId) +
-                           ", raw enabled data: " + juce::String (cvAssignFlags) +
-                           ", enabled: " + (isEnabled ? "true" : "false") +
-                           ", atten: " + juce::String (attenuation) + ", offset: " + juce::String (offset));
-                cvParameterProperties.setEnabled (isEnabled, false);
-                cvParameterProperties.setAttenuation (attenuation, false);
-                cvParameterProperties.setOffset (offset, false);
-                return true;
-            });
-        }
 
         ////////////////////////////////////
         // cue sets
-        auto logCueSet = [this, numSamples = squidChannelProperties.getEndOfData ()] ([[maybe_unused]] int8_t cueSetIndex, uint32_t startCue, uint32_t loopCue, uint32_t endCue)
+        auto logCueSet = [this, numSamples = channelRecord.endOfData] ([[maybe_unused]] int8_t cueSetIndex, uint32_t startCue, uint32_t loopCue, uint32_t endCue)
         {
             LogReader ("read - cue set " + (cueSetIndex == -1 ? "current" : juce::String (cueSetIndex)) +
                        ": start = " + juce::String (startCue).paddedLeft ('0', 6) + " [0x" + juce::String::toHexString (startCue).paddedLeft ('0', 6) +
@@ -147,205 +109,36 @@ void SquidMetaDataReader::read (juce::ValueTree channelPropertiesVT, juce::File
                        "], end = " + juce::String (endCue).paddedLeft ('0', 6) + " [0x" + juce::String::toHexString (endCue).paddedLeft ('0', 6) + "]");
             jassert ((startCue <= loopCue && loopCue < endCue) || (numSamples == 0 && startCue == 0 && loopCue == 0 && endCue == 0));
         };
-
-        const auto numCues { getValue <SquidSalmple::DataLayout_190::kCuesCountSize> (SquidSalmple::DataLayout_190::kCuesCountOffset) };
-        const auto curCue { getValue <SquidSalmple::DataLayout_190::kCuesSelectedSize> (SquidSalmple::DataLayout_190::kCuesSelectedOffset) };
-        //squidChannelProperties.setNumCueSets (numCues, false); // don't do this, because the count is updated below by squidChannelProperties.addCueSet
-        LogReader ("read - cur cue meta data (cue set " + juce::String (curCue) + "):");
-        logCueSet (-1, squidChannelProperties.getStartCue (), squidChannelProperties.getLoopCue (), squidChannelProperties.getEndCue ());
-
-        LogReader ("read - Cue List: " + juce::String (numCues));
-        for (uint8_t curCueSetIndex { 0 }; curCueSetIndex < numCues; ++curCueSetIndex)
-        {
-            const auto cueSetOffset { SquidSalmple::DataLayout_190::kCuesOffset + (curCueSetIndex * 12) };
-            const auto startCue { getValue <4> (cueSetOffset + 0) };
-            const auto endCue { getValue <4> (cueSetOffset + 4) };
-            const auto loopCue { getValue <4> (cueSetOffset + 8) };
-            logCueSet (curCueSetIndex, startCue, loopCue, endCue);
-            squidChannelProperties.setCueSetPoints (curCueSetIndex, startCue, loopCue, endCue);
-        }
-        squidChannelProperties.setCurCueSet (curCue, false);
-
-        auto readReserved = [this, &squidChannelProperties] (int reservedDataOffset, int reservedDataSize, std::function<void (juce::String)> setter)
-        {
-            juce::MemoryBlock tempMemory;
-            tempMemory.replaceAll (static_cast<uint8_t*> (busyChunkData.getData ()) + reservedDataOffset, reservedDataSize);
-            auto textVersion { tempMemory.toBase64Encoding () };
-            //juce::Logger::outputDebugString ("encoded: " + textVersion);
-            setter (textVersion);
-        };
-        // read and store the 'reserved' sections
-        readReserved (SquidSalmple::DataLayout_190::k_Reserved1Offset, SquidSalmple::DataLayout_190::k_Reserved1Size, [&squidChannelProperties] (juce::String reservedData) { squidChannelProperties.setReserved1Data (reservedData); });
-        readReserved (SquidSalmple::DataLayout_190::k_Reserved2Offset, SquidSalmple::DataLayout_190::k_Reserved2Size, [&squidChannelProperties] (juce::String reservedData) { squidChannelProperties.setReserved2Data (reservedData); });
-        readReserved (SquidSalmple::DataLayout_190::k_Reserved3Offset, SquidSalmple::DataLayout_190::k_Reserved3Size, [&squidChannelProperties] (juce::String reservedData) { squidChannelProperties.setReserved3Data (reservedData); });
-        readReserved (SquidSalmple::DataLayout_190::k_Reserved4Offset, SquidSalmple::DataLayout_190::k_Reserved4Size, [&squidChannelProperties] (juce::String reservedData) { squidChannelProperties.setReserved4Data (reservedData); });
-        readReserved (SquidSalmple::DataLayout_190::k_Reserved5Offset, SquidSalmple::DataLayout_190::k_Reserved5Size, [&squidChannelProperties] (juce::String reservedData) { squidChannelProperties.setReserved5Data (reservedData); });
-        readReserved (SquidSalmple::DataLayout_190::k_Reserved6Offset, SquidSalmple::DataLayout_190::k_Reserved6Size, [&squidChannelProperties] (juce::String reservedData) { squidChannelProperties.setReserved6Data (reservedData); });
-        readReserved (SquidSalmple::DataLayout_190::k_Reserved7Offset, SquidSalmple::DataLayout_190::k_Reserved7Size, [&squidChannelProperties] (juce::String reservedData) { squidChannelProperties.setReserved7Data (reservedData); });
-        readReserved (SquidSalmple::DataLayout_190::k_Reserved8Offset, SquidSalmple::DataLayout_190::k_Reserved8Size, [&squidChannelProperties] (juce::String reservedData) { squidChannelProperties.setReserved8Data (reservedData); });
-        readReserved (SquidSalmple::DataLayout_190::k_Reserved9Offset, SquidSalmple::DataLayout_190::k_Reserved9Size, [&squidChannelProperties] (juce::String reservedData) { squidChannelProperties.setReserved9Data (reservedData); });
-        readReserved (SquidSalmple::DataLayout_190::k_Reserved10Offset, SquidSalmple::DataLayout_190::k_Reserved10Size, [&squidChannelProperties] (juce::String reservedData) { squidChannelProperties.setReserved10Data (reservedData); });
-        readReserved (SquidSalmple::DataLayout_190::k_Reserved11Offset, SquidSalmple::DataLayout_190::k_Reserved11Size, [&squidChannelProperties] (juce::String reservedData) { squidChannelProperties.setReserved11Data (reservedData); });
-        readReserved (SquidSalmple::DataLayout_190::k_Reserved12Offset, SquidSalmple::DataLayout_190::k_Reserved12Size, [&squidChannelProperties] (juce::String reservedData) { squidChannelProperties.setReserved12Data (reservedData); });
-        readReserved (SquidSalmple::DataLayout_190::k_Reserved13Offset, SquidSalmple::DataLayout_190::k_Reserved13Size, [&squidChannelProperties] (juce::String reservedData) { squidChannelProperties.setReserved13Data (reservedData); });
-        readReserved (SquidSalmple::DataLayout_190::k_Reserved14Offset, SquidSalmple::DataLayout_190::k_Reserved14Size, [&squidChannelProperties] (juce::String reservedData) { squidChannelProperties.setReserved14Data (reservedData); });
-        readReserved (SquidSalmple::DataLayout_190::k_Reserved15Offset, SquidSalmple::DataLayout_190::k_Reserved15Size, [&squidChannelProperties] (juce::String reservedData) { squidChannelProperties.setReserved15Data (reservedData); });
-    }
-    // METADATA IS BEFORE PITCH SHIFT WAS ADDED
-    else if (metaDataStatus == MetaDataStatus::fw186)
-    {
-        // NOTE: since importing an old version of metadata is a new feature (v1.3), I'm going to write this to the log file so we can track when this happens
-        // assuming there are no issues I will remove this in a subsequent release
-        DebugLog ("SquidMetaDataReader", "importing metadata version " + juce::String (squidChannelProperties.getLoadedVersion ()) + " from " +sampleFile.getFileName ());
-        squidChannelProperties.setAttack (getValue <SquidSalmple::DataLayout_186::kAttackSize> (SquidSalmple::DataLayout_186::kAttackOffset), false);
-        squidChannelProperties.setBits (getValue <SquidSalmple::DataLayout_186::kQualitySize> (SquidSalmple::DataLayout_186::kQualityOffset), false);
-        squidChannelProperties.setChannelFlags (getValue <SquidSalmple::DataLayout_186::kChannelFlagsSize> (SquidSalmple::DataLayout_186::kChannelFlagsOffset), false);
-        jassert (! ((squidChannelProperties.getChannelFlags ()& ChannelFlags::kCueRandom) && (squidChannelProperties.getChannelFlags ()& ChannelFlags::kCueStepped)));
-#if JUCE_DEBUG
-        const auto channelFlags { squidChannelProperties.getChannelFlags () };
-        juce::String channelFlagsString;
-        if (channelFlags == 0)
-        {
-            channelFlagsString += "NONE";
-        }
-        else
-        {
-            auto addFlagString = [&channelFlagsString] (juce::String flagString)
-                {
-                    channelFlagsString += (channelFlagsString.length () == 0 ? "" : ", ") + flagString;
-                };
-            if (channelFlags & ChannelFlags::kMute)
-                addFlagString ("mute");
-            if (channelFlags & ChannelFlags::kSolo)
-                addFlagString ("solo");
-            if (channelFlags & ChannelFlags::kNoGate)
-                addFlagString ("noGate");
-            if (channelFlags & ChannelFlags::kCueRandom)
-                addFlagString ("cueRandom");
-            if (channelFlags & ChannelFlags::kCueStepped)
-                addFlagString ("cueStepped");
-            if (channelFlags & ChannelFlags::kNeighborOutput)
-                addFlagString ("neighborOutput");
-        }
-
-        LogReader ("Channel Flags: " + channelFlagsString);
-#endif
-        squidChannelProperties.setChannelSource (getValue <SquidSalmple::DataLayout_186::kChannelSourceSize> (SquidSalmple::DataLayout_186::kChannelSourceOffset), false);
-        squidChannelProperties.setChoke (getValue <SquidSalmple::DataLayout_186::kChokeSize> (SquidSalmple::DataLayout_186::kChokeOffset), false);
-        squidChannelProperties.setDecay (getValue <SquidSalmple::DataLayout_186::kDecaySize> (SquidSalmple::DataLayout_186::kDecayOffset), false);
-        squidChannelProperties.setEndCue (getValue <SquidSalmple::DataLayout_186::kSampleEndSize> (SquidSalmple::DataLayout_186::kSampleEndOffset), false);
-        squidChannelProperties.setEndOfData (getValue <SquidSalmple::DataLayout_186::kEndOfDataSize> (SquidSalmple::DataLayout_186::kEndOFDataOffset), false);
-        squidChannelProperties.setETrig (getValue <SquidSalmple::DataLayout_186::kExternalTriggerSize> (SquidSalmple::DataLayout_186::kExternalTriggerOffset), false);
-        uint16_t frequencyAndType { getValue <SquidSalmple::DataLayout_186::kCutoffFrequencySize> (SquidSalmple::DataLayout_186::kCutoffFrequencyOffset) };
-        squidChannelProperties.setFilterType (frequencyAndType & 0x000F, false);
-        squidChannelProperties.setFilterFrequency (frequencyAndType >> 4, false);
-        squidChannelProperties.setFilterResonance (getValue <SquidSalmple::DataLayout_186::kResonanceSize> (SquidSalmple::DataLayout_186::kResonanceOffset), false);
-        squidChannelProperties.setLevel (getValue <SquidSalmple::DataLayout_186::kLevelSize> (SquidSalmple::DataLayout_186::kLevelOffset), false);
-        squidChannelProperties.setLoopCue (getValue <SquidSalmple::DataLayout_186::kLoopPositionSize> (SquidSalmple::DataLayout_186::kLoopPositionOffset), false);
-        squidChannelProperties.setLoopMode (getValue <SquidSalmple::DataLayout_186::kLoopSize> (SquidSalmple::DataLayout_186::kLoopOffset), false);
-        squidChannelProperties.setQuant (getValue <SquidSalmple::DataLayout_186::kQuantizeModeSize> (SquidSalmple::DataLayout_186::kQuantizeModeOffset), false);
-        squidChannelProperties.setRate (getValue <SquidSalmple::DataLayout_186::kRateSize> (SquidSalmple::DataLayout_186::kRateOffset), false);
-        squidChannelProperties.setRecDest (getValue <SquidSalmple::DataLayout_186::kRecDestSize> (SquidSalmple::DataLayout_186::kRecDestOffset), false);
-        squidChannelProperties.setReverse (getValue <SquidSalmple::DataLayout_186::kReverseSize> (SquidSalmple::DataLayout_186::kReverseOffset), false);
-        squidChannelProperties.setSpeed (getValue <SquidSalmple::DataLayout_186::kSpeedSize> (SquidSalmple::DataLayout_186::kSpeedOffset), false);
-        squidChannelProperties.setStartCue (getValue <SquidSalmple::DataLayout_186::kSampleStartSize> (SquidSalmple::DataLayout_186::kSampleStartOffset), false);
-        squidChannelProperties.setSteps (getValue<SquidSalmple::DataLayout_186::kStepTrigNumSize> (SquidSalmple::DataLayout_186::kStepTrigNumOffset), false);
-        squidChannelProperties.setXfade (getValue <SquidSalmple::DataLayout_186::kXfadeSize> (SquidSalmple::DataLayout_186::kXfadeOffset), false);
-
-        ////////////////////////////////////
-        // cv assign
-        const auto rowSize { (kCvParamsCount_186 + kCvParamsExtra) * 4 };
-        for (auto curCvInputIndex { 0 }; curCvInputIndex < kCvInputsCount + kCvInputsExtra; ++curCvInputIndex)
+        LogReader ("read - cur cue meta data (cue set " + juce::String (channelRecord.curCueSet) + "):");
+        logCueSet (-1, channelRecord.startCue, channelRecord.loopCue, channelRecord.endCue);
+        LogReader ("read - Cue List: " + juce::String (channelRecord.numCueSets));
+        for (auto curCueSetIndex { 0 }; curCueSetIndex < channelRecord.numCueSets; ++curCueSetIndex)
         {
-            for (auto curParameterIndex { 0 }; curParameterIndex < 15; ++curParameterIndex)
-            {
-                CvParameterProperties cvParameterProperties { squidChannelProperties.getCvParameterVT (curCvInputIndex, curParameterIndex), CvParameterProperties::WrapperType::client, CvParameterProperties::EnableCallbacks::no };
-
-                const auto cvParamOffset { SquidSalmple::DataLayout_186::kCvParamsOffset + (curCvInputIndex * rowSize) + (curParameterIndex * 4) };
-                const auto cvAssignedFlag { CvParameterIndex::getCvEnabledFlag (curParameterIndex) };
-                const auto cvAssignFlags { getValue <2> (SquidSalmple::DataLayout_186::kCvFlagsOffset + (2 * curCvInputIndex)) };
-                const auto offset { getValue <2> (cvParamOffset + 0) };
-                const auto attenuation { static_cast<int16_t> (getValue <2> (cvParamOffset + 2)) };
-                cvParameterProperties.setEnabled (cvAssignFlags& cvAssignedFlag, false);
-                cvParameterProperties.setAttenuation (attenuation, false);
-                cvParameterProperties.setOffset (offset, false);
-            }
+            const auto& cueSet { channelRecord.cueSets [static_cast<size_t> (curCueSetIndex)] };
+            logCueSet (static_cast<int8_t> (curCueSetIndex), cueSet.start, cueSet.loop, cueSet.end);
         }
-
-        ////////////////////////////////////
-        // cue sets
-        auto logCueSet = [this, numSamples = squidChannelProperties.getEndOfData ()] ([[maybe_unused]] int8_t cueSetIndex, uint32_t startCue, uint32_t loopCue, uint32_t endCue)
-            {
-                LogReader ("read - cue set " + (cueSetIndex == -1 ? "current" : juce::String (cueSetIndex)) +
-                           ": start = " + juce::String (startCue).paddedLeft ('0', 6) + " [0x" + juce::String::toHexString (startCue).paddedLeft ('0', 6) +
-                           "], loop = " + juce::String (loopCue).paddedLeft ('0', 6) + " [0x" + juce::String::toHexString (loopCue).paddedLeft ('0', 6) +
-                           "], end = " + juce::String (endCue).paddedLeft ('0', 6) + " [0x" + juce::String::toHexString (endCue).paddedLeft ('0', 6) + "]");
-                jassert ((startCue <= loopCue && loopCue < endCue) || (numSamples == 0 && startCue == 0 && loopCue == 0 && endCue == 0));
-            };
-
-        const auto numCues { getValue <SquidSalmple::DataLayout_186::kCuesCountSize> (SquidSalmple::DataLayout_186::kCuesCountOffset) };
-        const auto curCue { getValue <SquidSalmple::DataLayout_186::kCuesSelectedSize> (SquidSalmple::DataLayout_186::kCuesSelectedOffset) };
-        //squidChannelProperties.setNumCueSets (numCues, false); // don't do this, because the count is updated below by squidChannelProperties.addCueSet
-        LogReader ("read - cur cue meta data (cue set " + juce::String (curCue) + "):");
-        logCueSet (-1, squidChannelProperties.getStartCue (), squidChannelProperties.getLoopCue (), squidChannelProperties.getEndCue ());
-
-        LogReader ("read - Cue List: " + juce::String (numCues));
-        for (uint8_t curCueSetIndex { 0 }; curCueSetIndex < numCues; ++curCueSetIndex)
-        {
-            const auto cueSetOffset { SquidSalmple::DataLayout_186::kCuesOffset + (curCueSetIndex * 12) };
-            const auto startCue { getValue <4> (cueSetOffset + 0) };
-            const auto endCue { getValue <4> (cueSetOffset + 4) };
-            const auto loopCue { getValue <4> (cueSetOffset + 8) };
-            logCueSet (curCueSetIndex, startCue, loopCue, endCue);
-            squidChannelProperties.setCueSetPoints (curCueSetIndex, startCue, loopCue, endCue);
-        }
-        squidChannelProperties.setCurCueSet (curCue, false);
-
-        auto readReserved = [this, &squidChannelProperties] (int reservedDataOffset, int reservedDataSize, std::function<void (juce::String)> setter)
-            {
-                juce::MemoryBlock tempMemory;
-                tempMemory.replaceAll (static_cast<uint8_t*> (busyChunkData.getData ()) + reservedDataOffset, reservedDataSize);
-                auto textVersion { tempMemory.toBase64Encoding () };
-                setter (textVersion);
-            };
-        // read and store the 'reserved' sections
-        readReserved (SquidSalmple::DataLayout_186::k_Reserved1Offset, SquidSalmple::DataLayout_186::k_Reserved1Size, [&squidChannelProperties] (juce::String reservedData) { squidChannelProperties.setReserved1Data (reservedData); });
-        readReserved (SquidSalmple::DataLayout_186::k_Reserved2Offset, SquidSalmple::DataLayout_186::k_Reserved2Size, [&squidChannelProperties] (juce::String reservedData) { squidChannelProperties.setReserved2Data (reservedData); });
-        readReserved (SquidSalmple::DataLayout_186::k_Reserved3Offset, SquidSalmple::DataLayout_186::k_Reserved3Size, [&squidChannelProperties] (juce::String reservedData) { squidChannelProperties.setReserved3Data (reservedData); });
-        readReserved (SquidSalmple::DataLayout_186::k_Reserved4Offset, SquidSalmple::DataLayout_186::k_Reserved4Size, [&squidChannelProperties] (juce::String reservedData) { squidChannelProperties.setReserved4Data (reservedData); });
-        readReserved (SquidSalmple::DataLayout_186::k_Reserved5Offset, SquidSalmple::DataLayout_186::k_Reserved5Size, [&squidChannelProperties] (juce::String reservedData) { squidChannelProperties.setReserved5Data (reservedData); });
-        readReserved (SquidSalmple::DataLayout_186::k_Reserved6Offset, SquidSalmple::DataLayout_186::k_Reserved6Size, [&squidChannelProperties] (juce::String reservedData) { squidChannelProperties.setReserved6Data (reservedData); });
-        readReserved (SquidSalmple::DataLayout_186::k_Reserved7Offset, SquidSalmple::DataLayout_186::k_Reserved7Size, [&squidChannelProperties] (juce::String reservedData) { squidChannelProperties.setReserved7Data (reservedData); });
-        readReserved (SquidSalmple::DataLayout_186::k_Reserved8Offset, SquidSalmple::DataLayout_186::k_Reserved8Size, [&squidChannelProperties] (juce::String reservedData) { squidChannelProperties.setReserved8Data (reservedData); });
-        readReserved (SquidSalmple::DataLayout_186::k_Reserved9Offset, SquidSalmple::DataLayout_186::k_Reserved9Size, [&squidChannelProperties] (juce::String reservedData) { squidChannelProperties.setReserved9Data (reservedData); });
-        readReserved (SquidSalmple::DataLayout_186::k_Reserved10Offset, SquidSalmple::DataLayout_186::k_Reserved10Size, [&squidChannelProperties] (juce::String reservedData) { squidChannelProperties.setReserved10Data (reservedData); });
-        readReserved (SquidSalmple::DataLayout_186::k_Reserved11Offset, SquidSalmple::DataLayout_186::k_Reserved11Size, [&squidChannelProperties] (juce::String reservedData) { squidChannelProperties.setReserved11Data (reservedData); });
-        readReserved (SquidSalmple::DataLayout_186::k_Reserved12Offset, SquidSalmple::DataLayout_186::k_Reserved12Size, [&squidChannelProperties] (juce::String reservedData) { squidChannelProperties.setReserved12Data (reservedData); });
-        // NOTE: this is the old padding data at the end, but it has been reduced in size in the new metadata layout, so we can't really read it in, and we don't need to because it was reserved for future use
-        //readReserved (SquidSalmple::DataLayout_186::k_Reserved13Offset, SquidSalmple::DataLayout_186::k_Reserved13Size, [&squidChannelProperties] (juce::String reservedData) { squidChannelProperties.setReserved13Data (reservedData); });
-
     }
     // NO METADATA
-    else // metaDataStatus == MetaDataStatus::invalid
+    else
     {
         LogReader (sampleFile.getFileName () + " does not contain metadata");
-        auto numSamples = squidChannelProperties.getSampleDataNumSamples ();
+        auto numSamples = channelRecord.sampleDataNumSamples;
         uint32_t endOffset = numSamples * 2;
         // initialize parameters that have defaults related to specific channel or sample
-        squidChannelProperties.setChannelIndex (channelIndex, false);
-        squidChannelProperties.setChannelSource (channelIndex, false);
-        squidChannelProperties.setChoke (channelIndex, false);
-        squidChannelProperties.setEndOfData (endOffset, false);
-        squidChannelProperties.setRecDest (channelIndex, false);
+        channelRecord.channelIndex = channelIndex;
+        channelRecord.channelSource = channelIndex;
+        channelRecord.choke = channelIndex;
+        channelRecord.endOfData = endOffset;
+        channelRecord.recDest = channelIndex;
         if (auto markerList { busyChunkReader.getMarkerList (sampleFile) }; markerList.size () != 0)
         {
-            auto addCueSet = [&squidChannelProperties] (int cueSetIndex, int startCue, int endCue)
+            auto addCueSet = [&channelRecord] (int cueSetIndex, int startCue, int endCue)
             {
                 LogReader ("import - cue set " + juce::String (cueSetIndex) +
                     ": start = " + juce::String (startCue).paddedLeft ('0', 6) + " [0x" + juce::String::toHexString (startCue).paddedLeft ('0', 6) +
                     "], loop = " + juce::String (startCue).paddedLeft ('0', 6) + " [0x" + juce::String::toHexString (startCue).paddedLeft ('0', 6) +
                     "], end = " + juce::String (endCue).paddedLeft ('0', 6) + " [0x" + juce::String::toHexString (endCue).paddedLeft ('0', 6) + "]");
-                squidChannelProperties.setCueSetPoints (cueSetIndex, startCue, startCue, endCue);
+                channelRecord.setCueSetPoints (cueSetIndex, startCue, startCue, endCue);
             };
             LogReader ("importing markers");
             // import markers
@@ -368,18 +161,18 @@ void SquidMetaDataReader::read (juce::ValueTree channelPropertiesVT, juce::File
                 addCueSet (static_cast<int> (markerList.size ()), SquidChannelProperties::sampleOffsetToByteOffset (lastMarker), endOffset);
             }
             // set initial cue points to first cue set
-            squidChannelProperties.setStartCue (squidChannelProperties.getStartCueSet (0), false);
-            squidChannelProperties.setLoopCue (squidChannelProperties.getLoopCueSet (0), false);
-            squidChannelProperties.setEndCue (squidChannelProperties.getEndCueSet (0), false);
+            channelRecord.startCue = channelRecord.cueSets [0].start;
+            channelRecord.loopCue = channelRecord.cueSets [0].loop;
+            channelRecord.endCue = channelRecord.cueSets [0].end;
         }
         else
         {
             // set end cue to end of sample
-            squidChannelProperties.setEndCue (endOffset, false);
+            channelRecord.endCue = endOffset;
             // set first cue set
-            squidChannelProperties.setCueSetPoints (0, 0, 0, endOffset);
+            channelRecord.setCueSetPoints (0, 0, 0, endOffset);
         }
     }
 
-    squidChannelProperties.setSampleFileName (sampleFile.getFullPathName (), false);
+    channelRecord.sampleFileName = sampleFile.getFullPathName ();
 }
\ No newline at end of file
@@ -1,6 +1,8 @@
 #include "SquidChannelProperties.h"
+#include "ChannelRecord.h"
 #include "CvParameterProperties.h"
 #include "Metadata/SquidSalmpleDefs.h"
+#include "../Utility/Hash64.h"
 #include "../Utility/ValueTreeHelpers.h"
 
 static const auto kScaleMax { 65535. };
@@ -39,7 +41,49 @@ const constexpr char* kReserved13DatDefault { "1..." };
 const constexpr char* kReserved14DatDefault { "2...." };
 const constexpr char* kReserved15DatDefault { "248............................................................................................................................................................................................................................................................................................................................................" };
 
+// the defaults are decoded once, and shared by every channel that has not loaded its own reserved data
+ReservedDataRefCounted::RefCountedPtr SquidChannelProperties::getDefaultReservedData (int reservedIndex)
+{
+    static const auto defaultReservedData { []
+    {
+        const char* defaultReservedDataStrings [ChannelRecord::kNumReservedSections]
+        {
+            kReserved1DataDefault, kReserved2DataDefault, kReserved3DataDefault, kReserved4DataDefault, kReserved5DataDefault,
+            kReserved6DataDefault, kReserved7DataDefault, kReserved8DataDefault, kReserved9DataDefault, kReserved10DatDefault,
+            kReserved11DatDefault, kReserved12DatDefault, kReserved13DatDefault, kReserved14DatDefault, kReserved15DatDefault
+        };
+        std::array<ReservedDataRefCounted::RefCountedPtr, ChannelRecord::kNumReservedSections> reservedDataList;
+        for (auto curReservedIndex { 0u }; curReservedIndex < reservedDataList.size (); ++curReservedIndex)
+        {
+            juce::MemoryBlock reservedData;
+            reservedData.fromBase64Encoding (defaultReservedDataStrings [curReservedIndex]);
+            reservedDataList [curReservedIndex] = new ReservedDataRefCounted (reservedData.getData (), reservedData.getSize ());
+        }
+        return reservedDataList;
+    } () };
+    jassert (reservedIndex >= 0 && reservedIndex < static_cast<int> (defaultReservedData.size ()));
+    return defaultReservedData [static_cast<size_t> (reservedIndex)];
+}
+
 void SquidChannelProperties::initValueTree ()
+{
+    // new channel trees are a single deep copy of a prebuilt default tree, instead of being built up one property and child at a time
+    data = getDefaultValueTree ().createCopy ();
+}
+
+const juce::ValueTree& SquidChannelProperties::getDefaultValueTree ()
+{
+    // NOTE: this tree is never modified after it is built, it is only copied
+    static const juce::ValueTree defaultValueTree { [] ()
+    {
+        SquidChannelProperties defaultChannelProperties (juce::ValueTree (SquidChannelTypeId), WrapperType::owner, EnableCallbacks::no);
+        defaultChannelProperties.buildDefaultValueTree ();
+        return defaultChannelProperties.getValueTree ();
+    } () };
+    return defaultValueTree;
+}
+
+void SquidChannelProperties::buildDefaultValueTree ()
 {
     setAttack (0, false);
     setBits (0, false);
@@ -47,7 +91,7 @@ void SquidChannelProperties::initValueTree ()
     setChannelIndex (0, false); // needs to be initialized to the correct value for the specific channel this represents
     setChannelSource (0, false);  // needs to be initialized to the correct value for the specific channel this represents
     setChoke (0, false); // needs to be initialized to the correct value for the specific channel this represents
-    //we need to initialize CurCueSet once the cue sets have been configured, so we will do this at the end of initValueTree
+    //we need to initialize CurCueSet once the cue sets have been configured, so we will do this at the end of buildDefaultValueTree
     //setCurCueSet (0, false);
     setDecay (0, false);
     setETrig (0, false);
@@ -68,21 +112,21 @@ void SquidChannelProperties::initValueTree ()
     setSteps (0, false);
     setXfade (0, false);
 
-    setReserved1Data  (kReserved1DataDefault);
-    setReserved2Data  (kReserved2DataDefault);
-    setReserved3Data  (kReserved3DataDefault);
-    setReserved4Data  (kReserved4DataDefault);
-    setReserved5Data  (kReserved5DataDefault);
-    setReserved6Data  (kReserved6DataDefault);
-    setReserved7Data  (kReserved7DataDefault);
-    setReserved8Data  (kReserved8DataDefault);
-    setReserved9Data  (kReserved9DataDefault);
-    setReserved10Data (kReserved10DatDefault);
-    setReserved11Data (kReserved11DatDefault);
-    setReserved12Data (kReserved12DatDefault);
-    setReserved13Data (kReserved13DatDefault);
-    setReserved14Data (kReserved14DatDefault);
-    setReserved15Data (kReserved15DatDefault);
+    setReserved1Data (getDefaultReservedData (0));
+    setReserved2Data (getDefaultReservedData (1));
+    setReserved3Data (getDefaultReservedData (2));
+    setReserved4Data (getDefaultReservedData (3));
+    setReserved5Data (getDefaultReservedData (4));
+    setReserved6Data (getDefaultReservedData (5));
+    setReserved7Data (getDefaultReservedData (6));
+    setReserved8Data (getDefaultReservedData (7));
+    setReserved9Data (getDefaultReservedData (8));
+    setReserved10Data (getDefaultReservedData (9));
+    setReserved11Data (getDefaultReservedData (10));
+    setReserved12Data (getDefaultReservedData (11));
+    setReserved13Data (getDefaultReservedData (12));
+    setReserved14Data (getDefaultReservedData (13));
+    setReserved15Data (getDefaultReservedData (14));
 
     // TODO - I can probably remove this, as it is just test code validating that getCvEnabledFlag works
     jassert (CvAssignedFlag::bits == CvParameterIndex::getCvEnabledFlag (CvParameterIndex::Bits));
@@ -158,7 +202,7 @@ void SquidChannelProperties::initValueTree ()
     setLoopCue (0, false);
     setStartCue (0, false);
     setNumCueSets (1, false);
-    //we need to initialize CurCueSet once the cue sets have been configured, so we do this at the end of initValueTree
+    //we need to initialize CurCueSet once the cue sets have been configured, so we do this at the end of buildDefaultValueTree
     setCurCueSet (0, false);
 
     setSampleDataBits (0, false);
@@ -390,68 +434,75 @@ void SquidChannelProperties::setXfade (int xfade, bool includeSelfCallback)
     setValue (xfade, XfadePropertyId, includeSelfCallback);
 }
 
-void SquidChannelProperties::setReserved1Data (juce::String reservedData)
+void SquidChannelProperties::setReservedData (ReservedDataRefCounted::RefCountedPtr reservedData, const juce::Identifier& reservedDataPropertyId)
+{
+    // NOTE: I am accessing the VT directly, for the same reason as setSampleDataAudioBuffer. the var holds a reference, so trees share the data instead of copying it
+    jassert (reservedData != nullptr);
+    data.setPropertyExcludingListener (this, reservedDataPropertyId, reservedData.get (), nullptr);
+}
+
+void SquidChannelProperties::setReserved1Data (ReservedDataRefCounted::RefCountedPtr reservedData)
 {
-    setValue (reservedData, Reserved1DataPropertyId, false);
+    setReservedData (reservedData, Reserved1DataPropertyId);
 }
-void SquidChannelProperties::setReserved2Data (juce::String reservedData)
+void SquidChannelProperties::setReserved2Data (ReservedDataRefCounted::RefCountedPtr reservedData)
 {
-    setValue (reservedData, Reserved2DataPropertyId, false);
+    setReservedData (reservedData, Reserved2DataPropertyId);
 }
-void SquidChannelProperties::setReserved3Data (juce::String reservedData)
+void SquidChannelProperties::setReserved3Data (ReservedDataRefCounted::RefCountedPtr reservedData)
 {
-    setValue (reservedData, Reserved3DataPropertyId, false);
+    setReservedData (reservedData, Reserved3DataPropertyId);
 }
-void SquidChannelProperties::setReserved4Data (juce::String reservedData)
+void SquidChannelProperties::setReserved4Data (ReservedDataRefCounted::RefCountedPtr reservedData)
 {
-    setValue (reservedData, Reserved4DataPropertyId, false);
+    setReservedData (reservedData, Reserved4DataPropertyId);
 }
-void SquidChannelProperties::setReserved5Data (juce::String reservedData)
+void SquidChannelProperties::setReserved5Data (ReservedDataRefCounted::RefCountedPtr reservedData)
 {
-    setValue (reservedData, Reserved5DataPropertyId, false);
+    setReservedData (reservedData, Reserved5DataPropertyId);
 }
-void SquidChannelProperties::setReserved6Data (juce::String reservedData)
+void SquidChannelProperties::setReserved6Data (ReservedDataRefCounted::RefCountedPtr reservedData)
 {
-    setValue (reservedData, Reserved6DataPropertyId, false);
+    setReservedData (reservedData, Reserved6DataPropertyId);
 }
-void SquidChannelProperties::setReserved7Data (juce::String reservedData)
+void SquidChannelProperties::setReserved7Data (ReservedDataRefCounted::RefCountedPtr reservedData)
 {
-    setValue (reservedData, Reserved7DataPropertyId, false);
+    setReservedData (reservedData, Reserved7DataPropertyId);
 }
-void SquidChannelProperties::setReserved8Data (juce::String reservedData)
+void SquidChannelProperties::setReserved8Data (ReservedDataRefCounted::RefCountedPtr reservedData)
 {
-    setValue (reservedData, Reserved8DataPropertyId, false);
+    setReservedData (reservedData, Reserved8DataPropertyId);
 }
-void SquidChannelProperties::setReserved9Data (juce::String reservedData)
+void SquidChannelProperties::setReserved9Data (ReservedDataRefCounted::RefCountedPtr reservedData)
 {
-    setValue (reservedData, Reserved9DataPropertyId, false);
+    setReservedData (reservedData, Reserved9DataPropertyId);
 }
-void SquidChannelProperties::setReserved10Data (juce::String reservedData)
+void SquidChannelProperties::setReserved10Data (ReservedDataRefCounted::RefCountedPtr reservedData)
 {
-    setValue (reservedData, Reserved10DataPropertyId, false);
+    setReservedData (reservedData, Reserved10DataPropertyId);
 }
-void SquidChannelProperties::setReserved11Data (juce::String reservedData)
+void SquidChannelProperties::setReserved11Data (ReservedDataRefCounted::RefCountedPtr reservedData)
 {
-    setValue (reservedData, Reserved11DataPropertyId, false);
+    setReservedData (reservedData, Reserved11DataPropertyId);
 }
-void SquidChannelProperties::setReserved12Data (juce::String reservedData)
+void SquidChannelProperties::setReserved12Data (ReservedDataRefCounted::RefCountedPtr reservedData)
 {
-    setValue (reservedData, Reserved12DataPropertyId, false);
+    setReservedData (reservedData, Reserved12DataPropertyId);
 }
 
-void SquidChannelProperties::setReserved13Data (juce::String reservedData)
+void SquidChannelProperties::setReserved13Data (ReservedDataRefCounted::RefCountedPtr reservedData)
 {
-    setValue (reservedData, Reserved13DataPropertyId, false);
+    setReservedData (reservedData, Reserved13DataPropertyId);
 }
 
-void SquidChannelProperties::setReserved14Data (juce::String reservedData)
+void SquidChannelProperties::setReserved14Data (ReservedDataRefCounted::RefCountedPtr reservedData)
 {
-    setValue (reservedData, Reserved14DataPropertyId, false);
+    setReservedData (reservedData, Reserved14DataPropertyId);
 }
 
-void SquidChannelProperties::setReserved15Data (juce::String reservedData)
+void SquidChannelProperties::setReserved15Data (ReservedDataRefCounted::RefCountedPtr reservedData)
 {
-    setValue (reservedData, Reserved15DataPropertyId, false);
+    setReservedData (reservedData, Reserved15DataPropertyId);
 }
 
 void SquidChannelProperties::setReverse (int reverse, bool includeSelfCallback)
@@ -680,68 +731,73 @@ int SquidChannelProperties::getXfade ()
     return getValue<int> (XfadePropertyId);
 }
 
-juce::String SquidChannelProperties::getReserved1Data ()
+ReservedDataRefCounted::RefCountedPtr SquidChannelProperties::getReservedData (const juce::Identifier& reservedDataPropertyId)
 {
-    return getValue<juce::String> (Reserved1DataPropertyId);
+    return ReservedDataRefCounted::RefCountedPtr (static_cast<ReservedDataRefCounted*> (data.getProperty (reservedDataPropertyId).getObject ()));
 }
-juce::String SquidChannelProperties::getReserved2Data ()
+
+ReservedDataRefCounted::RefCountedPtr SquidChannelProperties::getReserved1Data ()
 {
-    return getValue<juce::String> (Reserved2DataPropertyId);
+    return getReservedData (Reserved1DataPropertyId);
 }
-juce::String SquidChannelProperties::getReserved3Data ()
+ReservedDataRefCounted::RefCountedPtr SquidChannelProperties::getReserved2Data ()
 {
-    return getValue<juce::String> (Reserved3DataPropertyId);
+    return getReservedData (Reserved2DataPropertyId);
 }
-juce::String SquidChannelProperties::getReserved4Data ()
+ReservedDataRefCounted::RefCountedPtr SquidChannelProperties::getReserved3Data ()
 {
-    return getValue<juce::String> (Reserved4DataPropertyId);
+    return getReservedData (Reserved3DataPropertyId);
 }
-juce::String SquidChannelProperties::getReserved5Data ()
+ReservedDataRefCounted::RefCountedPtr SquidChannelProperties::getReserved4Data ()
 {
-    return getValue<juce::String> (Reserved5DataPropertyId);
+    return getReservedData (Reserved4DataPropertyId);
 }
-juce::String SquidChannelProperties::getReserved6Data ()
+ReservedDataRefCounted::RefCountedPtr SquidChannelProperties::getReserved5Data ()
 {
-    return getValue<juce::String> (Reserved6DataPropertyId);
+    return getReservedData (Reserved5DataPropertyId);
 }
-juce::String SquidChannelProperties::getReserved7Data ()
+ReservedDataRefCounted::RefCountedPtr SquidChannelProperties::getReserved6Data ()
 {
-    return getValue<juce::String> (Reserved7DataPropertyId);
+    return getReservedData (Reserved6DataPropertyId);
 }
-juce::String SquidChannelProperties::getReserved8Data ()
+ReservedDataRefCounted::RefCountedPtr SquidChannelProperties::getReserved7Data ()
 {
-    return getValue<juce::String> (Reserved8DataPropertyId);
+    return getReservedData (Reserved7DataPropertyId);
 }
-juce::String SquidChannelProperties::getReserved9Data ()
+ReservedDataRefCounted::RefCountedPtr SquidChannelProperties::getReserved8Data ()
 {
-    return getValue<juce::String> (Reserved9DataPropertyId);
+    return getReservedData (Reserved8DataPropertyId);
 }
-juce::String SquidChannelProperties::getReserved10Data ()
+ReservedDataRefCounted::RefCountedPtr SquidChannelProperties::getReserved9Data ()
 {
-    return getValue<juce::String> (Reserved10DataPropertyId);
+    return getReservedData (Reserved9DataPropertyId);
 }
-juce::String SquidChannelProperties::getReserved11Data ()
+ReservedDataRefCounted::RefCountedPtr SquidChannelProperties::getReserved10Data ()
 {
-    return getValue<juce::String> (Reserved11DataPropertyId);
+    return getReservedData (Reserved10DataPropertyId);
 }
-juce::String SquidChannelProperties::getReserved12Data ()
+ReservedDataRefCounted::RefCountedPtr SquidChannelProperties::getReserved11Data ()
 {
-    return getValue<juce::String> (Reserved12DataPropertyId);
+    return getReservedData (Reserved11DataPropertyId);
+}
+ReservedDataRefCounted::RefCountedPtr SquidChannelProperties::getReserved12Data ()
+{
+    return getReservedData (Reserved12DataPropertyId);
 }
 
-juce::String SquidChannelProperties::getReserved13Data ()
+ReservedDataRefCounted::RefCountedPtr SquidChannelProperties::getReserved13Data ()
 {
-    return getValue<juce::String> (Reserved13DataPropertyId);
+    return getReservedData (Reserved13DataPropertyId);
 }
 
-juce::String SquidChannelProperties::getReserved14Data ()
+ReservedDataRefCounted::RefCountedPtr SquidChannelProperties::getReserved14Data ()
 {
-    return getValue<juce::String> (Reserved14DataPropertyId);
+    return getReservedData (Reserved14DataPropertyId);
 }
 
-juce::String SquidChannelProperties::getReserved15Data ()
+ReservedDataRefCounted::RefCountedPtr SquidChannelProperties::getReserved15Data ()
 {
-    return getValue<juce::String> (Reserved15DataPropertyId);
+    return getReservedData (Reserved15DataPropertyId);
 }
 
 int SquidChannelProperties::getReverse ()
@@ -860,9 +916,8 @@ uint8_t SquidChannelProperties::getLoadedVersion ()
 
 juce::ValueTree SquidChannelProperties::getCvAssignVT (int cvIndex)
 {
-    auto cvAssignsVT { data.getChildWithName (SquidChannelProperties::CvAssignsTypeId) };
-    jassert (cvAssignsVT.isValid ());
-    auto cvInputVT { cvAssignsVT.getChild (cvIndex) };
+    getCvParameterRow (cvIndex);
+    auto cvInputVT { cvInputIndex [static_cast<size_t> (cvIndex)] };
     jassert (cvInputVT.isValid ());
     jassert (cvInputVT.getType () == SquidChannelProperties::CvInputTypeId);
     jassert (static_cast<int> (cvInputVT.getProperty (SquidChannelProperties::CvInputIdPropertyId)) == cvIndex + 1);
@@ -871,19 +926,79 @@ juce::ValueTree SquidChannelProperties::getCvAssignVT (int cvIndex)
 
 juce::ValueTree SquidChannelProperties::getCvParameterVT (int cvIndex, int parameterId)
 {
-    juce::ValueTree cvParameterVT;
-    forEachCvParameter (cvIndex, [this, &cvParameterVT, parameterId] (juce::ValueTree curCvParameterVT)
+    jassert (parameterId >= 0 && parameterId < kNumCvParameterIds);
+    if (parameterId < 0 || parameterId >= kNumCvParameterIds)
+        return {};
+    return getCvParameterRow (cvIndex) [parameterId];
+}
+
+juce::ValueTree* SquidChannelProperties::getCvParameterRow (int cvIndex)
+{
+    jassert (cvIndex >= 0 && cvIndex < kNumCvInputs);
+    const auto& cvInputVT { cvInputIndex [static_cast<size_t> (cvIndex)] };
+    if (! cvInputVT.isValid () || cvInputVT.getParent ().getParent () != data)
+        buildCvParameterIndex ();
+    return cvParameterIndex.data () + cvIndex * kNumCvParameterIds;
+}
+
+void SquidChannelProperties::buildCvParameterIndex ()
+{
+    cvInputIndex.fill ({});
+    cvParameterIndex.fill ({});
+    auto cvAssignsVT { data.getChildWithName (SquidChannelProperties::CvAssignsTypeId) };
+    ValueTreeHelpers::forEachChildOfType (cvAssignsVT, SquidChannelProperties::CvInputTypeId, [this] (juce::ValueTree cvInputVT)
     {
-        CvParameterProperties cvParameterProperties { curCvParameterVT, CvParameterProperties::WrapperType::client, CvParameterProperties::EnableCallbacks::no };
-        if (cvParameterProperties.getId () == parameterId)
+        const auto cvIndex { static_cast<int> (cvInputVT.getProperty (SquidChannelProperties::CvInputIdPropertyId)) - 1 };
+        jassert (cvIndex >= 0 && cvIndex < kNumCvInputs);
+        if (cvIndex < 0 || cvIndex >= kNumCvInputs)
+            return true;
+        cvInputIndex [static_cast<size_t> (cvIndex)] = cvInputVT;
+        ValueTreeHelpers::forEachChildOfType (cvInputVT, CvParameterProperties::CvParameterTypeId, [this, cvIndex] (juce::ValueTree cvParameterVT)
         {
-            cvParameterVT = curCvParameterVT;
-            return false;
-        }
+            const auto parameterId { static_cast<int> (cvParameterVT.getProperty (CvParameterProperties::CvParameterIdPropertyId)) };
+            jassert (parameterId >= 0 && parameterId < kNumCvParameterIds);
+            if (parameterId >= 0 && parameterId < kNumCvParameterIds)
+                cvParameterIndex [static_cast<size_t> (cvIndex * kNumCvParameterIds + parameterId)] = cvParameterVT;
+            return true;
+        });
         return true;
     });
+}
+
+void SquidChannelProperties::copyCvAssignFrom (SquidChannelProperties& sourceChannelProperties, int sourceCvIndex, int cvIndex)
+{
+    const auto* sourceCvParameterRow { sourceChannelProperties.getCvParameterRow (sourceCvIndex) };
+    auto* cvParameterRow { getCvParameterRow (cvIndex) };
+    for (auto parameterId { 0 }; parameterId < kNumCvParameterIds; ++parameterId)
+    {
+        const auto& srcParameterVT { sourceCvParameterRow [parameterId] };
+        auto& dstParameterVT { cvParameterRow [parameterId] };
+        if (! srcParameterVT.isValid () || ! dstParameterVT.isValid ())
+            continue;
+        dstParameterVT.setProperty (CvParameterProperties::CvParameterEnabledPropertyId, srcParameterVT [CvParameterProperties::CvParameterEnabledPropertyId], nullptr);
+        dstParameterVT.setProperty (CvParameterProperties::CvParameterAttenuatePropertyId, srcParameterVT [CvParameterProperties::CvParameterAttenuatePropertyId], nullptr);
+        dstParameterVT.setProperty (CvParameterProperties::CvParameterOffsetPropertyId, srcParameterVT [CvParameterProperties::CvParameterOffsetPropertyId], nullptr);
+    }
+}
 
-    return cvParameterVT;
+bool SquidChannelProperties::isCvAssignEqual (SquidChannelProperties& otherChannelProperties, int cvIndex)
+{
+    const auto* cvParameterRow { getCvParameterRow (cvIndex) };
+    const auto* otherCvParameterRow { otherChannelProperties.getCvParameterRow (cvIndex) };
+    for (auto parameterId { 0 }; parameterId < kNumCvParameterIds; ++parameterId)
+    {
+        const auto& parameterVT { cvParameterRow [parameterId] };
+        const auto& otherParameterVT { otherCvParameterRow [parameterId] };
+        if (parameterVT.isValid () != otherParameterVT.isValid ())
+            return false;
+        if (! parameterVT.isValid ())
+            continue;
+        if (parameterVT [CvParameterProperties::CvParameterEnabledPropertyId] != otherParameterVT [CvParameterProperties::CvParameterEnabledPropertyId] ||
+            parameterVT [CvParameterProperties::CvParameterAttenuatePropertyId] != otherParameterVT [CvParameterProperties::CvParameterAttenuatePropertyId] ||
+            parameterVT [CvParameterProperties::CvParameterOffsetPropertyId] != otherParameterVT [CvParameterProperties::CvParameterOffsetPropertyId])
+            return false;
+    }
+    return true;
 }
 
 uint32_t SquidChannelProperties::byteOffsetToSampleOffset (uint32_t byteOffset)
@@ -900,11 +1015,10 @@ void SquidChannelProperties::forEachCvParameter (int cvAssignIndex, std::functio
 {
     jassert (cvParamarterCallback != nullptr);
 
-    auto cvInputVT { getCvAssignVT (cvAssignIndex) };
-    ValueTreeHelpers::forEachChildOfType (cvInputVT, CvParameterProperties::CvParameterTypeId, [this, cvParamarterCallback] (juce::ValueTree cvParameterVT)
-    {
-        return cvParamarterCallback (cvParameterVT);
-    });
+    const auto* cvParameterRow { getCvParameterRow (cvAssignIndex) };
+    for (auto parameterId { 0 }; parameterId < kNumCvParameterIds; ++parameterId)
+        if (cvParameterRow [parameterId].isValid () && ! cvParamarterCallback (cvParameterRow [parameterId]))
+            break;
 }
 
 juce::ValueTree SquidChannelProperties::getCueSetVT (int cueSetIndex)
@@ -961,26 +1075,14 @@ AudioBufferRefCounted::RefCountedPtr SquidChannelProperties::getSampleDataAudioB
 
 void SquidChannelProperties::copyFrom (juce::ValueTree sourceVT, CopyType copyType, CheckIndex checkIndex)
 {
+    ScopedTransaction transaction (*this);
     SquidChannelProperties sourceChannelProperties (sourceVT, SquidChannelProperties::WrapperType::client, SquidChannelProperties::EnableCallbacks::no);
 
     if (copyType == CopyType::all)
     {
-        // TODO - this is the same code I just updated in the EditManager. I need to abstract and reuse
         // Copy CV Assigns
-        for (auto curCvInputIndex { 0 }; curCvInputIndex < kCvInputsCount + kCvInputsExtra; ++curCvInputIndex)
-        {
-            SquidChannelProperties srcChannelProperties { sourceVT, SquidChannelProperties::WrapperType::client, SquidChannelProperties::EnableCallbacks::no };
-            srcChannelProperties.forEachCvParameter (curCvInputIndex, [this, curCvInputIndex] (juce::ValueTree srcParameterVT)
-            {
-                CvParameterProperties srcCvParameterProperties { srcParameterVT, CvParameterProperties::WrapperType::client, CvParameterProperties::EnableCallbacks::no };
-                const auto cvParameterId { srcCvParameterProperties.getId () };
-                CvParameterProperties dstCvParameterProperties { getCvParameterVT (curCvInputIndex, cvParameterId), CvParameterProperties::WrapperType::client, CvParameterProperties::EnableCallbacks::no };
-                dstCvParameterProperties.setEnabled (srcCvParameterProperties.getEnabled (), false);
-                dstCvParameterProperties.setAttenuation (srcCvParameterProperties.getAttenuation (), false);
-                dstCvParameterProperties.setOffset (srcCvParameterProperties.getOffset (), false);
-                return true;
-            });
-        }
+        for (auto curCvInputIndex { 0 }; curCvInputIndex < kNumCvInputs; ++curCvInputIndex)
+            copyCvAssignFrom (sourceChannelProperties, curCvInputIndex, curCvInputIndex);
 
         // Clear old Cue Sets
         auto dstCueSetListVT { data.getChildWithName (SquidChannelProperties::CueSetListTypeId) };
@@ -1083,6 +1185,241 @@ void SquidChannelProperties::copyFrom (juce::ValueTree sourceVT, CopyType copyTy
     }
 }
 
+// the reserved sections in ChannelRecord::reservedData order
+struct ReservedDataAccessor
+{
+    void (SquidChannelProperties::*setData) (ReservedDataRefCounted::RefCountedPtr reservedData);
+    ReservedDataRefCounted::RefCountedPtr (SquidChannelProperties::*getData) ();
+};
+static const ReservedDataAccessor kReservedDataAccessors [ChannelRecord::kNumReservedSections]
+{
+    { &SquidChannelProperties::setReserved1Data, &SquidChannelProperties::getReserved1Data },
+    { &SquidChannelProperties::setReserved2Data, &SquidChannelProperties::getReserved2Data },
+    { &SquidChannelProperties::setReserved3Data, &SquidChannelProperties::getReserved3Data },
+    { &SquidChannelProperties::setReserved4Data, &SquidChannelProperties::getReserved4Data },
+    { &SquidChannelProperties::setReserved5Data, &SquidChannelProperties::getReserved5Data },
+    { &SquidChannelProperties::setReserved6Data, &SquidChannelProperties::getReserved6Data },
+    { &SquidChannelProperties::setReserved7Data, &SquidChannelProperties::getReserved7Data },
+    { &SquidChannelProperties::setReserved8Data, &SquidChannelProperties::getReserved8Data },
+    { &SquidChannelProperties::setReserved9Data, &SquidChannelProperties::getReserved9Data },
+    { &SquidChannelProperties::setReserved10Data, &SquidChannelProperties::getReserved10Data },
+    { &SquidChannelProperties::setReserved11Data, &SquidChannelProperties::getReserved11Data },
+    { &SquidChannelProperties::setReserved12Data, &SquidChannelProperties::getReserved12Data },
+    { &SquidChannelProperties::setReserved13Data, &SquidChannelProperties::getReserved13Data },
+    { &SquidChannelProperties::setReserved14Data, &SquidChannelProperties::getReserved14Data },
+    { &SquidChannelProperties::setReserved15Data, &SquidChannelProperties::getReserved15Data },
+};
+
+// the equivalent of copyFrom (CopyType::all, CheckIndex::no) from a record. the CV parameters and cue sets are each visited once, instead of being looked up by id/index
+void SquidChannelProperties::applyChannelRecord (const ChannelRecord& channelRecord)
+{
+    ScopedTransaction transaction (*this);
+    // CV Assigns
+    for (auto curCvInputIndex { 0 }; curCvInputIndex < ChannelRecord::kNumCvInputs; ++curCvInputIndex)
+    {
+        auto* cvParameterRow { getCvParameterRow (curCvInputIndex) };
+        const auto& cvInputAssigns { channelRecord.cvAssigns [curCvInputIndex] };
+        for (auto parameterId { 0 }; parameterId < kNumCvParameterIds; ++parameterId)
+        {
+            auto& cvParameterVT { cvParameterRow [parameterId] };
+            if (! cvParameterVT.isValid ())
+                continue;
+            const auto& cvAssign { cvInputAssigns [static_cast<size_t> (parameterId)] };
+            cvParameterVT.setProperty (CvParameterProperties::CvParameterEnabledPropertyId, cvAssign.enabled, nullptr);
+            cvParameterVT.setProperty (CvParameterProperties::CvParameterAttenuatePropertyId, static_cast<int> (cvAssign.attenuation), nullptr);
+            cvParameterVT.setProperty (CvParameterProperties::CvParameterOffsetPropertyId, static_cast<int> (cvAssign.offset), nullptr);
+        }
+    }
+
+    // Cue Sets
+    auto cueSetListVT { data.getChildWithName (SquidChannelProperties::CueSetListTypeId) };
+    jassert (cueSetListVT.isValid ());
+    cueSetListVT.removeAllChildren (nullptr);
+    for (auto curCueSetIndex { 0 }; curCueSetIndex < channelRecord.numCueSets; ++curCueSetIndex)
+    {
+        const auto& cueSet { channelRecord.cueSets [static_cast<size_t> (curCueSetIndex)] };
+        juce::ValueTree cueSetVT { CueSetTypeId };
+        cueSetVT.setProperty (CueSetIdPropertyId, curCueSetIndex + 1, nullptr);
+        cueSetVT.setProperty (CueSetStartPropertyId, static_cast<int> (cueSet.start), nullptr);
+        cueSetVT.setProperty (CueSetLoopPropertyId, static_cast<int> (cueSet.loop), nullptr);
+        cueSetVT.setProperty (CueSetEndPropertyId, static_cast<int> (cueSet.end), nullptr);
+        cueSetListVT.addChild (cueSetVT, -1, nullptr);
+    }
+
+    // properties
+    setAttack (channelRecord.attack, false);
+    setBits (channelRecord.bits, false);
+    setChannelFlags (channelRecord.channelFlags, false);
+    setChannelSource (channelRecord.channelSource, false);
+    setChoke (channelRecord.choke, false);
+    setNumCueSets (channelRecord.numCueSets, false);
+    setCurCueSet (channelRecord.curCueSet, false);
+    setDecay (channelRecord.decay, false);
+    setSampleFileName (channelRecord.sampleFileName, false);
+    setEndCue (channelRecord.endCue, false);
+    setETrig (channelRecord.eTrig, false);
+    setFilterFrequency (channelRecord.filterFrequency, false);
+    setFilterResonance (channelRecord.filterResonance, false);
+    setFilterType (channelRecord.filterType, false);
+    setLoadedVersion (channelRecord.loadedVersion, false);
+    setLoopCue (channelRecord.loopCue, false);
+    setLoopMode (channelRecord.loopMode, false);
+    setLevel (channelRecord.level, false);
+    setQuant (channelRecord.quant, false);
+    setPitchShift (channelRecord.pitchShift, false);
+    setRate (channelRecord.rate, false);
+    setRecDest (channelRecord.recDest, false);
+    setReverse (channelRecord.reverse, false);
+    setEndOfData (channelRecord.endOfData, false);
+    setSpeed (channelRecord.speed, false);
+    setStartCue (channelRecord.startCue, false);
+    setSteps (channelRecord.steps, false);
+    setXfade (channelRecord.xfade, false);
+
+    // reserved data
+    for (auto reservedIndex { 0 }; reservedIndex < ChannelRecord::kNumReservedSections; ++reservedIndex)
+    {
+        const auto& reservedData { channelRecord.reservedData [static_cast<size_t> (reservedIndex)] };
+        (this->*kReservedDataAccessors [reservedIndex].setData) (reservedData != nullptr ? reservedData : getDefaultReservedData (reservedIndex));
+    }
+
+    // raw sample info
+    setSampleDataBits (channelRecord.sampleDataBits, false);
+    setSampleDataSampleRate (channelRecord.sampleDataSampleRate, false);
+    setSampleDataNumSamples (channelRecord.sampleDataNumSamples, false);
+    setSampleDataNumChannels (channelRecord.sampleDataNumChannels, false);
+    setSampleDataAudioBuffer (channelRecord.sampleDataAudioBuffer, false);
+}
+
+// a hash of the state compared by BankHelpers::areChannelsEqual, so two channels can be compared by their digests. it has to cover the same properties as that comparison
+uint64_t SquidChannelProperties::getDigest ()
+{
+    juce::MemoryOutputStream digestData (2048);
+    for (auto curCvInputIndex { 0 }; curCvInputIndex < kNumCvInputs; ++curCvInputIndex)
+    {
+        const auto* cvParameterRow { getCvParameterRow (curCvInputIndex) };
+        for (auto parameterId { 0 }; parameterId < kNumCvParameterIds; ++parameterId)
+        {
+            const auto& cvParameterVT { cvParameterRow [parameterId] };
+            digestData.writeBool (cvParameterVT.isValid ());
+            if (! cvParameterVT.isValid ())
+                continue;
+            digestData.writeBool (static_cast<bool> (cvParameterVT [CvParameterProperties::CvParameterEnabledPropertyId]));
+            digestData.writeInt (static_cast<int> (cvParameterVT [CvParameterProperties::CvParameterAttenuatePropertyId]));
+            digestData.writeInt (static_cast<int> (cvParameterVT [CvParameterProperties::CvParameterOffsetPropertyId]));
+        }
+    }
+
+    const auto numCueSets { getNumCueSets () };
+    digestData.writeInt (numCueSets);
+    for (auto cueSetIndex { 0 }; cueSetIndex < numCueSets; ++cueSetIndex)
+    {
+        digestData.writeInt (static_cast<int> (getStartCueSet (cueSetIndex)));
+        digestData.writeInt (static_cast<int> (getLoopCueSet (cueSetIndex)));
+        digestData.writeInt (static_cast<int> (getEndCueSet (cueSetIndex)));
+    }
+
+    digestData.writeInt (getAttack ());
+    digestData.writeInt (getBits ());
+    digestData.writeShort (static_cast<short> (getChannelFlags ()));
+    digestData.writeByte (static_cast<char> (getChannelSource ()));
+    digestData.writeInt (getChoke ());
+    digestData.writeInt (getCurCueSet ());
+    digestData.writeInt (getDecay ());
+    digestData.writeInt (getETrig ());
+    digestData.writeInt (static_cast<int> (getEndCue ()));
+    digestData.writeInt (getFilterFrequency ());
+    digestData.writeInt (getFilterResonance ());
+    digestData.writeInt (getFilterType ());
+    digestData.writeInt (getLevel ());
+    digestData.writeInt (static_cast<int> (getLoopCue ()));
+    digestData.writeInt (getLoopMode ());
+    digestData.writeInt (getQuant ());
+    digestData.writeInt (getPitchShift ());
+    digestData.writeInt (getRate ());
+    digestData.writeInt (getRecDest ());
+    digestData.writeInt (getReverse ());
+    digestData.writeInt (getSpeed ());
+    digestData.writeInt (static_cast<int> (getStartCue ()));
+    digestData.writeString (getSampleFileName ());
+    digestData.writeInt (getSteps ());
+    digestData.writeInt (getXfade ());
+
+    return Hash64::hash (digestData.getData (), digestData.getDataSize ());
+}
+
+ChannelRecord SquidChannelProperties::getChannelRecord ()
+{
+    ChannelRecord channelRecord;
+
+    for (auto curCvInputIndex { 0 }; curCvInputIndex < ChannelRecord::kNumCvInputs; ++curCvInputIndex)
+    {
+        const auto* cvParameterRow { getCvParameterRow (curCvInputIndex) };
+        auto& cvInputAssigns { channelRecord.cvAssigns [curCvInputIndex] };
+        for (auto parameterId { 0 }; parameterId < kNumCvParameterIds; ++parameterId)
+        {
+            const auto& cvParameterVT { cvParameterRow [parameterId] };
+            if (! cvParameterVT.isValid ())
+                continue;
+            auto& cvAssign { cvInputAssigns [static_cast<size_t> (parameterId)] };
+            cvAssign.enabled = static_cast<bool> (cvParameterVT [CvParameterProperties::CvParameterEnabledPropertyId]);
+            cvAssign.attenuation = static_cast<int16_t> (static_cast<int> (cvParameterVT [CvParameterProperties::CvParameterAttenuatePropertyId]));
+            cvAssign.offset = static_cast<uint16_t> (static_cast<int> (cvParameterVT [CvParameterProperties::CvParameterOffsetPropertyId]));
+        }
+    }
+
+    channelRecord.numCueSets = 0;
+    ValueTreeHelpers::forEachChildOfType (data.getChildWithName (CueSetListTypeId), CueSetTypeId, [&channelRecord] (juce::ValueTree cueSetVT)
+    {
+        auto& cueSet { channelRecord.cueSets [static_cast<size_t> (channelRecord.numCueSets)] };
+        cueSet.start = static_cast<uint32_t> (static_cast<int> (cueSetVT.getProperty (CueSetStartPropertyId)));
+        cueSet.loop = static_cast<uint32_t> (static_cast<int> (cueSetVT.getProperty (CueSetLoopPropertyId)));
+        cueSet.end = static_cast<uint32_t> (static_cast<int> (cueSetVT.getProperty (CueSetEndPropertyId)));
+        ++channelRecord.numCueSets;
+        return channelRecord.numCueSets < kCueNumSets;
+    });
+    channelRecord.curCueSet = getCurCueSet ();
+
+    channelRecord.loadedVersion = getLoadedVersion ();
+    channelRecord.channelIndex = getChannelIndex ();
+    channelRecord.channelSource = getChannelSource ();
+    channelRecord.choke = static_cast<uint8_t> (getChoke ());
+    channelRecord.recDest = static_cast<uint8_t> (getRecDest ());
+    channelRecord.bits = static_cast<uint8_t> (getBits ());
+    channelRecord.rate = static_cast<uint8_t> (getRate ());
+    channelRecord.loopMode = static_cast<uint8_t> (getLoopMode ());
+    channelRecord.reverse = static_cast<uint8_t> (getReverse ());
+    channelRecord.xfade = static_cast<uint8_t> (getXfade ());
+    channelRecord.eTrig = static_cast<uint8_t> (getETrig ());
+    channelRecord.quant = static_cast<uint8_t> (getQuant ());
+    channelRecord.steps = static_cast<uint8_t> (getSteps ());
+    channelRecord.filterType = static_cast<uint8_t> (getFilterType ());
+    channelRecord.attack = static_cast<uint16_t> (getAttack ());
+    channelRecord.decay = static_cast<uint16_t> (getDecay ());
+    channelRecord.level = static_cast<uint16_t> (getLevel ());
+    channelRecord.speed = static_cast<uint16_t> (getSpeed ());
+    channelRecord.filterFrequency = static_cast<uint16_t> (getFilterFrequency ());
+    channelRecord.filterResonance = static_cast<uint16_t> (getFilterResonance ());
+    channelRecord.pitchShift = static_cast<uint16_t> (getPitchShift ());
+    channelRecord.channelFlags = getChannelFlags ();
+    channelRecord.startCue = getStartCue ();
+    channelRecord.loopCue = getLoopCue ();
+    channelRecord.endCue = getEndCue ();
+    channelRecord.endOfData = getEndOfData ();
+    channelRecord.sampleFileName = getSampleFileName ();
+
+    for (auto reservedIndex { 0 }; reservedIndex < ChannelRecord::kNumReservedSections; ++reservedIndex)
+        channelRecord.reservedData [static_cast<size_t> (reservedIndex)] = (this->*kReservedDataAccessors [reservedIndex].getData) ();
+
+    channelRecord.sampleDataBits = getSampleDataBits ();
+    channelRecord.sampleDataSampleRate = getSampleDataSampleRate ();
+    channelRecord.sampleDataNumSamples = getSampleDataNumSamples ();
+    channelRecord.sampleDataNumChannels = getSampleDataNumChannels ();
+    channelRecord.sampleDataAudioBuffer = getSampleDataAudioBuffer ();
+
+    return channelRecord;
+}
+
 juce::ValueTree SquidChannelProperties::create (uint8_t channelIndex)
 {
     SquidChannelProperties squidChannelProperties;
@@ -1092,6 +1429,9 @@ juce::ValueTree SquidChannelProperties::create (uint8_t channelIndex)
 
 void SquidChannelProperties::valueTreePropertyChanged (juce::ValueTree& vt, const juce::Identifier& property)
 {
+    if (deferPropertyChange (vt, property))
+        return;
+
     if (vt.getType () == CvParameterProperties::CvParameterTypeId)
     {
         auto parentCvInputVT { vt.getParent () };
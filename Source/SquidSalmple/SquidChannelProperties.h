@@ -1,6 +1,7 @@
 #pragma once
 
 #include <JuceHeader.h>
+#include "Metadata/SquidSalmpleDefs.h"
 #include "../Utility/ValueTreeWrapper.h"
 
 using AudioBufferType = juce::AudioBuffer<float>;
@@ -26,11 +27,28 @@ private:
     std::unique_ptr<AudioBufferType> audioBuffer;
 };
 
+// the 'reserved' sections of the metadata are kept as the raw bytes. the data is never modified, so trees can share it instead of each holding a copy
+class ReservedDataRefCounted : public juce::ReferenceCountedObject
+{
+public:
+    ReservedDataRefCounted (const void* sourceData, size_t sourceSize) : reservedData (sourceData, sourceSize) {}
+    using RefCountedPtr = juce::ReferenceCountedObjectPtr<ReservedDataRefCounted>;
+
+    const juce::MemoryBlock& getData () const { return reservedData; }
+
+private:
+    const juce::MemoryBlock reservedData;
+};
+
+struct ChannelRecord;
+
 class SquidChannelProperties : public ValueTreeWrapper<SquidChannelProperties>
 {
 public:
     enum CopyType { mainSettings, all };
     enum CheckIndex { no, yes };
+    static constexpr int kNumCvInputs { kCvInputsCount + kCvInputsExtra };
+    static constexpr int kNumCvParameterIds { CvParameterIndex::PitchShift + 1 }; // indexed by CvParameterIndex, none2 has no tree
     SquidChannelProperties () noexcept : ValueTreeWrapper (SquidChannelTypeId)
     {
     }
@@ -79,21 +97,21 @@ public:
     void setStartCueSet (int cueSetIndex, uint32_t startCue, bool includeSelfCallback);
     void setSteps (int steps, bool includeSelfCallback);
     void setXfade (int xfade, bool includeSelfCallback);
-    void setReserved1Data (juce::String reservedData);
-    void setReserved2Data (juce::String reservedData);
-    void setReserved3Data (juce::String reservedData);
-    void setReserved4Data (juce::String reservedData);
-    void setReserved5Data (juce::String reservedData);
-    void setReserved6Data (juce::String reservedData);
-    void setReserved7Data (juce::String reservedData);
-    void setReserved8Data (juce::String reservedData);
-    void setReserved9Data (juce::String reservedData);
-    void setReserved10Data (juce::String reservedData);
-    void setReserved11Data (juce::String reservedData);
-    void setReserved12Data (juce::String reservedData);
-    void setReserved13Data (juce::String reservedData);
-    void setReserved14Data (juce::String reservedData);
-    void setReserved15Data (juce::String reservedData);
+    void setReserved1Data (ReservedDataRefCounted::RefCountedPtr reservedData);
+    void setReserved2Data (ReservedDataRefCounted::RefCountedPtr reservedData);
+    void setReserved3Data (ReservedDataRefCounted::RefCountedPtr reservedData);
+    void setReserved4Data (ReservedDataRefCounted::RefCountedPtr reservedData);
+    void setReserved5Data (ReservedDataRefCounted::RefCountedPtr reservedData);
+    void setReserved6Data (ReservedDataRefCounted::RefCountedPtr reservedData);
+    void setReserved7Data (ReservedDataRefCounted::RefCountedPtr reservedData);
+    void setReserved8Data (ReservedDataRefCounted::RefCountedPtr reservedData);
+    void setReserved9Data (ReservedDataRefCounted::RefCountedPtr reservedData);
+    void setReserved10Data (ReservedDataRefCounted::RefCountedPtr reservedData);
+    void setReserved11Data (ReservedDataRefCounted::RefCountedPtr reservedData);
+    void setReserved12Data (ReservedDataRefCounted::RefCountedPtr reservedData);
+    void setReserved13Data (ReservedDataRefCounted::RefCountedPtr reservedData);
+    void setReserved14Data (ReservedDataRefCounted::RefCountedPtr reservedData);
+    void setReserved15Data (ReservedDataRefCounted::RefCountedPtr reservedData);
     void triggerLoadBegin (bool includeSelfCallback);
     void triggerLoadComplete (bool includeSelfCallback);
 
@@ -138,21 +156,21 @@ public:
     uint32_t getStartCueSet (int cueSetIndex);
     int getSteps ();
     int getXfade ();
-    juce::String getReserved1Data ();
-    juce::String getReserved2Data ();
-    juce::String getReserved3Data ();
-    juce::String getReserved4Data ();
-    juce::String getReserved5Data ();
-    juce::String getReserved6Data ();
-    juce::String getReserved7Data ();
-    juce::String getReserved8Data ();
-    juce::String getReserved9Data ();
-    juce::String getReserved10Data ();
-    juce::String getReserved11Data ();
-    juce::String getReserved12Data ();
-    juce::String getReserved13Data ();
-    juce::String getReserved14Data ();
-    juce::String getReserved15Data ();
+    ReservedDataRefCounted::RefCountedPtr getReserved1Data ();
+    ReservedDataRefCounted::RefCountedPtr getReserved2Data ();
+    ReservedDataRefCounted::RefCountedPtr getReserved3Data ();
+    ReservedDataRefCounted::RefCountedPtr getReserved4Data ();
+    ReservedDataRefCounted::RefCountedPtr getReserved5Data ();
+    ReservedDataRefCounted::RefCountedPtr getReserved6Data ();
+    ReservedDataRefCounted::RefCountedPtr getReserved7Data ();
+    ReservedDataRefCounted::RefCountedPtr getReserved8Data ();
+    ReservedDataRefCounted::RefCountedPtr getReserved9Data ();
+    ReservedDataRefCounted::RefCountedPtr getReserved10Data ();
+    ReservedDataRefCounted::RefCountedPtr getReserved11Data ();
+    ReservedDataRefCounted::RefCountedPtr getReserved12Data ();
+    ReservedDataRefCounted::RefCountedPtr getReserved13Data ();
+    ReservedDataRefCounted::RefCountedPtr getReserved14Data ();
+    ReservedDataRefCounted::RefCountedPtr getReserved15Data ();
 
     int getSampleDataBits ();
     double getSampleDataSampleRate ();
@@ -207,11 +225,17 @@ public:
     std::function<void (AudioBufferRefCounted::RefCountedPtr audioBufferRefCountedObj)> onSampleDataAudioBufferChange;
 
     void copyFrom (juce::ValueTree sourceVT, CopyType copyType, CheckIndex checkIndex);
+    void applyChannelRecord (const ChannelRecord& channelRecord);
+    ChannelRecord getChannelRecord ();
+    uint64_t getDigest ();
     juce::ValueTree getCvAssignVT (int cvIndex);
     juce::ValueTree getCvParameterVT (int cvIndex, int paramterId);
     void forEachCvParameter (int cvAssignIndex, std::function<bool (juce::ValueTree)> cvParamarterCallback);
+    void copyCvAssignFrom (SquidChannelProperties& sourceChannelProperties, int sourceCvIndex, int cvIndex);
+    bool isCvAssignEqual (SquidChannelProperties& otherChannelProperties, int cvIndex);
 
     static juce::ValueTree create (uint8_t channelIndex);
+    static ReservedDataRefCounted::RefCountedPtr getDefaultReservedData (int reservedIndex);
     static uint32_t byteOffsetToSampleOffset (uint32_t byteOffset);
     static uint32_t sampleOffsetToByteOffset (uint32_t sampleOffset);
 
@@ -287,9 +311,23 @@ public:
 
     void initValueTree ();
     void processValueTree () {}
+    // sets every default one property and child at a time, which is how the prebuilt default tree is made. new trees are copies of that one,
+    // this is only called directly to compare against it (see Benchmark)
+    void buildDefaultValueTree ();
 
 private:
+    // the cv input and cv parameter trees, by cv index and parameter id, so they are found without searching the children. the cv children are
+    // never added or removed once the tree is built, so the index is only rebuilt when a cv input is no longer in 'data' (ie. the wrapper was
+    // pointed at a different tree, or the children were replaced)
+    std::array<juce::ValueTree, kNumCvInputs> cvInputIndex;
+    std::array<juce::ValueTree, kNumCvInputs * kNumCvParameterIds> cvParameterIndex;
+
+    static const juce::ValueTree& getDefaultValueTree ();
     juce::ValueTree getCueSetVT (int cueSetIndex);
+    juce::ValueTree* getCvParameterRow (int cvIndex);
+    void buildCvParameterIndex ();
+    ReservedDataRefCounted::RefCountedPtr getReservedData (const juce::Identifier& reservedDataPropertyId);
+    void setReservedData (ReservedDataRefCounted::RefCountedPtr reservedData, const juce::Identifier& reservedDataPropertyId);
 
     void valueTreePropertyChanged (juce::ValueTree& vt, const juce::Identifier& property) override;
 };
@@ -1,11 +1,42 @@
 #pragma once
 
-template <typename T>
+#include <JuceHeader.h>
+
+#if defined (__ARM_FEATURE_CRC32)
+ #include <arm_acle.h>
+ #define CRC_USE_ARM_CRC32 1
+#endif
+
+namespace CrcTables
+{
+    // slice-by-8 tables for a reflected crc. table [0] is the classic byte at a time table, table [n] advances a byte through n more zero bytes
+    template <typename T, T kPolynomial>
+    constexpr std::array<std::array<T, 256>, 8> makeTables () noexcept
+    {
+        std::array<std::array<T, 256>, 8> tables {};
+        for (uint32_t byteValue { 0 }; byteValue < 256; ++byteValue)
+        {
+            auto crc { static_cast<T> (byteValue) };
+            for (int bit { 0 }; bit < 8; ++bit)
+                crc = static_cast<T> ((crc & 1) != 0 ? (crc >> 1) ^ kPolynomial : (crc >> 1));
+            tables [0][byteValue] = crc;
+        }
+        for (size_t tableIndex { 1 }; tableIndex < tables.size (); ++tableIndex)
+            for (size_t byteValue { 0 }; byteValue < 256; ++byteValue)
+                tables [tableIndex][byteValue] = static_cast<T> ((tables [tableIndex - 1][byteValue] >> 8) ^ tables [0][tables [tableIndex - 1][byteValue] & 0xFF]);
+        return tables;
+    }
+
+    template <typename T, T kPolynomial>
+    inline constexpr auto kTables { makeTables<T, kPolynomial> () };
+};
+
+// NOTE: the crc starts at 0, and is not inverted at the end, so the values match the original bit at a time implementation
+template <typename T, T kPolynomial>
 class Crc
 {
 public:
     Crc () = default;
-    virtual ~Crc () = default;
 
     void reset () noexcept
     {
@@ -17,67 +48,62 @@ public:
         return crc;
     }
 
-    T updateBuffer (uint8_t* data, int len)
+    T update (uint8_t byte) noexcept
+    {
+        crc = static_cast<T> ((crc >> 8) ^ kTables [0][(crc ^ byte) & 0xFF]);
+        return crc;
+    }
+
+    T updateBuffer (const uint8_t* data, int len) noexcept
     {
-        while (len > 0)
+        // eight bytes at a time, then any remaining bytes one at a time
+        for (; len >= 8; data += 8, len -= 8)
         {
-            update (*data);
-            ++data;
-            --len;
+            uint64_t eightBytes;
+            std::memcpy (&eightBytes, data, sizeof (eightBytes));
+            eightBytes = juce::ByteOrder::swapIfBigEndian (eightBytes) ^ crc;
+            crc = static_cast<T> (kTables [7][eightBytes & 0xFF] ^ kTables [6][(eightBytes >> 8) & 0xFF] ^
+                                  kTables [5][(eightBytes >> 16) & 0xFF] ^ kTables [4][(eightBytes >> 24) & 0xFF] ^
+                                  kTables [3][(eightBytes >> 32) & 0xFF] ^ kTables [2][(eightBytes >> 40) & 0xFF] ^
+                                  kTables [1][(eightBytes >> 48) & 0xFF] ^ kTables [0][eightBytes >> 56]);
         }
+        for (; len > 0; ++data, --len)
+            update (*data);
 
         return crc;
     }
 
-    virtual T update (uint8_t byte) = 0;
-
 protected:
+    static constexpr const auto& kTables { CrcTables::kTables<T, kPolynomial> };
     T crc { 0 };
 };
 
-class Crc16 : public Crc<uint16_t>
+// CRC-16/ARC polynomial
+class Crc16 : public Crc<uint16_t, 0xA001>
 {
-public:
-    Crc16 () = default;
-    virtual ~Crc16 () = default;
-    uint16_t update (uint8_t byte) noexcept override
-    {
-        // C implementation of CRC16
-        crc ^= byte;
-        for (int i { 0 }; i < 8; ++i)
-        {
-            if (crc & 1)
-                crc = (crc >> 1) ^ 0xA001;
-            else
-                crc = (crc >> 1);
-        }
-
-        return crc;
-    }
 };
 
-class Crc32 : public Crc<uint32_t>
+class Crc32 : public Crc<uint32_t, 0xEDB88320U>
 {
 public:
     static constexpr uint32_t DELOREAN_CRC32_SEED = 0xEDB88320U;
 
-    virtual ~Crc32 () = default;
-    uint32_t update (uint8_t byte) noexcept override
+#if CRC_USE_ARM_CRC32
+    // the ARMv8 crc32 instructions use the same (reflected 0x04C11DB7) polynomial, without any inversion
+    uint32_t updateBuffer (const uint8_t* data, int len) noexcept
     {
-        // C implementation of CRC32
-        crc ^= byte;
-        for (int j = 7; j >= 0; j--)
-        {    // Do eight times.
-            //const uint32_t mask = -(crc & 1U);
-            // the previous line was producing a warning under VS
-            //   warning C4146: unary minus operator applied to unsigned type, result still unsigned
-            // I wrote a test and verified the following line produces the same values, and no warning
-            const uint32_t mask = (uint32_t)-(int32_t)(crc & 1U);
-            crc = (crc >> 1U) ^ (DELOREAN_CRC32_SEED & mask);
+        for (; len >= 8; data += 8, len -= 8)
+        {
+            uint64_t eightBytes;
+            std::memcpy (&eightBytes, data, sizeof (eightBytes));
+            crc = __crc32d (crc, juce::ByteOrder::swapIfBigEndian (eightBytes));
         }
+        for (; len > 0; ++data, --len)
+            crc = __crc32b (crc, *data);
 
         return crc;
     }
+#endif
 };
 
 /*
@@ -4,10 +4,11 @@
 #define USE_DEFERRED_LOGGER 1
 
 static auto startTime { juce::Time::currentTimeMillis () };
-static auto lastTime { startTime };
 
 #if USE_DEFERRED_LOGGER
-static auto debugLogger { ThreadedLogger () };
+static ThreadedLogger debugLogger { startTime };
+#else
+static auto lastTime { startTime };
 #endif
 
 namespace DebugLogger
@@ -15,10 +16,12 @@ namespace DebugLogger
     using ThreadIdAndName = std::pair<juce::Thread::ThreadID, juce::String>;
     std::vector<ThreadIdAndName> UnnamedThreads;
     juce::CriticalSection UnnamedThreadsCS;
+    std::atomic<int> unnamedThreadsVersion { 0 };
     void addUnnamedThread (juce::Thread::ThreadID threadID, juce::String threadName)
     {
         juce::ScopedLock sl (UnnamedThreadsCS);
         UnnamedThreads.push_back ({ threadID, threadName });
+        unnamedThreadsVersion.fetch_add (1, std::memory_order_release);
     }
     juce::String getUnnamedThread (juce::Thread::ThreadID threadID)
     {
@@ -31,6 +34,25 @@ namespace DebugLogger
             return "";
         return std::get<1> (*threadIdAndNameIter);
     }
+
+    // the name is looked up on the first log from a thread, and kept for that thread, so after that a log line takes no lock and allocates nothing for
+    // the name (the copy only shares the string). a thread without a name is kept as its id, until another unnamed thread is added, when it is looked up again
+    juce::String getCurrentThreadName ()
+    {
+        thread_local juce::String currentThreadName;
+        thread_local auto isUnnamedThread { false };
+        thread_local auto lookedUpUnnamedThreadsVersion { 0 };
+        if (currentThreadName.isNotEmpty () && (! isUnnamedThread || lookedUpUnnamedThreadsVersion == unnamedThreadsVersion.load (std::memory_order_acquire)))
+            return currentThreadName;
+
+        lookedUpUnnamedThreadsVersion = unnamedThreadsVersion.load (std::memory_order_acquire);
+        const auto curThread { juce::Thread::getCurrentThread () };
+        const auto curThreadName { juce::MessageManager::existsAndIsCurrentThread () ? "MessageManager" : (curThread != nullptr ? curThread->getThreadName () : "") };
+        const auto threadName { curThreadName.isNotEmpty () ? curThreadName : getUnnamedThread (juce::Thread::getCurrentThreadId ()) };
+        isUnnamedThread = threadName.isEmpty ();
+        currentThreadName = isUnnamedThread ? juce::String::toHexString ((uint64_t) juce::Thread::getCurrentThreadId ()).paddedLeft ('0', 8) : threadName;
+        return currentThreadName;
+    }
 }
 
 void FlushDebugLog ()
@@ -42,19 +64,12 @@ void FlushDebugLog ()
 
 void DebugLog (juce::String moduleName, juce::String logLine)
 {
-    const auto curTime { juce::Time::currentTimeMillis () };
-    const auto curThreadId { juce::String::toHexString ((uint64_t) juce::Thread::getCurrentThreadId ()).paddedLeft ('0', 8) };
-    const auto curThread { juce::Thread::getCurrentThread () };
-    const auto curThreadName { juce::MessageManager::existsAndIsCurrentThread () ? "MessageManager" : (curThread != nullptr ? juce::Thread::getCurrentThread ()->getThreadName () : "") };
-    const auto possibleUnnamedThreadName { DebugLogger::getUnnamedThread (juce::Thread::getCurrentThreadId ()) };
-    const auto threadIdToDisplay { curThreadName.isNotEmpty () ? curThreadName : (possibleUnnamedThreadName.isNotEmpty () ? possibleUnnamedThreadName : curThreadId) };
-    const auto timeSinceStart { juce::String (curTime - startTime).paddedLeft ('0', 10) };
-    const auto timeSincePreviousLog { juce::String (curTime - lastTime).paddedLeft ('0', 4) };
-    const juce::String logMsg { "[" + timeSinceStart + "]+" + timeSincePreviousLog + " [t:" + threadIdToDisplay + "]" + " (" + moduleName + ") -> " + logLine };
+    LogRecord logRecord { juce::Time::currentTimeMillis (), DebugLogger::getCurrentThreadName (), std::move (moduleName), std::move (logLine) };
 #if USE_DEFERRED_LOGGER
-    debugLogger.logMsg (logMsg);
+    // formatting is done by the logger thread
+    debugLogger.logMsg (std::move (logRecord));
 #else
-    juce::Logger::writeToLog (logMsg);
+    juce::Logger::writeToLog (formatLogRecord (logRecord, startTime, lastTime));
+    lastTime = logRecord.time;
 #endif
-    lastTime = curTime;
 }
@@ -2,51 +2,139 @@
 
 #include <JuceHeader.h>
 
+struct LogRecord
+{
+    juce::int64 time { 0 };
+    juce::String threadName;
+    juce::String moduleName;
+    juce::String logLine;
+};
+
+inline juce::String formatLogRecord (const LogRecord& logRecord, juce::int64 startTime, juce::int64 previousTime)
+{
+    const auto timeSinceStart { juce::String (logRecord.time - startTime).paddedLeft ('0', 10) };
+    const auto timeSincePreviousLog { juce::String (logRecord.time - previousTime).paddedLeft ('0', 4) };
+    return "[" + timeSinceStart + "]+" + timeSincePreviousLog + " [t:" + logRecord.threadName + "]" + " (" + logRecord.moduleName + ") -> " + logRecord.logLine;
+}
+
+// ThreadedLogger - log records are put in a fixed size ring by the logging threads, and formatted and written out by the logger thread. the ring is a
+// lock-free bounded multi producer/single consumer queue (each slot has a sequence number, which tells a producer the slot is free, and the consumer
+// that it is filled), so logging from any thread never waits on a lock. if the ring is full, the record is dropped, and the count of dropped records
+// is logged instead
 class ThreadedLogger : private juce::Thread
 {
 public:
-    ThreadedLogger () : juce::Thread ("ThreadedLogger") { startThread (); }
-    ~ThreadedLogger () { flush ();  stopThread (5000); }
+    ThreadedLogger (juce::int64 theStartTime) : juce::Thread ("ThreadedLogger"), startTime { theStartTime }, previousTime { theStartTime }
+    {
+        for (size_t slotIndex { 0 }; slotIndex < kNumSlots; ++slotIndex)
+            slots [slotIndex].sequence.store (slotIndex, std::memory_order_relaxed);
+        startThread ();
+    }
+
+    ~ThreadedLogger ()
+    {
+        stopThread (5000);
+        // the logger thread has stopped, so this thread is now the only consumer
+        writePendingRecords ();
+    }
 
-    void logMsg (juce::String msg)
+    void logMsg (LogRecord&& logRecord)
     {
-        juce::ScopedLock sl (debugMsgContainerLock);
-        activeLogContainer->add (msg);
+        auto position { enqueuePosition.load (std::memory_order_relaxed) };
+        for (;;)
+        {
+            auto& slot { slots [position & kSlotMask] };
+            const auto sequence { slot.sequence.load (std::memory_order_acquire) };
+            const auto sequenceDifference { static_cast<std::ptrdiff_t> (sequence - position) };
+            if (sequenceDifference == 0)
+            {
+                // the slot is free, claim it
+                if (enqueuePosition.compare_exchange_weak (position, position + 1, std::memory_order_relaxed))
+                {
+                    slot.logRecord = std::move (logRecord);
+                    slot.sequence.store (position + 1, std::memory_order_release);
+                    return;
+                }
+            }
+            else if (sequenceDifference < 0)
+            {
+                // the ring is full
+                droppedRecords.fetch_add (1, std::memory_order_relaxed);
+                return;
+            }
+            else
+            {
+                // another thread claimed the slot first
+                position = enqueuePosition.load (std::memory_order_relaxed);
+            }
+        }
     }
 
+    // waits for the logger thread to write out everything logged so far. only the calling thread waits, logging continues
     void flush ()
     {
-        // this will block all calls to logMsg while it writes out the current active log container
-        juce::ScopedLock sl (debugMsgContainerLock);
-        writeBufferToLog (activeLogContainer);
+        if (! isThreadRunning () || getCurrentThreadId () == getThreadId ())
+            return;
+        const auto flushPosition { enqueuePosition.load (std::memory_order_acquire) };
+        for (auto attempt { 0 }; attempt < 100 && dequeuePosition.load (std::memory_order_acquire) < flushPosition; ++attempt)
+        {
+            notify ();
+            recordsWritten.wait (10);
+        }
     }
 
 private:
-    juce::CriticalSection debugMsgContainerLock;
-    std::array<juce::StringArray, 2> logContainer;
-    juce::StringArray* activeLogContainer { &logContainer[0] };
+    struct Slot
+    {
+        std::atomic<size_t> sequence { 0 };
+        LogRecord logRecord;
+    };
+    static constexpr size_t kNumSlots { 4096 }; // must be a power of 2
+    static constexpr size_t kSlotMask { kNumSlots - 1 };
     inline static const int sleepTime { 100 };
 
-    void writeBufferToLog (juce::StringArray* logContainerToWrite)
+    std::array<Slot, kNumSlots> slots;
+    std::atomic<size_t> enqueuePosition { 0 };
+    std::atomic<size_t> dequeuePosition { 0 };
+    std::atomic<int> droppedRecords { 0 };
+    juce::WaitableEvent recordsWritten;
+    const juce::int64 startTime;
+    juce::int64 previousTime;
+
+    bool readRecord (LogRecord& logRecord)
     {
-        for (const auto& msg : *logContainerToWrite)
-            juce::Logger::writeToLog (msg);
-        logContainerToWrite->clear ();
+        const auto position { dequeuePosition.load (std::memory_order_relaxed) };
+        auto& slot { slots [position & kSlotMask] };
+        if (slot.sequence.load (std::memory_order_acquire) != position + 1)
+            return false;
+        logRecord = std::move (slot.logRecord);
+        // release anything left in the slot here, so a producer never frees memory when it fills the slot
+        slot.logRecord = {};
+        // hand the slot back to the producers, one lap ahead
+        slot.sequence.store (position + kNumSlots, std::memory_order_release);
+        dequeuePosition.store (position + 1, std::memory_order_release);
+        return true;
+    }
+
+    void writePendingRecords ()
+    {
+        LogRecord logRecord;
+        while (readRecord (logRecord))
+        {
+            juce::Logger::writeToLog (formatLogRecord (logRecord, startTime, previousTime));
+            previousTime = logRecord.time;
+        }
+        if (const auto numDroppedRecords { droppedRecords.exchange (0, std::memory_order_relaxed) }; numDroppedRecords > 0)
+            juce::Logger::writeToLog ("ThreadedLogger: " + juce::String (numDroppedRecords) + " log messages were dropped, the log buffer was full");
+        recordsWritten.signal ();
     }
 
     void run () override
     {
         while (! threadShouldExit ())
         {
-            sleep (sleepTime);
-            // take a reference to the active log container, so we can write it out
-            juce::StringArray* logContainerToWrite { activeLogContainer == &logContainer[0] ? &logContainer[0] : &logContainer[1] };
-            {
-                // swap active containers
-                juce::ScopedLock sl (debugMsgContainerLock);
-                activeLogContainer = (activeLogContainer == &logContainer [0] ? &logContainer [1] : &logContainer [0]);
-            }
-            writeBufferToLog (logContainerToWrite);
+            wait (sleepTime);
+            writePendingRecords ();
         }
     }
-};
\ No newline at end of file
+};
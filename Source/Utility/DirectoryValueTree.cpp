@@ -1,5 +1,7 @@
 #include "DirectoryValueTree.h"
 #include "../Utility/DebugLog.h"
+#include "../Utility/Metrics.h"
+#include "../Utility/Trace.h"
 
 #define LOG_DIRECTORY_VALUE_TREE 0
 #if LOG_DIRECTORY_VALUE_TREE
@@ -11,6 +13,12 @@
 #define SHOW_CHECK_STATE_LOG false
 #define SHOW_TASK_MANAGEMENT_LOG false
 
+static auto& scanCount { Metrics::getCounter ("scan.count") };
+static auto& scanTime { Metrics::getHistogram ("scan.time", "us") };
+static auto& scanEntries { Metrics::getCounter ("scan.entries") };
+static auto& scanFilesProbed { Metrics::getCounter ("scan.filesProbed") };
+static auto& scanProbeTime { Metrics::getHistogram ("scan.probeTime", "us") };
+
 DirectoryValueTree::DirectoryValueTree () : Thread ("DirectoryValueTree")
 {
     startThread ();
@@ -125,6 +133,9 @@ juce::ValueTree DirectoryValueTree::makeFileEntry (juce::File file, juce::int64
             //        i.e. all client specific types should also have the data filled in by the client
             case DirectoryDataProperties::TypeIndex::audioFile:
             {
+                TRACE_SPAN ("DirectoryValueTree::probeAudioFile");
+                Metrics::ScopedLatency probeLatency (scanProbeTime);
+                scanFilesProbed.add ();
                 if (std::unique_ptr<juce::AudioFormatReader> reader (audioFormatManager.createReaderFor (file)); reader == nullptr)
                 {
                     fileVT.setProperty ("error", "invalid format", nullptr);
@@ -307,13 +318,15 @@ juce::String DirectoryValueTree::getPathFromCurrentRoot (juce::String fullPath)
 
 void DirectoryValueTree::scanDirectory ()
 {
+    TRACE_SPAN ("DirectoryValueTree::scanDirectory");
+    Metrics::ScopedLatency scanLatency (scanTime);
+    scanCount.add ();
     LogDirectoryValueTree (true, "scanDirectory ()");
     lastScanInProgressUpdate = juce::Time::currentTimeMillis ();
     FolderProperties rootFolderProperties (directoryDataProperties.getRootFolderVT (), FolderProperties::WrapperType::client, FolderProperties::EnableCallbacks::no);
     // do one initial progress update to fill in the first one
     doProgressUpdate ("Reading File System: " + getPathFromCurrentRoot (juce::File (rootFolderProperties.getName ()).getFileName ()));
     // clear old contents
-    timer.start (100000);
     directoryDataProperties.getRootFolderVT ().removeAllChildren (nullptr);
     scanType = ScanType::fullScan;
     getContentsOfFolder (directoryDataProperties.getRootFolderVT (), 0, [this] () { return shouldCancelOperation (scanThread, cancelScan); });
@@ -323,7 +336,6 @@ void DirectoryValueTree::scanDirectory ()
         LogDirectoryValueTree (true, "scanDirectory - operation cancelled, removing all data");
         directoryDataProperties.getRootFolderVT ().removeAllChildren (nullptr);
     }
-    LogDirectoryValueTree (true, "DirectoryValueTree::scanDirectory ()- elapsed time: " + juce::String (timer.getElapsedTime ()));
 }
 
 void DirectoryValueTree::doProgressUpdate (juce::String progressString)
@@ -336,6 +348,7 @@ void DirectoryValueTree::doProgressUpdate (juce::String progressString)
 
 bool DirectoryValueTree::hasFolderChanged (juce::ValueTree rootFolderVT)
 {
+    TRACE_SPAN ("DirectoryValueTree::hasFolderChanged");
     FolderProperties rootFolderProperties (rootFolderVT, FolderProperties::WrapperType::owner, FolderProperties::EnableCallbacks::no);
     FolderProperties newCopyOfFolderProperties ({}, FolderProperties::WrapperType::owner, FolderProperties::EnableCallbacks::no);
     newCopyOfFolderProperties.setName (rootFolderProperties.getName (), false);
@@ -421,6 +434,8 @@ void DirectoryValueTree::getContentsOfFolder (juce::ValueTree folderVT, int curD
             if (shouldCancelFunc ())
                 break;
 
+            if (scanType == ScanType::fullScan)
+                scanEntries.add ();
             const auto creationTime { entry.getFile ().getCreationTime ().getMilliseconds () };
             const auto modificationTime { entry.getFile ().getLastModificationTime ().getMilliseconds () };
             if (scanType == ScanType::fullScan)
@@ -454,6 +469,7 @@ void DirectoryValueTree::getContentsOfFolder (juce::ValueTree folderVT, int curD
 
 void DirectoryValueTree::sortContentsOfFolder (juce::ValueTree rootFolderVT, std::function<bool ()> shouldCancelFunc)
 {
+    TRACE_SPAN ("DirectoryValueTree::sortContentsOfFolder");
     jassert (FolderProperties::isFolderVT (rootFolderVT));
 
     // Folders
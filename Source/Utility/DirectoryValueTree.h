@@ -4,7 +4,6 @@
 #include "DirectoryDataProperties.h"
 #include "../Utility/LambdaThread.h"
 #include "../Utility/ValueTreeMonitor.h"
-#include "../Utility/WatchDogTimer.h"
 
 using FileTypeIdentifierCallback = std::function<int (juce::File)>;
 
@@ -34,7 +33,6 @@ private:
         startCheck,
         checking,
     };
-    WatchdogTimer timer; // TODO - remove when not needed, ie. when done measuring things
     DirectoryDataProperties directoryDataProperties;
     juce::AudioFormatManager audioFormatManager;
     LambdaThread scanThread { "ScanThread", 1000 };
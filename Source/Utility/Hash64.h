@@ -0,0 +1,75 @@
+#pragma once
+
+#include <JuceHeader.h>
+
+// Hash64 - a fast non-cryptographic 64 bit hash (XXH64), for identifying content, not for security
+namespace Hash64
+{
+    namespace Detail
+    {
+        constexpr uint64_t kPrime1 { 0x9E3779B185EBCA87ULL };
+        constexpr uint64_t kPrime2 { 0xC2B2AE3D27D4EB4FULL };
+        constexpr uint64_t kPrime3 { 0x165667B19E3779F9ULL };
+        constexpr uint64_t kPrime4 { 0x85EBCA77C2B2AE63ULL };
+        constexpr uint64_t kPrime5 { 0x27D4EB2F165667C5ULL };
+
+        inline uint64_t rotateLeft (uint64_t value, int bits) noexcept { return (value << bits) | (value >> (64 - bits)); }
+        inline uint64_t read64 (const uint8_t* data) noexcept { uint64_t value; std::memcpy (&value, data, sizeof (value)); return juce::ByteOrder::swapIfBigEndian (value); }
+        inline uint32_t read32 (const uint8_t* data) noexcept { return juce::ByteOrder::littleEndianInt (data); }
+        inline uint64_t round (uint64_t accumulator, uint64_t input) noexcept { return rotateLeft (accumulator + input * kPrime2, 31) * kPrime1; }
+        inline uint64_t mergeRound (uint64_t accumulator, uint64_t value) noexcept { return (accumulator ^ round (0, value)) * kPrime1 + kPrime4; }
+    };
+
+    inline uint64_t hash (const void* data, size_t numBytes, uint64_t seed = 0) noexcept
+    {
+        using namespace Detail;
+        const auto* bytes { static_cast<const uint8_t*> (data) };
+        const auto* const end { bytes + numBytes };
+        uint64_t hashValue { 0 };
+
+        if (numBytes >= 32)
+        {
+            // four independent lanes of 8 bytes each
+            auto lane1 { seed + kPrime1 + kPrime2 };
+            auto lane2 { seed + kPrime2 };
+            auto lane3 { seed };
+            auto lane4 { seed - kPrime1 };
+            for (; bytes + 32 <= end; bytes += 32)
+            {
+                lane1 = round (lane1, read64 (bytes));
+                lane2 = round (lane2, read64 (bytes + 8));
+                lane3 = round (lane3, read64 (bytes + 16));
+                lane4 = round (lane4, read64 (bytes + 24));
+            }
+            hashValue = rotateLeft (lane1, 1) + rotateLeft (lane2, 7) + rotateLeft (lane3, 12) + rotateLeft (lane4, 18);
+            hashValue = mergeRound (hashValue, lane1);
+            hashValue = mergeRound (hashValue, lane2);
+            hashValue = mergeRound (hashValue, lane3);
+            hashValue = mergeRound (hashValue, lane4);
+        }
+        else
+        {
+            hashValue = seed + kPrime5;
+        }
+        hashValue += static_cast<uint64_t> (numBytes);
+
+        // remaining bytes, 8, then 4, then 1 at a time
+        for (; bytes + 8 <= end; bytes += 8)
+            hashValue = rotateLeft (hashValue ^ round (0, read64 (bytes)), 27) * kPrime1 + kPrime4;
+        if (bytes + 4 <= end)
+        {
+            hashValue = rotateLeft (hashValue ^ (static_cast<uint64_t> (read32 (bytes)) * kPrime1), 23) * kPrime2 + kPrime3;
+            bytes += 4;
+        }
+        for (; bytes < end; ++bytes)
+            hashValue = rotateLeft (hashValue ^ (*bytes * kPrime5), 11) * kPrime1;
+
+        // final mix
+        hashValue ^= hashValue >> 33;
+        hashValue *= kPrime2;
+        hashValue ^= hashValue >> 29;
+        hashValue *= kPrime3;
+        hashValue ^= hashValue >> 32;
+        return hashValue;
+    }
+};
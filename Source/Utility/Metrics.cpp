@@ -0,0 +1,170 @@
+#include "Metrics.h"
+
+namespace Metrics
+{
+    double Histogram::Snapshot::getMean () const noexcept
+    {
+        return count == 0 ? 0.0 : static_cast<double> (sum) / static_cast<double> (count);
+    }
+
+    uint64_t Histogram::Snapshot::getPercentile (double percentile) const noexcept
+    {
+        if (count == 0)
+            return 0;
+        const auto targetCount { std::max (uint64_t { 1 }, static_cast<uint64_t> (std::ceil (static_cast<double> (count) * juce::jlimit (0.0, 100.0, percentile) / 100.0))) };
+        uint64_t countSoFar { 0 };
+        for (auto bucketIndex { 0 }; bucketIndex < kNumBuckets; ++bucketIndex)
+        {
+            countSoFar += buckets [static_cast<size_t> (bucketIndex)];
+            if (countSoFar >= targetCount)
+                return std::min (getBucketUpperBound (bucketIndex), max);
+        }
+        // the buckets and the count are read separately, so they can be slightly out of step
+        return max;
+    }
+
+    int Histogram::getBucketIndex (uint64_t value) noexcept
+    {
+        if (value < kSubBuckets)
+            return static_cast<int> (value);
+        auto highestBit { 0 };
+        for (auto shiftedValue { value }; shiftedValue > 1; shiftedValue >>= 1)
+            ++highestBit;
+        const auto shift { highestBit - kSubBucketBits };
+        const auto subBucket { static_cast<int> ((value >> shift) & (kSubBuckets - 1)) };
+        return (shift + 1) * kSubBuckets + subBucket;
+    }
+
+    uint64_t Histogram::getBucketUpperBound (int bucketIndex) noexcept
+    {
+        if (bucketIndex < kSubBuckets)
+            return static_cast<uint64_t> (bucketIndex);
+        const auto shift { bucketIndex / kSubBuckets - 1 };
+        const auto subBucket { static_cast<uint64_t> (bucketIndex % kSubBuckets) };
+        const auto lowerBound { (kSubBuckets + subBucket) << shift };
+        return lowerBound + ((uint64_t { 1 } << shift) - 1);
+    }
+
+    void Histogram::record (uint64_t value) noexcept
+    {
+        buckets [static_cast<size_t> (getBucketIndex (value))].fetch_add (1, std::memory_order_relaxed);
+        count.fetch_add (1, std::memory_order_relaxed);
+        sum.fetch_add (value, std::memory_order_relaxed);
+        auto curMax { max.load (std::memory_order_relaxed) };
+        while (value > curMax && ! max.compare_exchange_weak (curMax, value, std::memory_order_relaxed))
+            ;
+    }
+
+    Histogram::Snapshot Histogram::getSnapshot () const noexcept
+    {
+        Snapshot snapshot;
+        for (size_t bucketIndex { 0 }; bucketIndex < buckets.size (); ++bucketIndex)
+            snapshot.buckets [bucketIndex] = buckets [bucketIndex].load (std::memory_order_relaxed);
+        snapshot.count = count.load (std::memory_order_relaxed);
+        snapshot.sum = sum.load (std::memory_order_relaxed);
+        snapshot.max = max.load (std::memory_order_relaxed);
+        return snapshot;
+    }
+
+    uint64_t getElapsedMicroseconds (juce::int64 startTicks) noexcept
+    {
+        const auto elapsedTicks { juce::Time::getHighResolutionTicks () - startTicks };
+        return static_cast<uint64_t> (std::max (0.0, juce::Time::highResolutionTicksToSeconds (elapsedTicks) * 1000000.0));
+    }
+
+    // the metrics are never removed, so the references handed out stay valid for the life of the app
+    struct Registry
+    {
+        juce::CriticalSection registryLock;
+        std::map<juce::String, std::unique_ptr<Counter>> counters;
+        std::map<juce::String, std::unique_ptr<Histogram>> histograms;
+    };
+
+    static Registry& getRegistry ()
+    {
+        static Registry registry;
+        return registry;
+    }
+
+    Counter& getCounter (juce::String name)
+    {
+        auto& registry { getRegistry () };
+        juce::ScopedLock sl (registry.registryLock);
+        auto& counter { registry.counters [name] };
+        if (counter == nullptr)
+            counter = std::make_unique<Counter> ();
+        return *counter;
+    }
+
+    Histogram& getHistogram (juce::String name, juce::String unit)
+    {
+        auto& registry { getRegistry () };
+        juce::ScopedLock sl (registry.registryLock);
+        auto& histogram { registry.histograms [name] };
+        if (histogram == nullptr)
+            histogram = std::make_unique<Histogram> (unit);
+        jassert (histogram->getUnit () == unit);
+        return *histogram;
+    }
+
+    void forEachCounter (std::function<void (const juce::String& name, const Counter& counter)> counterCallback)
+    {
+        jassert (counterCallback != nullptr);
+        auto& registry { getRegistry () };
+        juce::ScopedLock sl (registry.registryLock);
+        for (const auto& [name, counter] : registry.counters)
+            counterCallback (name, *counter);
+    }
+
+    void forEachHistogram (std::function<void (const juce::String& name, const Histogram& histogram)> histogramCallback)
+    {
+        jassert (histogramCallback != nullptr);
+        auto& registry { getRegistry () };
+        juce::ScopedLock sl (registry.registryLock);
+        for (const auto& [name, histogram] : registry.histograms)
+            histogramCallback (name, *histogram);
+    }
+
+    juce::var toJson ()
+    {
+        auto* countersObject { new juce::DynamicObject };
+        forEachCounter ([countersObject] (const juce::String& name, const Counter& counter)
+        {
+            countersObject->setProperty (name, static_cast<juce::int64> (counter.get ()));
+        });
+
+        auto* histogramsObject { new juce::DynamicObject };
+        forEachHistogram ([histogramsObject] (const juce::String& name, const Histogram& histogram)
+        {
+            const auto snapshot { histogram.getSnapshot () };
+            auto* histogramObject { new juce::DynamicObject };
+            histogramObject->setProperty ("unit", histogram.getUnit ());
+            histogramObject->setProperty ("count", static_cast<juce::int64> (snapshot.count));
+            histogramObject->setProperty ("mean", snapshot.getMean ());
+            histogramObject->setProperty ("p50", static_cast<juce::int64> (snapshot.getPercentile (50.0)));
+            histogramObject->setProperty ("p90", static_cast<juce::int64> (snapshot.getPercentile (90.0)));
+            histogramObject->setProperty ("p99", static_cast<juce::int64> (snapshot.getPercentile (99.0)));
+            histogramObject->setProperty ("max", static_cast<juce::int64> (snapshot.max));
+            // only the buckets in use, as [upper bound, count] pairs
+            juce::Array<juce::var> bucketList;
+            for (auto bucketIndex { 0 }; bucketIndex < Histogram::kNumBuckets; ++bucketIndex)
+                if (const auto bucketCount { snapshot.buckets [static_cast<size_t> (bucketIndex)] }; bucketCount > 0)
+                    bucketList.add (juce::Array<juce::var> { static_cast<juce::int64> (Histogram::getBucketUpperBound (bucketIndex)), static_cast<juce::int64> (bucketCount) });
+            histogramObject->setProperty ("buckets", bucketList);
+            histogramsObject->setProperty (name, histogramObject);
+        });
+
+        auto* metricsObject { new juce::DynamicObject };
+        metricsObject->setProperty ("time", juce::Time::getCurrentTime ().toISO8601 (true));
+        metricsObject->setProperty ("counters", countersObject);
+        metricsObject->setProperty ("histograms", histogramsObject);
+        return metricsObject;
+    }
+
+    juce::Result writeJson (juce::File jsonFile)
+    {
+        if (! jsonFile.replaceWithText (juce::JSON::toString (toJson ())))
+            return juce::Result::fail ("Unable to write '" + jsonFile.getFullPathName () + "'");
+        return juce::Result::ok ();
+    }
+};
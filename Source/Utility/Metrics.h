@@ -0,0 +1,87 @@
+#pragma once
+
+#include <JuceHeader.h>
+
+// Metrics - named counters and latency histograms, cheap enough to leave on in release builds. recording is a relaxed atomic add, so it never waits
+// and is safe on the audio thread. the metrics are looked up by name once, and the reference is kept
+//
+//  static auto& bankLoadTime { Metrics::getHistogram ("bank.loadTime", "us") };
+//  ...
+//  Metrics::ScopedLatency scopedLatency (bankLoadTime);
+namespace Metrics
+{
+    class Counter
+    {
+    public:
+        void add (uint64_t amount = 1) noexcept { value.fetch_add (amount, std::memory_order_relaxed); }
+        uint64_t get () const noexcept { return value.load (std::memory_order_relaxed); }
+
+    private:
+        std::atomic<uint64_t> value { 0 };
+    };
+
+    // Histogram - HDR style buckets, each power of 2 range is split into kSubBuckets linear buckets, so a value read back from the histogram is within
+    // 1/kSubBuckets of the recorded value, for any magnitude, with a fixed amount of memory
+    class Histogram
+    {
+    public:
+        static constexpr int kSubBucketBits { 3 };
+        static constexpr int kSubBuckets { 1 << kSubBucketBits };
+        static constexpr int kNumBuckets { (64 - kSubBucketBits + 1) * kSubBuckets };
+
+        struct Snapshot
+        {
+            uint64_t count { 0 };
+            uint64_t sum { 0 };
+            uint64_t max { 0 };
+            std::array<uint64_t, kNumBuckets> buckets {};
+
+            double getMean () const noexcept;
+            // the upper bound of the bucket that holds the value at the given percentile (0-100)
+            uint64_t getPercentile (double percentile) const noexcept;
+        };
+
+        explicit Histogram (juce::String theUnit) : unit { theUnit } {}
+
+        void record (uint64_t value) noexcept;
+        Snapshot getSnapshot () const noexcept;
+        juce::String getUnit () const { return unit; }
+
+        static int getBucketIndex (uint64_t value) noexcept;
+        static uint64_t getBucketUpperBound (int bucketIndex) noexcept;
+
+    private:
+        const juce::String unit;
+        std::array<std::atomic<uint64_t>, kNumBuckets> buckets {};
+        std::atomic<uint64_t> count { 0 };
+        std::atomic<uint64_t> sum { 0 };
+        std::atomic<uint64_t> max { 0 };
+    };
+
+    // records the time from construction to destruction in microseconds
+    class ScopedLatency
+    {
+    public:
+        explicit ScopedLatency (Histogram& theHistogram) noexcept : histogram { theHistogram }, startTicks { juce::Time::getHighResolutionTicks () } {}
+        ~ScopedLatency () { histogram.record (getElapsedMicroseconds (startTicks)); }
+
+    private:
+        Histogram& histogram;
+        const juce::int64 startTicks;
+
+        JUCE_DECLARE_NON_COPYABLE (ScopedLatency)
+    };
+
+    uint64_t getElapsedMicroseconds (juce::int64 startTicks) noexcept;
+
+    // the first call for a name creates the metric, later calls return the same one. these take a lock, so look the metric up once and keep the reference
+    Counter& getCounter (juce::String name);
+    Histogram& getHistogram (juce::String name, juce::String unit);
+
+    // in name order
+    void forEachCounter (std::function<void (const juce::String& name, const Counter& counter)> counterCallback);
+    void forEachHistogram (std::function<void (const juce::String& name, const Histogram& histogram)> histogramCallback);
+
+    juce::var toJson ();
+    juce::Result writeJson (juce::File jsonFile);
+};
@@ -0,0 +1,51 @@
+#pragma once
+
+#include <JuceHeader.h>
+
+#if defined (__SSE2__) || defined (_M_X64) || (defined (_M_IX86_FP) && _M_IX86_FP >= 2)
+ #include <emmintrin.h>
+ #define SAMPLE_CONVERSION_USE_SSE2 1
+#elif defined (__ARM_NEON) && defined (__aarch64__)
+ #include <arm_neon.h>
+ #define SAMPLE_CONVERSION_USE_NEON 1
+#endif
+
+namespace SampleConversion
+{
+    // float samples (-1.0 to 1.0) to little endian 16 bit PCM, scaled, rounded and clipped the same way as juce::AudioData
+    inline void floatToInt16 (const float* source, int16_t* dest, int numSamples) noexcept
+    {
+        constexpr float kScale { 32768.0f };
+        auto sampleIndex { 0 };
+#if SAMPLE_CONVERSION_USE_SSE2
+        // clamp before the convert, which returns INT_MIN for anything out of the int32 range. the convert rounds to nearest
+        const auto scale { _mm_set1_ps (kScale) };
+        const auto minimum { _mm_set1_ps (-32768.0f) };
+        const auto maximum { _mm_set1_ps (32767.0f) };
+        const auto convert = [scale, minimum, maximum] (const float* fourSamples)
+        {
+            return _mm_cvtps_epi32 (_mm_min_ps (_mm_max_ps (_mm_mul_ps (_mm_loadu_ps (fourSamples), scale), minimum), maximum));
+        };
+        for (; sampleIndex + 8 <= numSamples; sampleIndex += 8)
+        {
+            const auto low { convert (source + sampleIndex) };
+            const auto high { convert (source + sampleIndex + 4) };
+            _mm_storeu_si128 (reinterpret_cast<__m128i*> (dest + sampleIndex), _mm_packs_epi32 (low, high));
+        }
+#elif SAMPLE_CONVERSION_USE_NEON
+        // the convert rounds to nearest and saturates, and the narrow saturates to the int16 range
+        const auto scale { vdupq_n_f32 (kScale) };
+        for (; sampleIndex + 8 <= numSamples; sampleIndex += 8)
+        {
+            const auto low { vqmovn_s32 (vcvtnq_s32_f32 (vmulq_f32 (vld1q_f32 (source + sampleIndex), scale))) };
+            const auto high { vqmovn_s32 (vcvtnq_s32_f32 (vmulq_f32 (vld1q_f32 (source + sampleIndex + 4), scale))) };
+            vst1q_s16 (dest + sampleIndex, vcombine_s16 (low, high));
+        }
+#endif
+        for (; sampleIndex < numSamples; ++sampleIndex)
+        {
+            const auto sample { static_cast<int16_t> (juce::roundToInt (juce::jlimit (-32768.0f, 32767.0f, source [sampleIndex] * kScale))) };
+            dest [sampleIndex] = static_cast<int16_t> (juce::ByteOrder::swapIfBigEndian (static_cast<uint16_t> (sample)));
+        }
+    }
+};
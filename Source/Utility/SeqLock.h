@@ -0,0 +1,57 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstring>
+#include <type_traits>
+
+// SeqLock - publishes a small trivially copyable struct from a single writer thread to any number of reader threads without locking.
+// the writer never waits, and a reader only retries if it overlapped with a write, which makes it safe to call load () from the audio thread
+// NOTE: store () must only ever be called from one thread
+template <typename T>
+class SeqLock
+{
+public:
+    static_assert (std::is_trivially_copyable_v<T>, "SeqLock requires a trivially copyable type");
+    static_assert (std::is_default_constructible_v<T>, "SeqLock requires a default constructible type");
+
+    SeqLock () { store (T {}); }
+    explicit SeqLock (const T& initialValue) { store (initialValue); }
+
+    void store (const T& newValue) noexcept
+    {
+        std::array<uint64_t, kNumWords> words {};
+        std::memcpy (words.data (), &newValue, sizeof (T));
+
+        const auto curSequence { sequence.load (std::memory_order_relaxed) };
+        sequence.store (curSequence + 1, std::memory_order_relaxed); // odd while the write is in progress
+        std::atomic_thread_fence (std::memory_order_release);
+        for (size_t wordIndex { 0 }; wordIndex < kNumWords; ++wordIndex)
+            data [wordIndex].store (words [wordIndex], std::memory_order_relaxed);
+        sequence.store (curSequence + 2, std::memory_order_release);
+    }
+
+    T load () const noexcept
+    {
+        std::array<uint64_t, kNumWords> words {};
+        uint32_t sequenceBefore { 0 };
+        uint32_t sequenceAfter { 0 };
+        do
+        {
+            sequenceBefore = sequence.load (std::memory_order_acquire);
+            for (size_t wordIndex { 0 }; wordIndex < kNumWords; ++wordIndex)
+                words [wordIndex] = data [wordIndex].load (std::memory_order_relaxed);
+            std::atomic_thread_fence (std::memory_order_acquire);
+            sequenceAfter = sequence.load (std::memory_order_relaxed);
+        } while ((sequenceBefore & 1) != 0 || sequenceBefore != sequenceAfter);
+
+        T value;
+        std::memcpy (&value, words.data (), sizeof (T));
+        return value;
+    }
+
+private:
+    static constexpr size_t kNumWords { (sizeof (T) + sizeof (uint64_t) - 1) / sizeof (uint64_t) };
+    std::atomic<uint32_t> sequence { 0 };
+    std::array<std::atomic<uint64_t>, kNumWords> data {};
+};
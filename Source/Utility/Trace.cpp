@@ -0,0 +1,149 @@
+#include "Trace.h"
+
+namespace Trace
+{
+    // each slot has a sequence number, which is odd while a span is being written into it, and (ring position + 1) * 2 once it is complete. the
+    // reader copies a slot and then checks that the sequence number has not changed, so neither side ever waits for the other
+    struct Slot
+    {
+        std::atomic<uint64_t> sequence { 0 };
+        std::atomic<const char*> name { nullptr };
+        std::atomic<juce::int64> startTicks { 0 };
+        std::atomic<juce::int64> endTicks { 0 };
+        std::atomic<int> threadIndex { 0 };
+    };
+    static constexpr uint64_t kNumSlots { 32768 }; // must be a power of 2
+    static constexpr uint64_t kSlotMask { kNumSlots - 1 };
+    static std::array<Slot, kNumSlots> slots;
+    static std::atomic<uint64_t> nextPosition { 0 };
+    static std::atomic<uint64_t> clearPosition { 0 };
+
+    // threads are numbered in the order they record their first span, and their names are kept for the thread names in the trace file
+    struct ThreadInfo
+    {
+        std::atomic<bool> isNamed { false };
+        std::array<char, 64> name {};
+    };
+    static constexpr int kMaxThreads { 64 };
+    static std::array<ThreadInfo, kMaxThreads> threads;
+    static std::atomic<int> numThreads { 0 };
+
+    static const auto traceStartTicks { juce::Time::getHighResolutionTicks () };
+
+    static int registerCurrentThread () noexcept
+    {
+        const auto threadIndex { numThreads.fetch_add (1, std::memory_order_relaxed) };
+        if (threadIndex >= kMaxThreads)
+            return threadIndex;
+
+        // this runs on the first span of each thread, which can be on the audio thread, so the name is copied straight out of the existing string,
+        // without making a juce::String. threads that are not juce::Thread's (the audio device callback, for instance) are left unnamed
+        auto& threadInfo { threads [static_cast<size_t> (threadIndex)] };
+        juce::CharPointer_UTF8 threadName { "" };
+        if (juce::MessageManager::existsAndIsCurrentThread ())
+            threadName = juce::CharPointer_UTF8 { "MessageManager" };
+        else if (const auto* curThread { juce::Thread::getCurrentThread () }; curThread != nullptr)
+            threadName = curThread->getThreadName ().getCharPointer ();
+        juce::CharPointer_UTF8 (threadInfo.name.data ()).writeWithDestByteLimit (threadName, threadInfo.name.size ());
+        threadInfo.isNamed.store (true, std::memory_order_release);
+        return threadIndex;
+    }
+
+    static int getCurrentThreadIndex () noexcept
+    {
+        thread_local const auto currentThreadIndex { registerCurrentThread () };
+        return currentThreadIndex;
+    }
+
+    void recordSpan (const char* name, juce::int64 startTicks, juce::int64 endTicks) noexcept
+    {
+        const auto threadIndex { getCurrentThreadIndex () };
+        const auto position { nextPosition.fetch_add (1, std::memory_order_relaxed) };
+        auto& slot { slots [position & kSlotMask] };
+        slot.sequence.store (position * 2 + 1, std::memory_order_relaxed);
+        std::atomic_thread_fence (std::memory_order_release);
+        slot.name.store (name, std::memory_order_relaxed);
+        slot.startTicks.store (startTicks, std::memory_order_relaxed);
+        slot.endTicks.store (endTicks, std::memory_order_relaxed);
+        slot.threadIndex.store (threadIndex, std::memory_order_relaxed);
+        slot.sequence.store ((position + 1) * 2, std::memory_order_release);
+    }
+
+    void clear () noexcept
+    {
+        // the slots are left as they are, anything before the clear position is just not written out
+        clearPosition.store (nextPosition.load (std::memory_order_relaxed), std::memory_order_relaxed);
+    }
+
+    juce::Result writeChromeTrace (juce::File traceFile)
+    {
+        struct Span
+        {
+            const char* name { nullptr };
+            juce::int64 startTicks { 0 };
+            juce::int64 endTicks { 0 };
+            int threadIndex { 0 };
+        };
+        std::vector<Span> spans;
+        const auto endPosition { nextPosition.load (std::memory_order_acquire) };
+        const auto startPosition { std::max (clearPosition.load (std::memory_order_relaxed), endPosition > kNumSlots ? endPosition - kNumSlots : 0) };
+        spans.reserve (static_cast<size_t> (endPosition - startPosition));
+        for (auto position { startPosition }; position < endPosition; ++position)
+        {
+            const auto& slot { slots [position & kSlotMask] };
+            const auto sequence { slot.sequence.load (std::memory_order_acquire) };
+            // skip spans that are still being written, or have already been overwritten
+            if (sequence != (position + 1) * 2)
+                continue;
+            const Span span { slot.name.load (std::memory_order_relaxed), slot.startTicks.load (std::memory_order_relaxed),
+                              slot.endTicks.load (std::memory_order_relaxed), slot.threadIndex.load (std::memory_order_relaxed) };
+            std::atomic_thread_fence (std::memory_order_acquire);
+            if (slot.sequence.load (std::memory_order_relaxed) != sequence)
+                continue;
+            spans.push_back (span);
+        }
+
+        traceFile.deleteFile ();
+        juce::FileOutputStream traceStream (traceFile);
+        if (! traceStream.openedOk ())
+            return traceStream.getStatus ();
+
+        auto ticksToMicroseconds = [] (juce::int64 ticks)
+        {
+            return juce::String (juce::Time::highResolutionTicksToSeconds (ticks) * 1000000.0, 3);
+        };
+        auto toJsonString = [] (const juce::String& text)
+        {
+            return juce::JSON::toString (juce::var (text));
+        };
+
+        traceStream << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n";
+        auto isFirstEvent { true };
+        auto writeEvent = [&traceStream, &isFirstEvent] (const juce::String& eventJson)
+        {
+            if (! isFirstEvent)
+                traceStream << ",\n";
+            traceStream << eventJson;
+            isFirstEvent = false;
+        };
+        const auto numNamedThreads { std::min (numThreads.load (std::memory_order_relaxed), kMaxThreads) };
+        for (auto threadIndex { 0 }; threadIndex < numNamedThreads; ++threadIndex)
+        {
+            const auto& threadInfo { threads [static_cast<size_t> (threadIndex)] };
+            if (! threadInfo.isNamed.load (std::memory_order_acquire))
+                continue;
+            auto threadName { juce::String::fromUTF8 (threadInfo.name.data ()) };
+            if (threadName.isEmpty ())
+                threadName = "Thread " + juce::String (threadIndex);
+            writeEvent ("{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":" + juce::String (threadIndex) + ",\"args\":{\"name\":" + toJsonString (threadName) + "}}");
+        }
+        for (const auto& span : spans)
+        {
+            writeEvent ("{\"name\":" + toJsonString (span.name) + ",\"cat\":\"SquidManager\",\"ph\":\"X\",\"ts\":" + ticksToMicroseconds (span.startTicks - traceStartTicks) +
+                        ",\"dur\":" + ticksToMicroseconds (span.endTicks - span.startTicks) + ",\"pid\":1,\"tid\":" + juce::String (span.threadIndex) + "}");
+        }
+        traceStream << "\n]}\n";
+        traceStream.flush ();
+        return traceStream.getStatus ();
+    }
+};
@@ -0,0 +1,44 @@
+#pragma once
+
+#include <JuceHeader.h>
+
+// tracing is on in debug builds, define ENABLE_TRACING as 1 or 0 to turn it on or off in any build
+#if ! defined (ENABLE_TRACING)
+#define ENABLE_TRACING JUCE_DEBUG
+#endif
+
+// Trace - scoped timing spans, recorded into a fixed size ring, which can be written out as a chrome://tracing (or Perfetto) JSON file
+//
+//  void EditManager::loadBank (juce::File bankDirectoryToLoad)
+//  {
+//      TRACE_SPAN ("EditManager::loadBank");
+//      ...
+//
+// recording a span never waits and never allocates, so spans can be used on the audio thread. when the ring is full the oldest spans are overwritten
+namespace Trace
+{
+    // the name is not copied, it must be a string literal (or otherwise live as long as the app)
+    void recordSpan (const char* name, juce::int64 startTicks, juce::int64 endTicks) noexcept;
+    // writes the spans currently in the ring
+    juce::Result writeChromeTrace (juce::File traceFile);
+    void clear () noexcept;
+
+    class ScopedSpan
+    {
+    public:
+        explicit ScopedSpan (const char* theName) noexcept : name { theName }, startTicks { juce::Time::getHighResolutionTicks () } {}
+        ~ScopedSpan () { recordSpan (name, startTicks, juce::Time::getHighResolutionTicks ()); }
+
+    private:
+        const char* name;
+        const juce::int64 startTicks;
+
+        JUCE_DECLARE_NON_COPYABLE (ScopedSpan)
+    };
+};
+
+#if ENABLE_TRACING
+#define TRACE_SPAN(name) Trace::ScopedSpan JUCE_JOIN_MACRO (traceSpan, __LINE__) (name);
+#else
+#define TRACE_SPAN(name) ;
+#endif
@@ -1,4 +1,5 @@
 #include "ValueTreeFile.h"
+#include "Crc.h"
 
 ValueTreeFile::ValueTreeFile () noexcept
     : Thread ("ValueTreeFile")
@@ -17,7 +18,20 @@ ValueTreeFile::~ValueTreeFile ()
     signalThreadShouldExit ();
     signalSave.signal ();
     stopThread (5000);
+    stopTimer ();
     vtData.removeListener (this);
+    // write out any changes that have not been saved yet, including the ones that are waiting on a snapshot
+    {
+        juce::ScopedLock pendingDataLock (pendingDataCS);
+        if (snapshotChangesPending)
+        {
+            pendingSnapshot = vtData.createCopy ();
+            pendingChanges.reset ();
+            snapshotRequired = false;
+            snapshotChangesPending = false;
+        }
+    }
+    writePendingData ();
 }
 
 void ValueTreeFile::init (juce::ValueTree vt, juce::File f, bool enableAutoSave)
@@ -25,6 +39,7 @@ void ValueTreeFile::init (juce::ValueTree vt, juce::File f, bool enableAutoSave)
     startThread ();
     vtData = vt;
     file = f;
+    changeLogFile = file.getSiblingFile (file.getFileName () + ".log");
     autoSaveEnabled = enableAutoSave;
     vtData.addListener (this);
     load ();
@@ -42,32 +57,321 @@ void ValueTreeFile::enableAutoSave (bool isEnabled) noexcept
 
 void ValueTreeFile::save ()
 {
-    auto xmlToWrite { vtData.createXml () };
-    save (xmlToWrite.get ());
+    // a full save, writing a new snapshot, and starting a new change log
+    {
+        juce::ScopedLock fileLock (fileCS);
+        juce::ScopedLock pendingDataLock (pendingDataCS);
+        pendingSnapshot = vtData.createCopy ();
+        pendingChanges.reset ();
+        snapshotRequired = false;
+        snapshotChangesPending = false;
+    }
+    writePendingData ();
+}
+
+void ValueTreeFile::load ()
+{
+    if (file.exists ())
+    {
+        loading.store (true);
+        if (loadSnapshot ())
+        {
+            replayChangeLog ();
+        }
+        else
+        {
+            // old XML format
+            juce::XmlDocument xmlDoc (file);
+            auto xmlToRead { xmlDoc.getDocumentElement () };
+            if (xmlToRead == nullptr)
+            {
+                juce::Logger::writeToLog ("File \"" + file.getFullPathName () + "\" is corrupted and cannot be read!");
+                jassertfalse;
+                loading.store (false);
+                return;
+            }
+            vtData.copyPropertiesAndChildrenFrom (juce::ValueTree::fromXml (*xmlToRead), nullptr);
+            juce::ScopedLock pendingDataLock (pendingDataCS);
+            snapshotRequired = true;
+        }
+        loading.store (false);
+    }
 }
 
-void ValueTreeFile::save (juce::XmlElement* xmlToWrite)
+bool ValueTreeFile::loadSnapshot ()
 {
-    xmlToWrite->writeTo (file, {});
+    juce::FileInputStream snapshotStream (file);
+    char magic [4];
+    if (! snapshotStream.openedOk () || snapshotStream.read (magic, 4) != 4 || std::memcmp (magic, kSnapshotMagic, 4) != 0)
+        return false;
+
+    const auto snapshotGeneration { static_cast<uint32_t> (snapshotStream.readInt ()) };
+    auto snapshot { juce::ValueTree::readFromStream (snapshotStream) };
+    if (! snapshot.isValid ())
+        return false;
+
+    vtData.copyPropertiesAndChildrenFrom (snapshot, nullptr);
+    juce::ScopedLock fileLock (fileCS);
+    generation = snapshotGeneration;
+    snapshotSize = file.getSize ();
+    juce::ScopedLock pendingDataLock (pendingDataCS);
+    snapshotRequired = false;
+    return true;
 }
 
-void ValueTreeFile::load ()
+void ValueTreeFile::replayChangeLog ()
 {
-    if (file.exists ())
+    juce::ScopedLock fileLock (fileCS);
+    // the log is replayed up to the first incomplete or damaged record (ie. the app exited while writing it), and anything after that is discarded
+    int64_t validLogLength { 0 };
+    if (auto changeLogInputStream { changeLogFile.createInputStream () }; changeLogInputStream != nullptr && changeLogInputStream->openedOk ())
+    {
+        char magic [4];
+        if (changeLogInputStream->read (magic, 4) == 4 && std::memcmp (magic, kChangeLogMagic, 4) == 0 &&
+            static_cast<uint32_t> (changeLogInputStream->readInt ()) == generation)
+        {
+            validLogLength = changeLogInputStream->getPosition ();
+            juce::MemoryBlock changeData;
+            while (changeLogInputStream->getNumBytesRemaining () >= 8)
+            {
+                const auto changeSize { changeLogInputStream->readInt () };
+                const auto changeCrc { static_cast<uint32_t> (changeLogInputStream->readInt ()) };
+                if (changeSize <= 0 || changeSize > changeLogInputStream->getNumBytesRemaining ())
+                    break;
+                changeData.setSize (static_cast<size_t> (changeSize));
+                if (changeLogInputStream->read (changeData.getData (), changeSize) != changeSize)
+                    break;
+                Crc32 crc;
+                if (crc.updateBuffer (static_cast<const uint8_t*> (changeData.getData ()), changeSize) != changeCrc)
+                    break;
+                juce::MemoryInputStream changeInputStream (changeData, false);
+                if (! replayChange (changeInputStream))
+                {
+                    jassertfalse;
+                    break;
+                }
+                validLogLength = changeLogInputStream->getPosition ();
+            }
+        }
+    }
+
+    // continue appending to the log, or start a new one
+    changeLogStream = std::make_unique<juce::FileOutputStream> (changeLogFile);
+    if (changeLogStream->openedOk ())
+    {
+        changeLogStream->setPosition (validLogLength);
+        changeLogStream->truncate ();
+        if (validLogLength == 0)
+        {
+            changeLogStream->write (kChangeLogMagic, 4);
+            changeLogStream->writeInt (static_cast<int> (generation));
+            changeLogStream->flush ();
+        }
+    }
+    if (! changeLogStream->openedOk () || changeLogStream->getStatus ().failed ())
+    {
+        changeLogStream.reset ();
+        juce::ScopedLock pendingDataLock (pendingDataCS);
+        snapshotRequired = true;
+        return;
+    }
+    changeLogSize = changeLogStream->getPosition ();
+}
+
+bool ValueTreeFile::replayChange (juce::InputStream& changeInputStream)
+{
+    const auto changeType { static_cast<ChangeType> (changeInputStream.readByte ()) };
+    const auto pathLength { changeInputStream.readCompressedInt () };
+    if (pathLength < 0)
+        return false;
+    auto tree { vtData };
+    for (auto pathIndex { 0 }; pathIndex < pathLength; ++pathIndex)
+    {
+        const auto childIndex { changeInputStream.readCompressedInt () };
+        if (childIndex < 0 || childIndex >= tree.getNumChildren ())
+            return false;
+        tree = tree.getChild (childIndex);
+    }
+
+    switch (changeType)
+    {
+        case ChangeType::propertySet:
+        {
+            const auto propertyName { changeInputStream.readString () };
+            if (propertyName.isEmpty ())
+                return false;
+            tree.setProperty (propertyName, juce::var::readFromStream (changeInputStream), nullptr);
+            return true;
+        }
+        case ChangeType::propertyRemoved:
+        {
+            const auto propertyName { changeInputStream.readString () };
+            if (propertyName.isEmpty ())
+                return false;
+            tree.removeProperty (propertyName, nullptr);
+            return true;
+        }
+        case ChangeType::childAdded:
+        {
+            const auto childIndex { changeInputStream.readCompressedInt () };
+            auto child { juce::ValueTree::readFromStream (changeInputStream) };
+            if (! child.isValid () || childIndex < 0 || childIndex > tree.getNumChildren ())
+                return false;
+            tree.addChild (child, childIndex, nullptr);
+            return true;
+        }
+        case ChangeType::childRemoved:
+        {
+            const auto childIndex { changeInputStream.readCompressedInt () };
+            if (childIndex < 0 || childIndex >= tree.getNumChildren ())
+                return false;
+            tree.removeChild (childIndex, nullptr);
+            return true;
+        }
+        case ChangeType::childMoved:
+        {
+            const auto oldIndex { changeInputStream.readCompressedInt () };
+            const auto newIndex { changeInputStream.readCompressedInt () };
+            if (oldIndex < 0 || oldIndex >= tree.getNumChildren () || newIndex < 0 || newIndex >= tree.getNumChildren ())
+                return false;
+            tree.moveChild (oldIndex, newIndex, nullptr);
+            return true;
+        }
+    }
+    return false;
+}
+
+void ValueTreeFile::recordChange (juce::ValueTree& tree, ChangeType changeType, std::function<void (juce::OutputStream& outputStream)> writeChangeData)
+{
+    if (loading.load ())
+        return;
+
+    // the changed tree is identified by the child indexes leading to it from the root
+    juce::Array<int> path;
+    for (auto pathTree { tree }; pathTree != vtData;)
     {
-        juce::XmlDocument xmlDoc (file);
-        auto xmlToRead { xmlDoc.getDocumentElement () };
-        if (xmlToRead == nullptr)
+        auto parent { pathTree.getParent () };
+        if (! parent.isValid ())
         {
-            juce::Logger::writeToLog ("File \"" + file.getFullPathName () + "\" is corrupted and cannot be read!");
             jassertfalse;
+            juce::ScopedLock pendingDataLock (pendingDataCS);
+            snapshotRequired = true;
+            snapshotChangesPending = true;
             return;
         }
+        path.insert (0, parent.indexOf (pathTree));
+        pathTree = parent;
+    }
 
-        loading.store (true);
-        vtData.copyPropertiesAndChildrenFrom (juce::ValueTree::fromXml (*xmlToRead), nullptr);
-        loading.store (false);
+    juce::MemoryOutputStream changeStream;
+    changeStream.writeByte (static_cast<char> (changeType));
+    changeStream.writeCompressedInt (path.size ());
+    for (const auto childIndex : path)
+        changeStream.writeCompressedInt (childIndex);
+    writeChangeData (changeStream);
+
+    {
+        juce::ScopedLock pendingDataLock (pendingDataCS);
+        // when a snapshot is required, it will include this change
+        if (snapshotRequired)
+        {
+            snapshotChangesPending = true;
+        }
+        else
+        {
+            Crc32 crc;
+            const auto changeCrc { crc.updateBuffer (static_cast<const uint8_t*> (changeStream.getData ()), static_cast<int> (changeStream.getDataSize ())) };
+            juce::MemoryOutputStream pendingChangesStream (pendingChanges, true);
+            pendingChangesStream.writeInt (static_cast<int> (changeStream.getDataSize ()));
+            pendingChangesStream.writeInt (static_cast<int> (changeCrc));
+            pendingChangesStream.write (changeStream.getData (), changeStream.getDataSize ());
+        }
     }
+    requestAutoSave ();
+}
+
+void ValueTreeFile::writeSnapshot (juce::ValueTree snapshot)
+{
+    juce::ScopedLock fileLock (fileCS);
+    // write to a temp file, and then swap it in, so there is always a complete snapshot on disk
+    const auto newGeneration { generation + 1 };
+    juce::TemporaryFile tempFile (file);
+    auto writeSuccess { false };
+    if (auto snapshotStream { tempFile.getFile ().createOutputStream () }; snapshotStream != nullptr && snapshotStream->openedOk ())
+    {
+        snapshotStream->write (kSnapshotMagic, 4);
+        snapshotStream->writeInt (static_cast<int> (newGeneration));
+        snapshot.writeToStream (*snapshotStream);
+        snapshotStream->flush ();
+        writeSuccess = snapshotStream->getStatus ().wasOk ();
+    }
+    if (! writeSuccess || ! tempFile.overwriteTargetFileWithTemporary ())
+    {
+        juce::Logger::writeToLog ("Unable to save \"" + file.getFullPathName () + "\"");
+        jassertfalse;
+        juce::ScopedLock pendingDataLock (pendingDataCS);
+        snapshotRequired = true;
+        snapshotChangesPending = true;
+        return;
+    }
+
+    // the old log does not match the new generation, so even if the new log can't be written, the old one will never be replayed onto this snapshot
+    generation = newGeneration;
+    snapshotSize = file.getSize ();
+    changeLogStream.reset ();
+    changeLogFile.deleteFile ();
+    changeLogStream = std::make_unique<juce::FileOutputStream> (changeLogFile);
+    if (changeLogStream->openedOk ())
+    {
+        changeLogStream->write (kChangeLogMagic, 4);
+        changeLogStream->writeInt (static_cast<int> (generation));
+        changeLogStream->flush ();
+    }
+    if (! changeLogStream->openedOk () || changeLogStream->getStatus ().failed ())
+    {
+        changeLogStream.reset ();
+        juce::ScopedLock pendingDataLock (pendingDataCS);
+        snapshotRequired = true;
+        return;
+    }
+    changeLogSize = changeLogStream->getPosition ();
+}
+
+void ValueTreeFile::appendChanges (const juce::MemoryBlock& changes)
+{
+    juce::ScopedLock fileLock (fileCS);
+    if (changeLogStream != nullptr)
+    {
+        changeLogStream->write (changes.getData (), changes.getSize ());
+        changeLogStream->flush ();
+        if (changeLogStream->getStatus ().wasOk ())
+        {
+            changeLogSize = changeLogStream->getPosition ();
+            return;
+        }
+        changeLogStream.reset ();
+    }
+    juce::Logger::writeToLog ("Unable to save changes to \"" + changeLogFile.getFullPathName () + "\"");
+    juce::ScopedLock pendingDataLock (pendingDataCS);
+    snapshotRequired = true;
+    snapshotChangesPending = true;
+}
+
+void ValueTreeFile::writePendingData ()
+{
+    // NOTE: the file lock is held from taking the pending data until it is written, so the changes are always appended in the order they were made
+    juce::ScopedLock fileLock (fileCS);
+    juce::ValueTree snapshot;
+    juce::MemoryBlock changes;
+    {
+        juce::ScopedLock pendingDataLock (pendingDataCS);
+        std::swap (snapshot, pendingSnapshot);
+        changes.swapWith (pendingChanges);
+    }
+    if (snapshot.isValid ())
+        writeSnapshot (snapshot);
+    if (changes.getSize () > 0)
+        appendChanges (changes);
 }
 
 void ValueTreeFile::setAutoSaveTimes (uint32_t sdt, uint32_t msdt) noexcept
@@ -95,14 +399,20 @@ void ValueTreeFile::timerCallback ()
     if (curTime - mostRecentSaveRequestedTime >= saveDelayTime ||
         curTime - initialSaveRequestedTime >= maxSaveDelayTime)
     {
-        juce::ScopedLock xmlLock (xmlDataCS);
-        if (xml.get () == nullptr)
+        stopTimer ();
+        initialSaveRequestedTime = 0;
         {
-            stopTimer ();
-            xml = vtData.createXml ();
-            signalSave.signal ();
-            initialSaveRequestedTime = 0;
+            juce::ScopedLock pendingDataLock (pendingDataCS);
+            // compact the log once it is larger than the snapshot. copying the tree is the only part of a save done on this thread, and only when compacting
+            if (snapshotRequired || changeLogSize.load () > std::max (kMinCompactionLogSize, snapshotSize.load ()))
+            {
+                pendingSnapshot = vtData.createCopy ();
+                pendingChanges.reset ();
+                snapshotRequired = false;
+                snapshotChangesPending = false;
+            }
         }
+        signalSave.signal ();
     }
 }
 
@@ -112,36 +422,51 @@ void ValueTreeFile::run ()
     {
         signalSave.wait ();
         if (! threadShouldExit ())
-        {
-            std::unique_ptr<juce::XmlElement> xmlToWrite;
-            {
-                juce::ScopedLock xmlLock (xmlDataCS);
-                xmlToWrite.reset (xml.release ());
-            }
-            if (xmlToWrite.get () != nullptr)
-                save (xmlToWrite.get ());
-        }
+            writePendingData ();
     }
 }
 
-void ValueTreeFile::valueTreePropertyChanged (juce::ValueTree&, const juce::Identifier&)
+void ValueTreeFile::valueTreePropertyChanged (juce::ValueTree& tree, const juce::Identifier& property)
 {
-    requestAutoSave ();
+    if (tree.hasProperty (property))
+        recordChange (tree, ChangeType::propertySet, [&tree, &property] (juce::OutputStream& outputStream)
+        {
+            outputStream.writeString (property.toString ());
+            tree.getProperty (property).writeToStream (outputStream);
+        });
+    else
+        recordChange (tree, ChangeType::propertyRemoved, [&property] (juce::OutputStream& outputStream) { outputStream.writeString (property.toString ()); });
 }
-void ValueTreeFile::valueTreeChildAdded (juce::ValueTree&, juce::ValueTree&)
+void ValueTreeFile::valueTreeChildAdded (juce::ValueTree& parentTree, juce::ValueTree& child)
 {
-    requestAutoSave ();
+    recordChange (parentTree, ChangeType::childAdded, [&parentTree, &child] (juce::OutputStream& outputStream)
+    {
+        outputStream.writeCompressedInt (parentTree.indexOf (child));
+        child.writeToStream (outputStream);
+    });
 }
-void ValueTreeFile::valueTreeChildRemoved (juce::ValueTree&, juce::ValueTree& , int)
+void ValueTreeFile::valueTreeChildRemoved (juce::ValueTree& parentTree, juce::ValueTree&, int index)
 {
-    requestAutoSave ();
+    recordChange (parentTree, ChangeType::childRemoved, [index] (juce::OutputStream& outputStream) { outputStream.writeCompressedInt (index); });
 }
-void ValueTreeFile::valueTreeChildOrderChanged (juce::ValueTree&, int , int)
+void ValueTreeFile::valueTreeChildOrderChanged (juce::ValueTree& parentTree, int oldIndex, int newIndex)
 {
-    requestAutoSave ();
+    recordChange (parentTree, ChangeType::childMoved, [oldIndex, newIndex] (juce::OutputStream& outputStream)
+    {
+        outputStream.writeCompressedInt (oldIndex);
+        outputStream.writeCompressedInt (newIndex);
+    });
 }
 void ValueTreeFile::valueTreeRedirected (juce::ValueTree& /*treeWhichHasBeenChanged*/)
 {
+    // the whole tree may have changed, which can't be described as a change, so the next save writes a new snapshot
+    if (loading.load ())
+        return;
+    {
+        juce::ScopedLock pendingDataLock (pendingDataCS);
+        snapshotRequired = true;
+        snapshotChangesPending = true;
+    }
     requestAutoSave ();
 }
 void ValueTreeFile::valueTreeParentChanged (juce::ValueTree&) noexcept
@@ -11,6 +11,13 @@
 // save, waiting 'saveDelayTime' before doing the actual save. If second change happens
 // the time is restarted. To keep a long series of rapid changes from keeping the save from
 // happening, a save will be done if the total time since the first change exceeds maxSaveDelayTime.
+//
+// The file is a binary snapshot of the tree (ValueTree::writeToStream), plus a change log next to it (<file name>.log).
+// Each change is recorded as it happens (which property, or which child, of which tree), and an auto-save only appends
+// the new records to the log, so the cost of a save is proportional to what changed. When the log grows larger than the
+// snapshot, the snapshot is rewritten, and the log is restarted. The snapshot and the log carry a generation number, so a
+// log left over from an interrupted compaction is never replayed onto the wrong snapshot. Files in the old XML format are
+// still read, and are replaced by the binary format on the first save.
 
 class ValueTreeFile : private juce::ValueTree::Listener,
                       private juce::Timer,
@@ -29,19 +36,50 @@ public:
     void enableAutoSave (bool isEnabled) noexcept;
 
 private:
+    enum class ChangeType : uint8_t
+    {
+        propertySet,
+        propertyRemoved,
+        childAdded,
+        childRemoved,
+        childMoved
+    };
+    static inline const char kSnapshotMagic [4] { 'V', 'T', 'F', '1' };
+    static inline const char kChangeLogMagic [4] { 'V', 'T', 'L', '1' };
+    static constexpr int64_t kMinCompactionLogSize { 64 * 1024 };
+
     juce::ValueTree vtData;
     juce::File file;
+    juce::File changeLogFile;
     uint32_t saveDelayTime    { 1000 };
     uint32_t maxSaveDelayTime { 5000 };
     uint32_t mostRecentSaveRequestedTime { 0 };
     uint32_t initialSaveRequestedTime    { 0 };
     bool autoSaveEnabled { false };
-    juce::CriticalSection xmlDataCS;
-    std::unique_ptr<juce::XmlElement> xml;
     juce::WaitableEvent signalSave;
     std::atomic<bool> loading { false };
 
-    void save (juce::XmlElement* xmlToWrite);
+    // shared between the message thread and the save thread
+    juce::CriticalSection pendingDataCS;
+    juce::MemoryBlock pendingChanges; // change records not yet appended to the log
+    juce::ValueTree pendingSnapshot; // a copy of the tree, to be written as a new snapshot
+    bool snapshotRequired { true }; // the changes can't be applied to the snapshot on disk (ie. a file in the old format, or the tree was redirected)
+    bool snapshotChangesPending { false }; // there are changes that can only be saved by writing a snapshot, because snapshotRequired was set, or a write failed
+
+    // only used while holding fileCS
+    juce::CriticalSection fileCS;
+    uint32_t generation { 0 };
+    std::unique_ptr<juce::FileOutputStream> changeLogStream;
+    std::atomic<int64_t> snapshotSize { 0 };
+    std::atomic<int64_t> changeLogSize { 0 };
+
+    void recordChange (juce::ValueTree& tree, ChangeType changeType, std::function<void (juce::OutputStream& outputStream)> writeChangeData);
+    bool replayChange (juce::InputStream& changeInputStream);
+    bool loadSnapshot ();
+    void replayChangeLog ();
+    void writeSnapshot (juce::ValueTree snapshot);
+    void appendChanges (const juce::MemoryBlock& changes);
+    void writePendingData ();
     void run () override;
     void valueTreePropertyChanged (juce::ValueTree& treeWhosePropertyHasChanged, const juce::Identifier& property) override;
     void valueTreeChildAdded (juce::ValueTree& parentTree, juce::ValueTree& childWhichHasBeenAdded) override;
@@ -204,18 +204,32 @@ namespace ValueTreeHelpers
         return success;
     }
 
-    uint32_t getCrc (juce::ValueTree tree)
+    // an output stream that only updates a crc, so the tree is hashed as it is serialized, without building a copy of the data
+    class CrcOutputStream : public juce::OutputStream
     {
-        Crc32 crc;
-        juce::MemoryBlock block;
-        juce::MemoryOutputStream stream (block, false);
+    public:
+        uint32_t getCrc () noexcept { return crc.getCrc (); }
 
-        tree.writeToStream (stream);
+        bool write (const void* data, size_t numBytes) override
+        {
+            crc.updateBuffer (static_cast<const uint8_t*> (data), static_cast<int> (numBytes));
+            position += static_cast<juce::int64> (numBytes);
+            return true;
+        }
+        void flush () override {}
+        bool setPosition (juce::int64) override { return false; }
+        juce::int64 getPosition () override { return position; }
 
-        for (size_t i { 0 }; i < stream.getDataSize (); i++)
-            crc.update (((uint8_t*) stream.getData ()) [i]);
+    private:
+        Crc32 crc;
+        juce::int64 position { 0 };
+    };
 
-        return crc.getCrc ();
+    uint32_t getCrc (juce::ValueTree tree)
+    {
+        CrcOutputStream crcStream;
+        tree.writeToStream (crcStream);
+        return crcStream.getCrc ();
     }
 
     void removePropertyIfExists (juce::ValueTree vt, juce::Identifier property)
@@ -2,6 +2,8 @@
 
 #include <JuceHeader.h>
 #include "ValueTreeHelpers.h"
+#include <map>
+#include <set>
 #include <type_traits>
 
 /*
@@ -9,8 +11,83 @@
     and allows clients to use them without doing ValueTree things.
 */
 
+/*
+    ValueTreeTransactions tracks the open transactions (see ValueTreeWrapper::beginTransaction) beside the trees, instead of in a property on them, so
+    opening and committing a transaction does not notify the tree's listeners. a tree is keyed by its property set, which belongs to the shared tree
+    object, so every handle to the same tree finds the same transaction. message thread only
+*/
+class ValueTreeTransactions
+{
+public:
+    class Listener
+    {
+    public:
+        virtual ~Listener () = default;
+        virtual void transactionCommitted () = 0;
+    };
+
+    static bool isOpen (const juce::ValueTree& vt)
+    {
+        return transactions.find (getKey (vt)) != transactions.end ();
+    }
+
+    static void begin (const juce::ValueTree& vt)
+    {
+        jassert (vt.isValid ());
+        ++transactions [getKey (vt)].depth;
+    }
+
+    // only the outermost commit notifies the listeners
+    static void commit (const juce::ValueTree& vt)
+    {
+        const auto transactionIter { transactions.find (getKey (vt)) };
+        jassert (transactionIter != transactions.end ());
+        if (transactionIter == transactions.end () || --transactionIter->second.depth > 0)
+            return;
+        auto listeners { std::move (transactionIter->second.listeners) };
+        transactions.erase (transactionIter);
+        committingListeners = &listeners;
+        for (auto* listener : listeners)
+        {
+            // a listener can be removed by the callback of one before it
+            if (listener != nullptr)
+                listener->transactionCommitted ();
+        }
+        committingListeners = nullptr;
+    }
+
+    // the listener is notified once, when the open transaction on vt is committed
+    static void addListener (const juce::ValueTree& vt, Listener* listener)
+    {
+        jassert (isOpen (vt));
+        auto& listeners { transactions [getKey (vt)].listeners };
+        if (std::find (listeners.begin (), listeners.end (), listener) == listeners.end ())
+            listeners.push_back (listener);
+    }
+
+    static void removeListener (Listener* listener)
+    {
+        for (auto& [key, transaction] : transactions)
+            transaction.listeners.erase (std::remove (transaction.listeners.begin (), transaction.listeners.end (), listener), transaction.listeners.end ());
+        if (committingListeners != nullptr)
+            std::replace (committingListeners->begin (), committingListeners->end (), listener, static_cast<Listener*> (nullptr));
+    }
+
+private:
+    struct Transaction
+    {
+        int depth { 0 };
+        std::vector<Listener*> listeners;
+    };
+    static inline std::map<const void*, Transaction> transactions;
+    static inline std::vector<Listener*>* committingListeners { nullptr };
+
+    static const void* getKey (const juce::ValueTree& vt) { return &vt.getProperties (); }
+};
+
 template <class derived>
-class ValueTreeWrapper : public juce::ValueTree::Listener
+class ValueTreeWrapper : public juce::ValueTree::Listener,
+                         private ValueTreeTransactions::Listener
 {
 public:
     enum class WrapperType { owner, client };
@@ -19,6 +96,7 @@ public:
     ValueTreeWrapper<derived> (juce::Identifier type, juce::ValueTree vt, WrapperType wrapperType, EnableCallbacks shouldEnableCallbacks) noexcept;
     ValueTreeWrapper<derived> (ValueTreeWrapper&&) = default;
     ValueTreeWrapper<derived>& operator = (ValueTreeWrapper&&) = default;
+    ~ValueTreeWrapper () { ValueTreeTransactions::removeListener (this); }
 
     /*
         wrap will do one of four things:
@@ -84,6 +162,43 @@ public:
         bool previousFilterNonChange { false };
     };
 
+    /*
+        Transactions coalesce property change notifications. Between beginTransaction and commitTransaction, the property changes of the wrapped
+        tree (and its children) are collected by each listening wrapper that calls deferPropertyChange, instead of being delivered. On the final
+        commit, each changed property is delivered once, with its current value, in the order of the first change, or, if onTransactionCommit is set,
+        the whole change set is passed to it instead. Child adds, removes and moves are not deferred, they are delivered as they happen. Transactions
+        can be nested, only the outermost commit delivers the changes
+    */
+    using ChangeSet = std::vector<std::pair<juce::ValueTree, juce::Identifier>>;
+    std::function<void (const ChangeSet& changeSet)> onTransactionCommit;
+
+    void beginTransaction ()
+    {
+        ValueTreeTransactions::begin (data);
+    }
+
+    void commitTransaction ()
+    {
+        ValueTreeTransactions::commit (data);
+    }
+
+    class ScopedTransaction
+    {
+    public:
+        ScopedTransaction (ValueTreeWrapper& theVtWrapper)
+            : vtWrapper { theVtWrapper }
+        {
+            vtWrapper.beginTransaction ();
+        }
+
+        ~ScopedTransaction ()
+        {
+            vtWrapper.commitTransaction ();
+        }
+    private:
+        ValueTreeWrapper& vtWrapper;
+    };
+
 protected:
     juce::ValueTree data;
 
@@ -189,10 +304,44 @@ protected:
             addPropertyCallback ();
     };
 
+    // call first in valueTreePropertyChanged, and return if it returns true. the change is then delivered when the transaction is committed
+    bool deferPropertyChange (juce::ValueTree& vt, const juce::Identifier& property)
+    {
+        if (! ValueTreeTransactions::isOpen (data))
+            return false;
+        if (deferredChanges.empty ())
+            ValueTreeTransactions::addListener (data, this);
+
+        // only the first change to each property is kept, the current value is read when it is delivered. the tree is keyed by its property set,
+        // which belongs to the shared tree object, and the identifier by its pooled string, so the key is the same for every handle to the same property
+        if (deferredChangeKeys.emplace (&vt.getProperties (), property.getCharPointer ().getAddress ()).second)
+            deferredChanges.emplace_back (vt, property);
+        return true;
+    }
+
 private:
     juce::Identifier type;
     bool filterNonChange { true };
     bool dataWasRestored { false };
+    ChangeSet deferredChanges;
+    std::set<std::pair<const void*, const void*>> deferredChangeKeys;
+
+    void transactionCommitted () override
+    {
+        ChangeSet changeSet;
+        changeSet.swap (deferredChanges);
+        deferredChangeKeys.clear ();
+        // children removed during the transaction are skipped
+        changeSet.erase (std::remove_if (changeSet.begin (), changeSet.end (), [this] (const auto& change) { return change.first != data && ! change.first.isAChildOf (data); }), changeSet.end ());
+        if (onTransactionCommit != nullptr)
+        {
+            onTransactionCommit (changeSet);
+            return;
+        }
+        auto& listener { static_cast<juce::ValueTree::Listener&> (*this) };
+        for (auto& [vt, property] : changeSet)
+            listener.valueTreePropertyChanged (vt, property);
+    }
 
     void init (juce::ValueTree vt, bool createIfNotFound);
     void createValueTree ();